@@ -0,0 +1,127 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of aligned_allocator class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class of allocators to allocate memory with a minimum alignment.
+ *
+ * This allocator aligns memory to the larger one of the alignment specified
+ * in the constructor and the alignment specified in allocate() function.
+ */
+class aligned_allocator {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] min_alignment Minimum alignment. This must be a power of two.
+     */
+    explicit aligned_allocator(
+        std::size_t min_alignment = alignof(std::max_align_t))
+        : min_alignment_(min_alignment) {
+        if (!is_power_of_two(min_alignment)) {
+            throw std::invalid_argument("Alignment must be a power of two.");
+        }
+    }
+
+    /*!
+     * \brief Allocate memory.
+     *
+     * \param[in] size Number of bytes to allocate.
+     * \param[in] alignment Alignment. This must be zero or a power of two.
+     * \return Pointer to the allocated memory.
+     */
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment) {
+        if (alignment < min_alignment_) {
+            alignment = min_alignment_;
+        }
+        if (!is_power_of_two(alignment)) {
+            throw std::invalid_argument("Alignment must be a power of two.");
+        }
+        // Space to save the pointer to the original memory.
+        constexpr std::size_t header_size = sizeof(void*);
+        if (size > static_cast<std::size_t>(-1) - header_size - alignment) {
+            throw std::bad_alloc();
+        }
+        void* original = std::malloc(size + header_size + alignment);
+        if (original == nullptr) {
+            throw std::bad_alloc();
+        }
+        const auto original_address = reinterpret_cast<std::uintptr_t>(
+            original);  // NOLINT
+        const std::uintptr_t aligned_address =
+            (original_address + header_size + alignment - 1U) &
+            ~static_cast<std::uintptr_t>(alignment - 1U);
+        void* aligned = reinterpret_cast<void*>(aligned_address);  // NOLINT
+        std::memcpy(static_cast<unsigned char*>(aligned) - header_size,
+            &original, sizeof(original));
+        return aligned;
+    }
+
+    /*!
+     * \brief Deallocate memory.
+     *
+     * \param[in] ptr Pointer to the deallocated memory.
+     */
+    void deallocate(void* ptr) noexcept {  // NOLINT
+        if (ptr == nullptr) {
+            return;
+        }
+        void* original = nullptr;
+        std::memcpy(&original,
+            static_cast<unsigned char*>(ptr) - sizeof(void*),
+            sizeof(original));
+        std::free(original);
+    }
+
+    /*!
+     * \brief Get the minimum alignment.
+     *
+     * \return Minimum alignment.
+     */
+    [[nodiscard]] std::size_t min_alignment() const noexcept {
+        return min_alignment_;
+    }
+
+private:
+    /*!
+     * \brief Check whether a number is a power of two.
+     *
+     * \param[in] value Number.
+     * \retval true The number is a power of two.
+     * \retval false Otherwise.
+     */
+    [[nodiscard]] static bool is_power_of_two(std::size_t value) noexcept {
+        return value != 0U && (value & (value - 1U)) == 0U;
+    }
+
+    //! Minimum alignment.
+    std::size_t min_alignment_;
+};
+
+}  // namespace msgpack_light
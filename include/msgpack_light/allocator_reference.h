@@ -0,0 +1,79 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of allocator_reference class.
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class of allocators referring to another allocator.
+ *
+ * This class can be used to share an allocator (for example,
+ * msgpack_light::monotonic_allocator used as an arena of a request)
+ * among multiple objects, binaries, and streams.
+ *
+ * \warning The referred allocator must be alive while memory allocated using
+ * this class is used.
+ *
+ * \tparam Allocator Type of the referred allocator.
+ */
+template <typename Allocator>
+class allocator_reference {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] allocator Referred allocator.
+     */
+    explicit allocator_reference(Allocator& allocator) noexcept
+        : allocator_(&allocator) {}
+
+    /*!
+     * \brief Allocate memory.
+     *
+     * \param[in] size Number of bytes to allocate.
+     * \param[in] alignment Alignment.
+     * \return Pointer to the allocated memory.
+     */
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment) {
+        return allocator_->allocate(size, alignment);
+    }
+
+    /*!
+     * \brief Deallocate memory.
+     *
+     * \param[in] ptr Pointer to the deallocated memory.
+     */
+    void deallocate(void* ptr) noexcept { allocator_->deallocate(ptr); }
+
+    /*!
+     * \brief Get the referred allocator.
+     *
+     * \return Referred allocator.
+     */
+    [[nodiscard]] Allocator& get() const noexcept { return *allocator_; }
+
+private:
+    //! Referred allocator.
+    Allocator* allocator_;
+};
+
+}  // namespace msgpack_light
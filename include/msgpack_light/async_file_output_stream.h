@@ -0,0 +1,304 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of async_file_output_stream class.
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Default size of buffers in async_file_output_stream class.
+ */
+constexpr std::size_t default_async_file_buffer_size =
+    static_cast<std::size_t>(1024U) * 1024U;
+
+/*!
+ * \brief Default number of buffers in async_file_output_stream class.
+ */
+constexpr std::size_t default_async_file_num_buffers = 2U;
+
+/*!
+ * \brief Class of streams to write data to files in a background thread.
+ *
+ * Data is copied to a buffer, and buffers filled with data are written to the
+ * file in a background thread, so write() function only copies data unless
+ * all buffers are waiting to be written. When the disk is slower than the
+ * writing thread, write() function waits for a buffer to become available.
+ *
+ * \note Errors in the background thread are reported by write() and flush()
+ * functions called after the errors.
+ */
+class async_file_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_path File path.
+     * \param[in] buffer_size Size of each buffer.
+     * \param[in] num_buffers Number of buffers.
+     */
+    explicit async_file_output_stream(const char* file_path,
+        std::size_t buffer_size = default_async_file_buffer_size,
+        std::size_t num_buffers = default_async_file_num_buffers)
+        : buffer_size_(buffer_size) {
+        if (buffer_size == 0U || num_buffers == 0U) {
+            throw std::invalid_argument("Invalid sizes of buffers.");
+        }
+        buffers_.resize(num_buffers, std::vector<unsigned char>(buffer_size));
+        for (std::size_t i = 1; i < num_buffers; ++i) {
+            free_buffers_.push_back(i);
+        }
+
+        file_ = std::fopen(file_path, "wb");
+        if (file_ == nullptr) {
+            throw std::runtime_error(
+                std::string("Failed to open ") + file_path);
+        }
+        try {
+            thread_ = std::thread([this] { write_in_background(); });
+        } catch (...) {
+            (void)std::fclose(file_);
+            throw;
+        }
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_path File path.
+     * \param[in] buffer_size Size of each buffer.
+     * \param[in] num_buffers Number of buffers.
+     */
+    explicit async_file_output_stream(const std::string& file_path,
+        std::size_t buffer_size = default_async_file_buffer_size,
+        std::size_t num_buffers = default_async_file_num_buffers)
+        : async_file_output_stream(
+              file_path.c_str(), buffer_size, num_buffers) {}
+
+    async_file_output_stream(const async_file_output_stream&) = delete;
+    async_file_output_stream(async_file_output_stream&&) = delete;
+    async_file_output_stream& operator=(
+        const async_file_output_stream&) = delete;
+    async_file_output_stream& operator=(async_file_output_stream&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * This writes the remaining data and closes the file.
+     */
+    ~async_file_output_stream() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (current_size_ > 0U) {
+                pending_buffers_.emplace_back(current_buffer_, current_size_);
+            }
+            stopping_ = true;
+        }
+        condition_.notify_all();
+        thread_.join();
+        (void)std::fclose(file_);
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        while (size > 0U) {
+            const std::size_t copied_size =
+                std::min(size, buffer_size_ - current_size_);
+            std::memcpy(buffers_[current_buffer_].data() + current_size_,
+                data, copied_size);
+            current_size_ += copied_size;
+            data += copied_size;
+            size -= copied_size;
+            if (current_size_ == buffer_size_) {
+                submit_current_buffer();
+            }
+        }
+    }
+
+    /*!
+     * \brief Write all the data to the file and wait for the data to be
+     * stored in the storage device.
+     */
+    void flush() {
+        if (current_size_ > 0U) {
+            submit_current_buffer();
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return pending_buffers_.empty(); });
+            check_error();
+        }
+        // The background thread doesn't touch the file here because no
+        // buffer is pending.
+        if (std::fflush(file_) != 0 || !sync_file()) {
+            throw std::runtime_error("Failed to flush data to a file.");
+        }
+    }
+
+    /*!
+     * \brief Get the size of each buffer.
+     *
+     * \return Size of each buffer.
+     */
+    [[nodiscard]] std::size_t buffer_size() const noexcept {
+        return buffer_size_;
+    }
+
+    /*!
+     * \brief Get the number of buffers.
+     *
+     * \return Number of buffers.
+     */
+    [[nodiscard]] std::size_t num_buffers() const noexcept {
+        return buffers_.size();
+    }
+
+private:
+    /*!
+     * \brief Pass the current buffer to the background thread and get the next
+     * buffer.
+     */
+    void submit_current_buffer() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        check_error();
+        pending_buffers_.emplace_back(current_buffer_, current_size_);
+        condition_.notify_all();
+        condition_.wait(
+            lock, [this] { return !free_buffers_.empty() || error_; });
+        check_error();
+        current_buffer_ = free_buffers_.back();
+        free_buffers_.pop_back();
+        current_size_ = 0U;
+    }
+
+    /*!
+     * \brief Throw an exception if an error occurred in the background
+     * thread.
+     *
+     * \note This function must be called with the lock of mutex_.
+     */
+    void check_error() const {
+        if (error_) {
+            throw std::runtime_error("Failed to write data to a file.");
+        }
+    }
+
+    /*!
+     * \brief Write buffers in the background thread.
+     */
+    void write_in_background() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            condition_.wait(lock,
+                [this] { return stopping_ || !pending_buffers_.empty(); });
+            if (pending_buffers_.empty()) {
+                return;
+            }
+            const auto [buffer, size] = pending_buffers_.front();
+            const bool skip = error_;
+            lock.unlock();
+            const bool succeeded = skip ||
+                std::fwrite(buffers_[buffer].data(), 1U, size, file_) == size;
+            lock.lock();
+            if (!succeeded) {
+                error_ = true;
+            }
+            pending_buffers_.pop_front();
+            free_buffers_.push_back(buffer);
+            condition_.notify_all();
+        }
+    }
+
+    /*!
+     * \brief Synchronize the file with the storage device.
+     *
+     * \retval true Succeeded.
+     * \retval false Failed.
+     */
+    [[nodiscard]] bool sync_file() const noexcept {
+#if defined(_WIN32)
+        return _commit(_fileno(file_)) == 0;
+#else
+        return ::fsync(::fileno(file_)) == 0;
+#endif
+    }
+
+    //! File.
+    std::FILE* file_{nullptr};
+
+    //! Size of each buffer.
+    std::size_t buffer_size_;
+
+    //! Buffers.
+    std::vector<std::vector<unsigned char>> buffers_{};
+
+    //! Index of the buffer being filled in the writing thread.
+    std::size_t current_buffer_{0U};
+
+    //! Size of the data in the current buffer.
+    std::size_t current_size_{0U};
+
+    //! Mutex of the following variables.
+    std::mutex mutex_{};
+
+    //! Condition variable to notify changes of the following variables.
+    std::condition_variable condition_{};
+
+    //! Buffers waiting to be written (pairs of indices and sizes).
+    std::deque<std::pair<std::size_t, std::size_t>> pending_buffers_{};
+
+    //! Indices of free buffers.
+    std::vector<std::size_t> free_buffers_{};
+
+    //! Whether the background thread should stop.
+    bool stopping_{false};
+
+    //! Whether an error occurred in the background thread.
+    bool error_{false};
+
+    //! Background thread.
+    std::thread thread_{};
+};
+
+}  // namespace msgpack_light
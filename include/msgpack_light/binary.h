@@ -20,15 +20,18 @@
 #pragma once
 
 #include <cstddef>  // IWYU pragma: keep
+#include <cstdint>
 #include <cstring>
 #include <initializer_list>
 #include <limits>
 #include <ostream>
 #include <stdexcept>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "msgpack_light/details/basic_binary_buffer.h"
+#include "msgpack_light/standard_allocator.h"
 
 namespace msgpack_light {
 
@@ -61,14 +64,15 @@ namespace details {
     }
 }
 
-/*!
- * \brief Default of the capacity of the buffer in msgpack_light::binary class.
- */
-constexpr std::size_t default_binary_capacity = 8U;
-
 }  // namespace details
 
-class binary;
+template <typename Allocator = standard_allocator>
+class basic_binary;
+
+/*!
+ * \brief Class of binary data using msgpack_light::standard_allocator.
+ */
+using binary = basic_binary<standard_allocator>;
 
 /*!
  * \brief Class to refer binary data.
@@ -96,10 +100,12 @@ public:
     /*!
      * \brief Constructor.
      *
+     * \tparam Allocator Type of the allocator.
      * \param[in] data Data.
      */
+    template <typename Allocator>
     binary_view(  // NOLINT(google-explicit-constructor,hicpp-explicit-conversions)
-        const binary& data) noexcept;
+        const basic_binary<Allocator>& data) noexcept;
 
     /*!
      * \brief Get the pointer to the data.
@@ -125,15 +131,32 @@ private:
 
 /*!
  * \brief Class of binary data.
+ *
+ * \tparam Allocator Type of the allocator. (Same as allocators in
+ * msgpack_light::object class.)
  */
-class binary {
+template <typename Allocator>
+class basic_binary {
 public:
+    //! Type of the allocator.
+    using allocator_type = Allocator;
+
     /*!
      * \brief Constructor.
      *
      * Create empty data.
      */
-    binary() : buffer_(details::default_binary_capacity), size_(0U) {}
+    basic_binary() : basic_binary(Allocator()) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * Create empty data.
+     *
+     * \param[in] allocator Allocator.
+     */
+    explicit basic_binary(Allocator allocator)
+        : buffer_(0U, std::move(allocator)) {}
 
     /*!
      * \brief Constructor.
@@ -141,16 +164,21 @@ public:
      * Create a buffer with uninitialized data.
      *
      * \param[in] size Size of the buffer.
+     * \param[in] allocator Allocator.
      */
-    explicit binary(std::size_t size) : buffer_(size), size_(size) {}
+    explicit basic_binary(std::size_t size, Allocator allocator = Allocator())
+        : buffer_(size, std::move(allocator)) {}
 
     /*!
      * \brief Constructor.
      *
      * \param[in] data Pointer to the data.
      * \param[in] size Size of the data.
+     * \param[in] allocator Allocator.
      */
-    binary(const unsigned char* data, std::size_t size) : binary(size) {
+    basic_binary(const unsigned char* data, std::size_t size,
+        Allocator allocator = Allocator())
+        : basic_binary(size, std::move(allocator)) {
         if (size == 0U) {
             return;
         }
@@ -161,24 +189,28 @@ public:
      * \brief Constructor.
      *
      * \param[in] data Data.
+     * \param[in] allocator Allocator.
      */
-    explicit binary(binary_view data) : binary(data.data(), data.size()) {}
+    explicit basic_binary(binary_view data, Allocator allocator = Allocator())
+        : basic_binary(data.data(), data.size(), std::move(allocator)) {}
 
     /*!
      * \brief Constructor.
      *
      * \param[in] data Data.
+     * \param[in] allocator Allocator.
      */
-    explicit binary(const std::vector<unsigned char>& data)
-        : binary(data.data(), data.size()) {}
+    explicit basic_binary(const std::vector<unsigned char>& data,
+        Allocator allocator = Allocator())
+        : basic_binary(data.data(), data.size(), std::move(allocator)) {}
 
     /*!
      * \brief Constructor.
      *
      * \param[in] data Data.
      */
-    binary(std::initializer_list<unsigned char> data)
-        : binary(data.begin(), data.size()) {}
+    basic_binary(std::initializer_list<unsigned char> data)
+        : basic_binary(data.begin(), data.size()) {}
 
     /*!
      * \brief Constructor.
@@ -191,9 +223,11 @@ public:
      * from `a` to `f`.
      *
      * \param[in] data_string Hex expression of data.
+     * \param[in] allocator Allocator.
      */
-    explicit binary(std::string_view data_string)
-        : binary(data_string.size() / 2U) {
+    explicit basic_binary(
+        std::string_view data_string, Allocator allocator = Allocator())
+        : basic_binary(data_string.size() / 2U, std::move(allocator)) {
         constexpr std::string_view hex_digits = "0123456789ABCDEF";
         unsigned int byte = 0U;
         bool is_first_digit = true;
@@ -220,6 +254,53 @@ public:
         }
     }
 
+    /*!
+     * \brief Copy constructor.
+     */
+    basic_binary(const basic_binary&) = default;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * The moved instance will be empty.
+     *
+     * \param[in,out] other Instance to move from.
+     */
+    basic_binary(basic_binary&& other) noexcept
+        : buffer_(std::move(other.buffer_)) {}
+
+    /*!
+     * \brief Copy assignment operator.
+     *
+     * \return This.
+     */
+    basic_binary& operator=(const basic_binary&) = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in,out] other Instance to move from.
+     * \return This.
+     */
+    basic_binary& operator=(basic_binary&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    /*!
+     * \brief Destructor.
+     */
+    ~basic_binary() = default;
+
+    /*!
+     * \brief Swap with another instance.
+     *
+     * \param[in,out] other Instance to swap with.
+     */
+    void swap(basic_binary& other) noexcept {
+        buffer_.swap(other.buffer_);
+    }
+
     /*!
      * \brief Change the size of this data.
      *
@@ -228,12 +309,7 @@ public:
      *
      * \param[in] size New size.
      */
-    void resize(std::size_t size) {
-        if (size > buffer_.size()) {
-            buffer_.resize(size);
-        }
-        size_ = size;
-    }
+    void resize(std::size_t size) { buffer_.resize(size); }
 
     /*!
      * \brief Change the size of the internal buffer.
@@ -242,11 +318,7 @@ public:
      *
      * \param[in] size New size.
      */
-    void reserve(std::size_t size) {
-        if (size > buffer_.size()) {
-            buffer_.resize(size);
-        }
-    }
+    void reserve(std::size_t size) { buffer_.reserve(size); }
 
     /*!
      * \brief Append another binary data.
@@ -255,14 +327,15 @@ public:
      * \param[in] size Size of the appended data.
      */
     void append(const unsigned char* data, std::size_t size) {
-        const std::size_t current_size = size_;
-        const std::size_t remaining_capacity = buffer_.size() - size_;
+        const std::size_t current_size = buffer_.size();
+        const std::size_t current_capacity = buffer_.capacity();
+        const std::size_t remaining_capacity = current_capacity - current_size;
         if (remaining_capacity < size) {
             reserve(details::calculate_expanded_memory_buffer_size(
-                buffer_.size(), size - remaining_capacity));
+                current_capacity, size - remaining_capacity));
         }
+        buffer_.resize(current_size + size);
         std::memcpy(buffer_.data() + current_size, data, size);
-        size_ += size;
     }
 
     /*!
@@ -271,7 +344,7 @@ public:
      * \param[in] other Another binary data to append.
      * \return This.
      */
-    binary& operator+=(const binary& other) {
+    basic_binary& operator+=(binary_view other) {
         append(other.data(), other.size());
         return *this;
     }
@@ -317,7 +390,7 @@ public:
      *
      * \return Size of the data.
      */
-    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t size() const noexcept { return buffer_.size(); }
 
     /*!
      * \brief Get the size of the internal buffer for data.
@@ -325,7 +398,7 @@ public:
      * \return Size of the internal buffer.
      */
     [[nodiscard]] std::size_t capacity() const noexcept {
-        return buffer_.size();
+        return buffer_.capacity();
     }
 
     /*!
@@ -335,9 +408,9 @@ public:
      * \retval true Two instances are equal.
      * \retval false Two instances are not equal.
      */
-    [[nodiscard]] bool operator==(const binary& other) const noexcept {
-        return size_ == other.size_ &&
-            std::memcmp(buffer_.data(), other.buffer_.data(), size_) == 0;
+    [[nodiscard]] bool operator==(const basic_binary& other) const noexcept {
+        return size() == other.size() &&
+            std::memcmp(buffer_.data(), other.buffer_.data(), size()) == 0;
     }
 
     /*!
@@ -347,30 +420,56 @@ public:
      * \retval true Two instances are not equal.
      * \retval false Two instances are equal.
      */
-    [[nodiscard]] bool operator!=(const binary& other) const noexcept {
+    [[nodiscard]] bool operator!=(const basic_binary& other) const noexcept {
         return !operator==(other);
     }
 
+    /*!
+     * \brief Get the allocator.
+     *
+     * \return Allocator.
+     */
+    [[nodiscard]] const Allocator& get_allocator() const noexcept {
+        return buffer_.get_allocator();
+    }
+
 private:
     //! Buffer.
-    details::basic_binary_buffer buffer_;
-
-    //! Size.
-    std::size_t size_;
+    details::basic_binary_buffer<Allocator> buffer_;
 };
 
-inline binary_view::binary_view(const binary& data) noexcept
+static_assert(sizeof(basic_binary<standard_allocator>) ==
+    sizeof(void*) + sizeof(std::size_t) + sizeof(std::uint64_t));
+
+template <typename Allocator>
+inline binary_view::binary_view(const basic_binary<Allocator>& data) noexcept
     : data_(data.data()), size_(data.size()) {}
 
+/*!
+ * \brief Swap two binary data.
+ *
+ * \tparam Allocator Type of the allocator.
+ * \param[in,out] lhs An instance.
+ * \param[in,out] rhs Another instance.
+ */
+template <typename Allocator>
+inline void swap(
+    basic_binary<Allocator>& lhs, basic_binary<Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
 /*!
  * \brief Connect two binary data.
  *
+ * \tparam Allocator Type of the allocator.
  * \param[in] lhs Light-hand-side data.
  * \param[in] rhs Right-hand-side data.
  * \return Connected data.
  */
-[[nodiscard]] inline binary operator+(const binary& lhs, const binary& rhs) {
-    return binary(lhs) += rhs;
+template <typename Allocator>
+[[nodiscard]] inline basic_binary<Allocator> operator+(
+    const basic_binary<Allocator>& lhs, const basic_binary<Allocator>& rhs) {
+    return basic_binary<Allocator>(lhs) += rhs;
 }
 
 /*!
@@ -382,8 +481,10 @@ inline binary_view::binary_view(const binary& data) noexcept
  * \retval false Two instances are not equal.
  */
 [[nodiscard]] inline bool operator==(binary_view lhs, binary_view rhs) {
+    // Empty data may have null pointers, which cannot be passed to memcmp.
     return lhs.size() == rhs.size() &&
-        std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+        (lhs.size() == 0U ||
+            std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
 }
 
 /*!
@@ -401,11 +502,14 @@ inline binary_view::binary_view(const binary& data) noexcept
 /*!
  * \brief Format a value to a stream.
  *
+ * \tparam Allocator Type of the allocator.
  * \param[in] stream Output stream.
  * \param[in] value Value.
  * \return Output stream.
  */
-inline std::ostream& operator<<(std::ostream& stream, const binary& value) {
+template <typename Allocator>
+inline std::ostream& operator<<(
+    std::ostream& stream, const basic_binary<Allocator>& value) {
     constexpr std::string_view hex_digits = "0123456789ABCDEF";
     for (std::size_t i = 0; i < value.size(); ++i) {
         const unsigned int byte = value.data()[i];
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of cached_serialization class.
+ */
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/raw_msgpack.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class to hold a value with its serialized data.
+ *
+ * The value is serialized when it is set, and serialization of instances of
+ * this class only writes the serialized data.
+ * When instances of this class are nested, only the changed instances are
+ * serialized again.
+ *
+ * Each value has a version, and the value is serialized again only when the
+ * version changes.
+ *
+ * The serialized data depends on the options of serialization
+ * (msgpack_light::serialization_options::canonical and
+ * msgpack_light::serialization_options::compact_floating_point).
+ * Serialization with options different from the options given to this
+ * object serializes the value again without using the serialized data.
+ *
+ * \note Functions of this class which don't change the instance (const member
+ * functions) can be called from multiple threads at the same time.
+ *
+ * \tparam T Type of the value.
+ */
+template <typename T>
+class cached_serialization {
+public:
+    //! Type of the value.
+    using value_type = T;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] value Value.
+     * \param[in] version Version of the value.
+     * \param[in] options Options of serialization.
+     */
+    explicit cached_serialization(T value, std::uint64_t version = 0U,
+        const serialization_options& options = serialization_options())
+        : value_(std::move(value)), version_(version), options_(options) {
+        update_serialized_data();
+    }
+
+    /*!
+     * \brief Set a value.
+     *
+     * \warning When the version is the same as the current version, this
+     * function assumes that the value is not changed and does nothing.
+     *
+     * \param[in] value Value.
+     * \param[in] version Version of the value.
+     */
+    void update(T value, std::uint64_t version) {
+        if (version == version_) {
+            return;
+        }
+        value_ = std::move(value);
+        version_ = version;
+        update_serialized_data();
+    }
+
+    /*!
+     * \brief Modify the value.
+     *
+     * This function increments the version and serializes the modified value.
+     *
+     * \tparam Function Type of the function.
+     * \param[in] function Function to modify the value.
+     * The function is called with the reference to the value (`T&`) as the
+     * argument.
+     */
+    template <typename Function>
+    void modify(Function&& function) {
+        std::forward<Function>(function)(value_);
+        ++version_;
+        update_serialized_data();
+    }
+
+    /*!
+     * \brief Get the value.
+     *
+     * \return Value.
+     */
+    [[nodiscard]] const T& value() const noexcept { return value_; }
+
+    /*!
+     * \brief Get the version of the value.
+     *
+     * \return Version.
+     */
+    [[nodiscard]] std::uint64_t version() const noexcept { return version_; }
+
+    /*!
+     * \brief Get the options of serialization.
+     *
+     * \return Options.
+     */
+    [[nodiscard]] const serialization_options& options() const noexcept {
+        return options_;
+    }
+
+    /*!
+     * \brief Check whether the serialized data can be used in serialization
+     * with the given options.
+     *
+     * \param[in] options Options of serialization.
+     * \retval true The serialized data can be used.
+     * \retval false The value must be serialized again.
+     */
+    [[nodiscard]] bool is_serialized_with(
+        const serialization_options& options) const noexcept {
+        return options.canonical == options_.canonical &&
+            options.compact_floating_point == options_.compact_floating_point;
+    }
+
+    /*!
+     * \brief Get the serialized data.
+     *
+     * \return Serialized data.
+     */
+    [[nodiscard]] const binary& serialized() const noexcept {
+        return serialized_;
+    }
+
+    /*!
+     * \brief Get the serialized data as msgpack_light::raw_msgpack instance.
+     *
+     * \return Serialized data.
+     */
+    [[nodiscard]] raw_msgpack as_raw_msgpack() const noexcept {
+        return raw_msgpack(serialized_.data(), serialized_.size());
+    }
+
+private:
+    /*!
+     * \brief Serialize the current value.
+     *
+     * The serialized data is copied to a buffer of the exact size
+     * so that each instance doesn't keep the reserved memory of the stream.
+     */
+    void update_serialized_data() {
+        memory_output_stream stream;
+        serialize_to(stream, value_, options_);
+        serialized_ = binary(stream.data(), stream.size());
+    }
+
+    //! Value.
+    T value_;
+
+    //! Version.
+    std::uint64_t version_;
+
+    //! Options of serialization.
+    serialization_options options_;
+
+    //! Serialized data.
+    binary serialized_{};
+};
+
+}  // namespace msgpack_light
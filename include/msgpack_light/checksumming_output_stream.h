@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of checksumming_output_stream class.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "msgpack_light/details/crc32c.h"
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class of streams to calculate checksums (CRC32C) of data written to
+ * another stream.
+ *
+ * Data is written to the underlying stream as is, and the checksum is
+ * calculated at the same time.
+ *
+ * To write checksums of frames (a sequence of data), call append_checksum()
+ * function after writing each frame. This writes the checksum of data written
+ * after the previous call (or construction) in 4 bytes (big endian), and
+ * starts the next frame.
+ */
+class checksumming_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] stream Stream to write data to.
+     */
+    explicit checksumming_output_stream(output_stream& stream) noexcept
+        : stream_(stream) {}
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        stream_.write(data, size);
+        crc_ = details::update_crc32c(crc_, data, size);
+    }
+
+    /*!
+     * \brief Get the checksum of data written after the last reset.
+     *
+     * \return Checksum (CRC32C).
+     */
+    [[nodiscard]] std::uint32_t checksum() const noexcept { return ~crc_; }
+
+    /*!
+     * \brief Reset the checksum.
+     */
+    void reset() noexcept { crc_ = initial_crc; }
+
+    /*!
+     * \brief Write the checksum to the stream and reset the checksum.
+     */
+    void append_checksum() {
+        constexpr std::size_t num_bytes = 4U;
+        constexpr unsigned int bits_per_byte = 8U;
+        const std::uint32_t value = checksum();
+        std::array<unsigned char, num_bytes> bytes{};
+        for (std::size_t i = 0; i < num_bytes; ++i) {
+            bytes[i] = static_cast<unsigned char>(
+                value >> (bits_per_byte * (num_bytes - 1U - i)));
+        }
+        stream_.write(bytes.data(), bytes.size());
+        reset();
+    }
+
+private:
+    //! Initial value of CRC.
+    static constexpr std::uint32_t initial_crc = 0xFFFFFFFFU;
+
+    //! Stream to write data to.
+    output_stream& stream_;
+
+    //! Current CRC (without the final inversion).
+    std::uint32_t crc_{initial_crc};
+};
+
+}  // namespace msgpack_light
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of chunked_memory_output_stream class.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class of streams to write data to memory in a list of fixed-size
+ * segments.
+ *
+ * Different from msgpack_light::memory_output_stream, this class never copies
+ * written data to expand the buffer.
+ * Written data can be referred to segment by segment (for example, to write
+ * data using `writev`), or copied to msgpack_light::binary when needed.
+ */
+class chunked_memory_output_stream final : public output_stream {
+public:
+    //! Default size of segments.
+    static constexpr std::size_t default_segment_size =
+        static_cast<std::size_t>(64U) * 1024U;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] segment_size Size of segments.
+     */
+    explicit chunked_memory_output_stream(
+        std::size_t segment_size = default_segment_size)
+        : segment_size_(segment_size) {
+        if (segment_size == 0U) {
+            throw std::invalid_argument("Invalid size of segments.");
+        }
+    }
+
+    chunked_memory_output_stream(const chunked_memory_output_stream&) = delete;
+    chunked_memory_output_stream(chunked_memory_output_stream&&) = delete;
+    chunked_memory_output_stream& operator=(
+        const chunked_memory_output_stream&) = delete;
+    chunked_memory_output_stream& operator=(
+        chunked_memory_output_stream&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     */
+    ~chunked_memory_output_stream() {
+        // Release segments in a loop to avoid deep recursion.
+        std::unique_ptr<segment> current = std::move(first_);
+        while (current) {
+            current = std::move(current->next);
+        }
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        while (size > 0U) {
+            if (last_ == nullptr || last_->size == segment_size_) {
+                next_segment();
+            }
+            const std::size_t written_size =
+                std::min(size, segment_size_ - last_->size);
+            std::memcpy(last_->data.get() + last_->size, data, written_size);
+            last_->size += written_size;
+            size_ += written_size;
+            data += written_size;  // NOLINT
+            size -= written_size;
+        }
+    }
+
+    /*!
+     * \brief Clear data.
+     *
+     * Allocated segments are reused in the following writes.
+     */
+    void clear() noexcept {
+        for (segment* current = first_.get(); current != nullptr;
+             current = current->next.get()) {
+            current->size = 0U;
+        }
+        last_ = nullptr;
+        size_ = 0U;
+    }
+
+    /*!
+     * \brief Get the size of the written data.
+     *
+     * \return Size of the written data.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /*!
+     * \brief Get the size of segments.
+     *
+     * \return Size of segments.
+     */
+    [[nodiscard]] std::size_t segment_size() const noexcept {
+        return segment_size_;
+    }
+
+    /*!
+     * \brief Get the number of segments with written data.
+     *
+     * \return Number of segments.
+     */
+    [[nodiscard]] std::size_t num_segments() const noexcept {
+        std::size_t count = 0U;
+        for_each_segment([&count](binary_view /*segment*/) { ++count; });
+        return count;
+    }
+
+    /*!
+     * \brief Call a function for each segment with written data in order.
+     *
+     * \tparam Function Type of the function.
+     * \param[in] function Function called with binary_view of each segment.
+     */
+    template <typename Function>
+    void for_each_segment(Function&& function) const {
+        if (last_ == nullptr) {
+            return;
+        }
+        for (const segment* current = first_.get(); current != nullptr;
+             current = current->next.get()) {
+            function(binary_view(current->data.get(), current->size));
+            if (current == last_) {
+                return;
+            }
+        }
+    }
+
+    /*!
+     * \brief Get the segments with written data.
+     *
+     * The result can be converted to `iovec` to write data using `writev`.
+     *
+     * \return Views of the segments in order.
+     */
+    [[nodiscard]] std::vector<binary_view> segments() const {
+        std::vector<binary_view> result;
+        for_each_segment(
+            [&result](binary_view segment) { result.push_back(segment); });
+        return result;
+    }
+
+    /*!
+     * \brief Write the written data to another stream.
+     *
+     * \param[out] stream Stream.
+     */
+    void write_to(output_stream& stream) const {
+        for_each_segment([&stream](binary_view segment) {
+            stream.write(segment.data(), segment.size());
+        });
+    }
+
+    /*!
+     * \brief Copy the written data to msgpack_light::binary.
+     *
+     * \return Written data.
+     */
+    [[nodiscard]] binary to_binary() const {
+        binary result(size_);
+        std::size_t position = 0U;
+        for_each_segment([&result, &position](binary_view segment) {
+            std::memcpy(
+                result.data() + position, segment.data(), segment.size());
+            position += segment.size();
+        });
+        return result;
+    }
+
+private:
+    /*!
+     * \brief Struct of segments.
+     */
+    struct segment {
+        //! Buffer.
+        std::unique_ptr<unsigned char[]> data;  // NOLINT
+
+        //! Size of written data.
+        std::size_t size;
+
+        //! Next segment.
+        std::unique_ptr<segment> next;
+    };
+
+    /*!
+     * \brief Move to the next segment, allocating it if needed.
+     */
+    void next_segment() {
+        std::unique_ptr<segment>& next =
+            (last_ == nullptr) ? first_ : last_->next;
+        if (!next) {
+            // Segments are linked only after all allocations succeed.
+            auto created = std::make_unique<segment>();
+            // Buffers are left uninitialized.
+            created->data = std::unique_ptr<unsigned char[]>(  // NOLINT
+                new unsigned char[segment_size_]);             // NOLINT
+            created->size = 0U;
+            next = std::move(created);
+        }
+        last_ = next.get();
+    }
+
+    //! Size of segments.
+    std::size_t segment_size_;
+
+    //! First segment.
+    std::unique_ptr<segment> first_{};
+
+    //! Last segment with written data.
+    segment* last_{nullptr};
+
+    //! Size of the written data.
+    std::size_t size_{0U};
+};
+
+}  // namespace msgpack_light
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of compressing_output_stream class.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "msgpack_light/details/lz_codec.h"
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Default size of blocks in compressing_output_stream class.
+ */
+constexpr std::size_t default_compression_block_size =
+    static_cast<std::size_t>(64U) * 1024U;
+
+/*!
+ * \brief Maximum size of blocks in compressing_output_stream class.
+ */
+constexpr std::size_t max_compression_block_size =
+    static_cast<std::size_t>(1U) << 30U;
+
+/*!
+ * \brief Size of headers of frames written by compressing_output_stream class.
+ */
+constexpr std::size_t compression_frame_header_size = 8U;
+
+/*!
+ * \brief Class of streams to compress data and write to another stream.
+ *
+ * Data is split into blocks of a fixed size, and each block is compressed
+ * independently using a LZ77-based codec (block format of LZ4) and written as
+ * a frame with the following format:
+ *
+ * 1. Size of the data in the block (4 bytes, big endian).
+ * 2. Size of the stored data (4 bytes, big endian).
+ * 3. Stored data. When the sizes are equal, the data is stored without
+ *    compression because it cannot be compressed.
+ *
+ * Because frames don't depend on each other, they can be decompressed in
+ * parallel. Use decompressing_reader class to decompress the data.
+ *
+ * \note Call flush() function to write data of the last block before using the
+ * written data.
+ */
+class compressing_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] stream Stream to write compressed data to.
+     * \param[in] block_size Size of blocks.
+     */
+    explicit compressing_output_stream(output_stream& stream,
+        std::size_t block_size = default_compression_block_size)
+        : stream_(stream), block_size_(block_size) {
+        if (block_size == 0U || block_size > max_compression_block_size) {
+            throw std::invalid_argument("Invalid size of blocks.");
+        }
+        block_.reserve(block_size);
+        compressed_.resize(compression_frame_header_size +
+            details::lz_max_compressed_size(block_size));
+    }
+
+    compressing_output_stream(const compressing_output_stream&) = delete;
+    compressing_output_stream(compressing_output_stream&&) = delete;
+    compressing_output_stream& operator=(
+        const compressing_output_stream&) = delete;
+    compressing_output_stream& operator=(compressing_output_stream&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This will call flush() function, and errors in it are ignored.
+     */
+    ~compressing_output_stream() noexcept {
+        try {
+            flush();
+        } catch (...) {
+            // Errors cannot be reported here.
+        }
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        while (size > 0U) {
+            const std::size_t write_size =
+                std::min(size, block_size_ - block_.size());
+            block_.insert(block_.end(), data, data + write_size);
+            data += write_size;
+            size -= write_size;
+            if (block_.size() == block_size_) {
+                write_block();
+            }
+        }
+    }
+
+    /*!
+     * \brief Compress and write the data in the current block.
+     */
+    void flush() {
+        if (!block_.empty()) {
+            write_block();
+        }
+    }
+
+    /*!
+     * \brief Get the size of blocks.
+     *
+     * \return Size of blocks.
+     */
+    [[nodiscard]] std::size_t block_size() const noexcept {
+        return block_size_;
+    }
+
+private:
+    /*!
+     * \brief Compress and write the current block.
+     */
+    void write_block() {
+        unsigned char* const stored = compressed_.data() +
+            compression_frame_header_size;
+        std::size_t stored_size = details::lz_compress_block(
+            block_.data(), block_.size(), stored, hash_table_);
+        if (stored_size >= block_.size()) {
+            // Data which cannot be compressed is stored as is.
+            stored_size = block_.size();
+            std::memcpy(stored, block_.data(), stored_size);
+        }
+
+        write_big_endian32(
+            compressed_.data(), static_cast<std::uint32_t>(block_.size()));
+        write_big_endian32(compressed_.data() + 4U,
+            static_cast<std::uint32_t>(stored_size));
+        stream_.write(
+            compressed_.data(), compression_frame_header_size + stored_size);
+        block_.clear();
+    }
+
+    /*!
+     * \brief Write a 32-bit integer in big endian.
+     *
+     * \param[out] output Pointer to the output.
+     * \param[in] value Value.
+     */
+    static void write_big_endian32(
+        unsigned char* output, std::uint32_t value) noexcept {
+        constexpr std::size_t num_bytes = 4U;
+        constexpr unsigned int bits_per_byte = 8U;
+        for (std::size_t i = 0; i < num_bytes; ++i) {
+            output[i] = static_cast<unsigned char>(
+                value >> (bits_per_byte * (num_bytes - 1U - i)));
+        }
+    }
+
+    //! Stream to write compressed data to.
+    output_stream& stream_;
+
+    //! Size of blocks.
+    std::size_t block_size_;
+
+    //! Data in the current block.
+    std::vector<unsigned char> block_{};
+
+    //! Buffer of a compressed frame.
+    std::vector<unsigned char> compressed_{};
+
+    //! Hash table used in compression.
+    std::vector<std::uint32_t> hash_table_{};
+};
+
+}  // namespace msgpack_light
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of decompressing_reader class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/compressing_output_stream.h"
+#include "msgpack_light/details/lz_codec.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class to decompress data written by compressing_output_stream class.
+ *
+ * Frames can be decompressed one by one using read_block() function, or
+ * extracted using next_frame() function and decompressed using
+ * decompress_frame() function (in parallel, for example).
+ *
+ * \note This class doesn't manage the memory of the compressed data.
+ */
+class decompressing_reader {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Pointer to the compressed data.
+     * \param[in] size Size of the compressed data.
+     */
+    decompressing_reader(const unsigned char* data, std::size_t size) noexcept
+        : data_(data), size_(size) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Compressed data.
+     */
+    explicit decompressing_reader(binary_view data) noexcept
+        : decompressing_reader(data.data(), data.size()) {}
+
+    /*!
+     * \brief Check whether there are remaining frames.
+     *
+     * \retval true There are remaining frames.
+     * \retval false No frame remains.
+     */
+    [[nodiscard]] bool has_next() const noexcept { return position_ < size_; }
+
+    /*!
+     * \brief Get the next frame without decompression.
+     *
+     * \note This function throws exceptions for invalid data.
+     *
+     * \return Frame including its header.
+     */
+    [[nodiscard]] binary_view next_frame() {
+        if (size_ - position_ < compression_frame_header_size) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        const std::size_t stored_size =
+            read_big_endian32(data_ + position_ + 4U);
+        if (size_ - position_ - compression_frame_header_size < stored_size) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        const auto frame = binary_view(
+            data_ + position_, compression_frame_header_size + stored_size);
+        position_ += frame.size();
+        return frame;
+    }
+
+    /*!
+     * \brief Decompress the next block.
+     *
+     * \note This function throws exceptions for invalid data.
+     *
+     * \return Data in the block.
+     */
+    [[nodiscard]] binary read_block() { return decompress_frame(next_frame()); }
+
+    /*!
+     * \brief Decompress all the remaining blocks.
+     *
+     * \note This function throws exceptions for invalid data.
+     *
+     * \return Data in the blocks.
+     */
+    [[nodiscard]] binary read_all() {
+        binary result;
+        while (has_next()) {
+            const binary_view frame = next_frame();
+            const std::size_t offset = result.size();
+            result.resize(offset + original_size_of(frame));
+            decompress_frame_to(frame, result.data() + offset);
+        }
+        return result;
+    }
+
+    /*!
+     * \brief Decompress a frame.
+     *
+     * \note This function throws exceptions for invalid data.
+     *
+     * \param[in] frame Frame including its header.
+     * \return Data in the block.
+     */
+    [[nodiscard]] static binary decompress_frame(binary_view frame) {
+        binary result(original_size_of(frame));
+        decompress_frame_to(frame, result.data());
+        return result;
+    }
+
+private:
+    /*!
+     * \brief Get the size of the original data in a frame.
+     *
+     * Sizes in the header are validated here so that invalid headers don't
+     * cause allocation of large buffers.
+     *
+     * \param[in] frame Frame including its header.
+     * \return Size of the original data.
+     */
+    [[nodiscard]] static std::size_t original_size_of(binary_view frame) {
+        if (frame.size() < compression_frame_header_size) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        const std::size_t original_size = read_big_endian32(frame.data());
+        const std::size_t stored_size = read_big_endian32(frame.data() + 4U);
+        if (frame.size() != compression_frame_header_size + stored_size ||
+            stored_size > original_size ||
+            original_size > max_compression_block_size ||
+            original_size > details::lz_max_decompressed_size(stored_size)) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        return original_size;
+    }
+
+    /*!
+     * \brief Decompress a frame to a buffer.
+     *
+     * \param[in] frame Frame including its header. (Validated using
+     * original_size_of function.)
+     * \param[out] output Buffer with the size of the original data.
+     */
+    static void decompress_frame_to(binary_view frame, unsigned char* output) {
+        const std::size_t original_size = read_big_endian32(frame.data());
+        const std::size_t stored_size = read_big_endian32(frame.data() + 4U);
+        const unsigned char* stored =
+            frame.data() + compression_frame_header_size;
+        if (stored_size == original_size) {
+            std::memcpy(output, stored, stored_size);
+            return;
+        }
+        details::lz_decompress_block(
+            stored, stored_size, output, original_size);
+    }
+
+    /*!
+     * \brief Read a 32-bit integer in big endian.
+     *
+     * \param[in] input Pointer to the input.
+     * \return Value.
+     */
+    [[nodiscard]] static std::size_t read_big_endian32(
+        const unsigned char* input) noexcept {
+        constexpr std::size_t num_bytes = 4U;
+        constexpr unsigned int bits_per_byte = 8U;
+        std::uint32_t value = 0U;
+        for (std::size_t i = 0; i < num_bytes; ++i) {
+            value <<= bits_per_byte;
+            value |= static_cast<std::uint32_t>(input[i]);
+        }
+        return static_cast<std::size_t>(value);
+    }
+
+    //! Pointer to the compressed data.
+    const unsigned char* data_;
+
+    //! Size of the compressed data.
+    std::size_t size_;
+
+    //! Position of the next frame.
+    std::size_t position_{0U};
+};
+
+}  // namespace msgpack_light
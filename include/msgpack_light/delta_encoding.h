@@ -0,0 +1,402 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of classes and functions of delta encoding of sequences of
+ * integers and time points.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace msgpack_light {
+
+/*!
+ * \brief Default type of the extension used in delta encoding.
+ */
+constexpr auto default_delta_encoding_ext_type = static_cast<std::int8_t>(1);
+
+/*!
+ * \brief Default of the maximum number of values decoded from delta encoding.
+ *
+ * Data with a bit width of zero has the same size regardless of the number of
+ * values, so the number of values in data must be limited to prevent
+ * allocation of huge memory for invalid data.
+ */
+constexpr std::size_t default_delta_encoding_max_decoded_count = 0x1000000U;
+
+namespace details {
+
+/*!
+ * \brief Check whether a type is supported in delta encoding.
+ *
+ * \tparam T Type.
+ */
+template <typename T>
+constexpr bool is_delta_encodable_v = std::is_same_v<T, std::int64_t> ||
+    std::is_same_v<T, std::chrono::system_clock::time_point>;
+
+/*!
+ * \brief Convert a value to an integer used in delta encoding.
+ *
+ * \param[in] value Value.
+ * \return Integer.
+ */
+[[nodiscard]] inline std::uint64_t to_delta_encoding_integer(
+    std::int64_t value) noexcept {
+    return static_cast<std::uint64_t>(value);
+}
+
+/*!
+ * \brief Convert a value to an integer used in delta encoding.
+ *
+ * Time points are converted to the number of nanoseconds from the epoch.
+ *
+ * \param[in] value Value.
+ * \return Integer.
+ */
+[[nodiscard]] inline std::uint64_t to_delta_encoding_integer(
+    std::chrono::system_clock::time_point value) noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            value.time_since_epoch())
+            .count());
+}
+
+/*!
+ * \brief Convert an integer used in delta encoding to a value.
+ *
+ * \tparam T Type of the value.
+ * \param[in] integer Integer.
+ * \return Value.
+ */
+template <typename T>
+[[nodiscard]] inline T from_delta_encoding_integer(
+    std::uint64_t integer) noexcept {
+    if constexpr (std::is_same_v<T, std::int64_t>) {
+        return static_cast<std::int64_t>(integer);
+    } else {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(static_cast<std::int64_t>(integer))));
+    }
+}
+
+/*!
+ * \brief Encode a difference of integers using zigzag encoding.
+ *
+ * \param[in] delta Difference (in two's complement).
+ * \return Encoded value.
+ */
+[[nodiscard]] inline std::uint64_t zigzag_encode(std::uint64_t delta) noexcept {
+    constexpr unsigned int sign_shift = 63U;
+    const std::uint64_t sign_mask =
+        static_cast<std::uint64_t>(0U) - (delta >> sign_shift);
+    return (delta << 1U) ^ sign_mask;
+}
+
+/*!
+ * \brief Decode a value encoded using zigzag encoding.
+ *
+ * \param[in] encoded Encoded value.
+ * \return Difference (in two's complement).
+ */
+[[nodiscard]] inline std::uint64_t zigzag_decode(
+    std::uint64_t encoded) noexcept {
+    const std::uint64_t sign_mask =
+        static_cast<std::uint64_t>(0U) - (encoded & 1U);
+    return (encoded >> 1U) ^ sign_mask;
+}
+
+//! Size of the header in delta encoding (count, bit width, and base value).
+constexpr std::size_t delta_encoding_header_size = 13U;
+
+//! Maximum number of values in delta encoding.
+constexpr std::size_t max_delta_encoding_count = 0xFFFFFFFFU;
+
+/*!
+ * \brief Calculate the size of data in delta encoding.
+ *
+ * \param[in] count Number of values.
+ * \param[in] bit_width Number of bits of each encoded difference.
+ * \return Size of data.
+ */
+[[nodiscard]] inline std::size_t delta_encoded_data_size(
+    std::size_t count, unsigned int bit_width) noexcept {
+    if (count == 0U) {
+        return delta_encoding_header_size;
+    }
+    constexpr std::size_t bits_per_byte = 8U;
+    // Use 64-bit integers to avoid overflow on 32-bit platforms.
+    const std::uint64_t num_bits =
+        static_cast<std::uint64_t>(count - 1U) * bit_width;
+    return delta_encoding_header_size +
+        static_cast<std::size_t>(
+            (num_bits + bits_per_byte - 1U) / bits_per_byte);
+}
+
+/*!
+ * \brief Calculate the number of bits required for encoded differences.
+ *
+ * \tparam T Type of values.
+ * \param[in] values Pointer to values.
+ * \param[in] count Number of values.
+ * \return Number of bits.
+ */
+template <typename T>
+[[nodiscard]] inline unsigned int delta_encoding_bit_width(
+    const T* values, std::size_t count) noexcept {
+    // This loop has no dependencies between iterations except for the
+    // reduction, so compilers can vectorize it.
+    std::uint64_t bits = 0U;
+    for (std::size_t i = 1; i < count; ++i) {
+        bits |= zigzag_encode(to_delta_encoding_integer(values[i]) -
+            to_delta_encoding_integer(values[i - 1U]));
+    }
+    unsigned int bit_width = 0U;
+    while (bits != 0U) {
+        ++bit_width;
+        bits >>= 1U;
+    }
+    return bit_width;
+}
+
+/*!
+ * \brief Read bits of an encoded difference in delta encoding.
+ *
+ * \param[in] data Pointer to the bit-packed differences.
+ * \param[in] size Size of the bit-packed differences.
+ * \param[in] bit_position Position of the first bit.
+ * \param[in] bit_width Number of bits.
+ * \return Value.
+ */
+[[nodiscard]] inline std::uint64_t read_packed_bits(const unsigned char* data,
+    std::size_t size, std::uint64_t bit_position,
+    unsigned int bit_width) noexcept {
+    constexpr unsigned int bits_per_byte = 8U;
+    constexpr unsigned int bits_per_word = 64U;
+    const auto byte_position =
+        static_cast<std::size_t>(bit_position / bits_per_byte);
+    const auto shift =
+        static_cast<unsigned int>(bit_position % bits_per_byte);
+
+    std::uint64_t word = 0U;
+    const std::size_t num_bytes =
+        std::min(sizeof(std::uint64_t), size - byte_position);
+    for (std::size_t i = 0; i < num_bytes; ++i) {
+        word |= static_cast<std::uint64_t>(data[byte_position + i])
+            << (bits_per_byte * i);
+    }
+    std::uint64_t value = word >> shift;
+    if (shift + bit_width > bits_per_word) {
+        value |= static_cast<std::uint64_t>(
+                     data[byte_position + sizeof(std::uint64_t)])
+            << (bits_per_word - shift);
+    }
+    if (bit_width < bits_per_word) {
+        value &= (static_cast<std::uint64_t>(1U) << bit_width) - 1U;
+    }
+    return value;
+}
+
+/*!
+ * \brief Decode values in delta encoding.
+ *
+ * \tparam T Type of values.
+ * \param[in] data Pointer to the data of the extension.
+ * \param[in] size Size of the data of the extension.
+ * \param[in] max_count Maximum number of values.
+ * \return Values.
+ */
+template <typename T>
+[[nodiscard]] inline std::vector<T> decode_delta_encoded_values(
+    const unsigned char* data, std::size_t size, std::size_t max_count) {
+    if (size < delta_encoding_header_size) {
+        throw std::runtime_error("Invalid delta-encoded data.");
+    }
+    std::uint64_t count = 0U;
+    constexpr std::size_t count_size = 4U;
+    for (std::size_t i = 0; i < count_size; ++i) {
+        count = (count << 8U) | static_cast<std::uint64_t>(data[i]);  // NOLINT
+    }
+    const auto bit_width = static_cast<unsigned int>(data[count_size]);
+    std::uint64_t base = 0U;
+    for (std::size_t i = count_size + 1U; i < delta_encoding_header_size;
+         ++i) {
+        base = (base << 8U) | static_cast<std::uint64_t>(data[i]);  // NOLINT
+    }
+    constexpr unsigned int max_bit_width = 64U;
+    if (bit_width > max_bit_width ||
+        delta_encoded_data_size(static_cast<std::size_t>(count), bit_width) !=
+            size) {
+        throw std::runtime_error("Invalid delta-encoded data.");
+    }
+    if (count > max_count) {
+        throw std::runtime_error("Too many values in delta-encoded data.");
+    }
+
+    std::vector<T> values;
+    if (count == 0U) {
+        return values;
+    }
+    values.reserve(static_cast<std::size_t>(count));
+    values.push_back(from_delta_encoding_integer<T>(base));
+    const unsigned char* packed = data + delta_encoding_header_size;
+    const std::size_t packed_size = size - delta_encoding_header_size;
+    std::uint64_t current = base;
+    std::uint64_t bit_position = 0U;
+    for (std::uint64_t i = 1; i < count; ++i) {
+        current += zigzag_decode(
+            read_packed_bits(packed, packed_size, bit_position, bit_width));
+        bit_position += bit_width;
+        values.push_back(from_delta_encoding_integer<T>(current));
+    }
+    return values;
+}
+
+}  // namespace details
+
+/*!
+ * \brief Class of views of sequences serialized using delta encoding.
+ *
+ * Sequences of slowly changing values (timestamps, counters, ...) can be
+ * serialized in small data using this class. Values are serialized into an
+ * extension with the following data:
+ *
+ * | Field | Size | Description |
+ * | :--- | :--- | :--- |
+ * | count | 4 bytes | Number of values (unsigned, big endian). |
+ * | bit width | 1 byte | Number of bits of each difference (0 to 64). |
+ * | base | 8 bytes | The first value (signed, big endian). |
+ * | differences | variable | Bit-packed differences. |
+ *
+ * Differences of consecutive values are encoded using zigzag encoding, and
+ * packed using the smallest number of bits which can hold all the differences.
+ * The packed bits are stored from the least significant bit of the first byte.
+ * Time points are converted to the number of nanoseconds from the epoch.
+ *
+ * Use decode_delta_encoded_int64() function or
+ * decode_delta_encoded_time_points() function to decode the data.
+ *
+ * \note This class doesn't manage the memory of the values.
+ *
+ * \tparam T Type of values. (`std::int64_t` or
+ * `std::chrono::system_clock::time_point`.)
+ */
+template <typename T>
+class delta_encoded_view {
+public:
+    static_assert(details::is_delta_encodable_v<T>,
+        "Type of values must be std::int64_t or "
+        "std::chrono::system_clock::time_point.");
+
+    //! Type of values.
+    using value_type = T;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Pointer to the values.
+     * \param[in] size Number of the values.
+     * \param[in] ext_type Type of the extension.
+     */
+    delta_encoded_view(const T* data, std::size_t size,
+        std::int8_t ext_type = default_delta_encoding_ext_type) noexcept
+        : data_(data), size_(size), ext_type_(ext_type) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] values Values.
+     * \param[in] ext_type Type of the extension.
+     */
+    explicit delta_encoded_view(const std::vector<T>& values,
+        std::int8_t ext_type = default_delta_encoding_ext_type) noexcept
+        : delta_encoded_view(values.data(), values.size(), ext_type) {}
+
+    /*!
+     * \brief Get the pointer to the values.
+     *
+     * \return Pointer to the values.
+     */
+    [[nodiscard]] const T* data() const noexcept { return data_; }
+
+    /*!
+     * \brief Get the number of the values.
+     *
+     * \return Number of the values.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /*!
+     * \brief Get the type of the extension.
+     *
+     * \return Type of the extension.
+     */
+    [[nodiscard]] std::int8_t ext_type() const noexcept { return ext_type_; }
+
+private:
+    //! Pointer to the values.
+    const T* data_;
+
+    //! Number of the values.
+    std::size_t size_;
+
+    //! Type of the extension.
+    std::int8_t ext_type_;
+};
+
+/*!
+ * \brief Decode integers serialized using delta_encoded_view class.
+ *
+ * \note This function throws exceptions for invalid data.
+ *
+ * \param[in] data Pointer to the data of the extension.
+ * \param[in] size Size of the data of the extension.
+ * \param[in] max_count Maximum number of values.
+ * \return Integers.
+ */
+[[nodiscard]] inline std::vector<std::int64_t> decode_delta_encoded_int64(
+    const unsigned char* data, std::size_t size,
+    std::size_t max_count = default_delta_encoding_max_decoded_count) {
+    return details::decode_delta_encoded_values<std::int64_t>(
+        data, size, max_count);
+}
+
+/*!
+ * \brief Decode time points serialized using delta_encoded_view class.
+ *
+ * \note This function throws exceptions for invalid data.
+ *
+ * \param[in] data Pointer to the data of the extension.
+ * \param[in] size Size of the data of the extension.
+ * \param[in] max_count Maximum number of values.
+ * \return Time points.
+ */
+[[nodiscard]] inline std::vector<std::chrono::system_clock::time_point>
+decode_delta_encoded_time_points(const unsigned char* data, std::size_t size,
+    std::size_t max_count = default_delta_encoding_max_decoded_count) {
+    return details::decode_delta_encoded_values<
+        std::chrono::system_clock::time_point>(data, size, max_count);
+}
+
+}  // namespace msgpack_light
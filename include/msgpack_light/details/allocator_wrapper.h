@@ -20,6 +20,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>  // IWYU pragma: keep
 
 #include "msgpack_light/details/object_data.h"
@@ -47,10 +48,16 @@ public:
      *
      * \param[in] size Number of elements.
      * \return Pointer to the allocated object data.
+     *
+     * \note A header (array_header) is placed before the object data.
      */
     [[nodiscard]] object_data* allocate_object_data(std::size_t size) {
-        return static_cast<object_data*>(allocator_.allocate(
-            size * sizeof(object_data), alignof(object_data)));
+        auto* header = static_cast<array_header*>(allocator_.allocate(
+            sizeof(array_header) + size * sizeof(object_data),
+            alignof(object_data)));
+        header->capacity = size;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<object_data*>(header + 1);
     }
 
     /*!
@@ -59,7 +66,10 @@ public:
      * \param[in] ptr Pointer to the object data.
      */
     void deallocate_object_data(object_data* ptr) noexcept {
-        allocator_.deallocate(ptr);
+        if (ptr == nullptr) {
+            return;
+        }
+        allocator_.deallocate(get_array_header(ptr));
     }
 
     /*!
@@ -67,11 +77,18 @@ public:
      *
      * \param[in] size Number of pairs.
      * \return Pointer to the allocated key-value pair data.
+     *
+     * \note A header (map_header) is placed before the key-value pairs.
      */
     [[nodiscard]] key_value_pair_data* allocate_key_value_pair_data(
         std::size_t size) {
-        return static_cast<key_value_pair_data*>(allocator_.allocate(
-            size * sizeof(key_value_pair_data), alignof(key_value_pair_data)));
+        auto* header = static_cast<map_header*>(allocator_.allocate(
+            sizeof(map_header) + size * sizeof(key_value_pair_data),
+            alignof(key_value_pair_data)));
+        header->index = nullptr;
+        header->capacity = size;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<key_value_pair_data*>(header + 1);
     }
 
     /*!
@@ -80,6 +97,41 @@ public:
      * \param[in] ptr Pointer to the key-value pair data.
      */
     void deallocate_key_value_pair_data(key_value_pair_data* ptr) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        map_header* header = get_map_header(ptr);
+        deallocate_map_index(header->index);
+        allocator_.deallocate(header);
+    }
+
+    /*!
+     * \brief Allocate a hash index of keys in a map.
+     *
+     * \param[in] num_slots Number of slots.
+     * \return Pointer to the allocated index.
+     *
+     * \note Slots are not initialized.
+     */
+    [[nodiscard]] map_index* allocate_map_index(std::size_t num_slots) {
+        auto* index = static_cast<map_index*>(
+            allocator_.allocate(sizeof(map_index) +
+                    num_slots * sizeof(std::uint64_t),
+                alignof(map_index)));
+        index->num_slots = num_slots;
+        index->is_valid = false;
+        return index;
+    }
+
+    /*!
+     * \brief Deallocate a hash index of keys in a map.
+     *
+     * \param[in] ptr Pointer to the index.
+     */
+    void deallocate_map_index(map_index* ptr) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
         allocator_.deallocate(ptr);
     }
 
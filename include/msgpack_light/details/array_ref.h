@@ -19,8 +19,8 @@
  */
 #pragma once
 
-#include <algorithm>
-#include <cstring>
+#include <cstddef>
+#include <cstdint>
 
 #include "msgpack_light/details/allocator_wrapper.h"
 #include "msgpack_light/details/array_iterator.h"
@@ -58,7 +58,7 @@ public:
      *
      * \param[in] data Data.
      */
-    explicit const_array_ref(const details::array_data& data) : data_(&data) {}
+    explicit const_array_ref(const details::object_data& data) : data_(&data) {}
 
     /*!
      * \brief Get the size.
@@ -82,7 +82,7 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_array_iterator begin() const noexcept {
-        return const_array_iterator{data_->data};
+        return const_array_iterator{data_->data.array_value};
     }
 
     /*!
@@ -91,7 +91,7 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_array_iterator end() const noexcept {
-        return const_array_iterator{data_->data + data_->size};
+        return const_array_iterator{data_->data.array_value + data_->size};
     }
 
     /*!
@@ -100,7 +100,7 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_array_iterator cbegin() const noexcept {
-        return const_array_iterator{data_->data};
+        return const_array_iterator{data_->data.array_value};
     }
 
     /*!
@@ -109,12 +109,12 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_array_iterator cend() const noexcept {
-        return const_array_iterator{data_->data + data_->size};
+        return const_array_iterator{data_->data.array_value + data_->size};
     }
 
 private:
     //! Data.
-    const details::array_data* data_;
+    const details::object_data* data_;
 };
 
 /*!
@@ -153,7 +153,7 @@ public:
      * \param[in] data Data.
      * \param[in] allocator Allocator.
      */
-    mutable_array_ref(details::array_data& data,
+    mutable_array_ref(details::object_data& data,
         details::allocator_wrapper<Allocator>& allocator)
         : data_(&data), allocator_(&allocator) {}
 
@@ -161,25 +161,73 @@ public:
      * \brief Change the size.
      *
      * \param[in] size Size.
+     *
+     * \note Memory is reallocated only when the size exceeds the capacity,
+     * and the capacity grows geometrically.
      */
     void resize(std::size_t size) {
+        details::check_object_data_size(size);
         if (size < data_->size) {
             for (std::size_t i = size; i < data_->size; ++i) {
-                details::clear_object_data(data_->data[i], *allocator_);
+                details::clear_object_data(
+                    data_->data.array_value[i], *allocator_);
+            }
+        } else if (size > data_->size) {
+            if (size > capacity()) {
+                details::reallocate_array_data(*data_,
+                    details::grown_capacity(capacity(), size), *allocator_);
             }
+            details::fill_with_nil(
+                data_->data.array_value + data_->size, size - data_->size);
         }
-        details::object_data* new_data = allocator_->allocate_object_data(size);
-        std::memcpy(new_data, data_->data,
-            std::min(data_->size, size) * sizeof(details::object_data));
-        allocator_->deallocate_object_data(data_->data);
-        data_->data = new_data;
-        if (size > data_->size) {
-            std::memset(data_->data + data_->size, 0,
-                (size - data_->size) * sizeof(details::object_data));
+        data_->size = static_cast<std::uint32_t>(size);
+    }
+
+    /*!
+     * \brief Reserve memory for elements.
+     *
+     * \param[in] capacity Number of elements.
+     */
+    void reserve(std::size_t capacity) {
+        if (capacity > this->capacity()) {
+            details::check_object_data_size(capacity);
+            details::reallocate_array_data(*data_, capacity, *allocator_);
         }
-        data_->size = size;
     }
 
+    /*!
+     * \brief Get the number of elements which can be stored without
+     * reallocation.
+     *
+     * \return Capacity.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return details::get_array_header(data_->data.array_value)->capacity;
+    }
+
+    /*!
+     * \brief Add an element of nil to the end.
+     *
+     * \return Object of the added element.
+     *
+     * \warning References to elements are invalidated
+     * when memory is reallocated.
+     */
+    mutable_object_ref_type emplace_back();
+
+    /*!
+     * \brief Add a copy of an object to the end.
+     *
+     * \tparam Object Type of the object (msgpack_light::object,
+     * msgpack_light::const_object_ref, or msgpack_light::mutable_object_ref).
+     * \param[in] value Object to copy.
+     *
+     * \warning References to elements are invalidated
+     * when memory is reallocated.
+     */
+    template <typename Object>
+    void push_back(const Object& value);
+
     /*!
      * \brief Get the size.
      *
@@ -211,7 +259,8 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] mutable_array_iterator<Allocator> begin() noexcept {
-        return mutable_array_iterator<Allocator>{data_->data, allocator_};
+        return mutable_array_iterator<Allocator>{
+            data_->data.array_value, allocator_};
     }
 
     /*!
@@ -221,7 +270,7 @@ public:
      */
     [[nodiscard]] mutable_array_iterator<Allocator> end() noexcept {
         return mutable_array_iterator<Allocator>{
-            data_->data + data_->size, allocator_};
+            data_->data.array_value + data_->size, allocator_};
     }
 
     /*!
@@ -230,7 +279,7 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_array_iterator begin() const noexcept {
-        return const_array_iterator{data_->data};
+        return const_array_iterator{data_->data.array_value};
     }
 
     /*!
@@ -239,12 +288,12 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_array_iterator end() const noexcept {
-        return const_array_iterator{data_->data + data_->size};
+        return const_array_iterator{data_->data.array_value + data_->size};
     }
 
 private:
     //! Data.
-    details::array_data* data_;
+    details::object_data* data_;
 
     //! Allocator.
     details::allocator_wrapper<Allocator>* allocator_;
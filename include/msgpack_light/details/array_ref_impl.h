@@ -23,6 +23,7 @@
 
 #include "msgpack_light/details/array_ref.h"
 #include "msgpack_light/details/object_data.h"
+#include "msgpack_light/details/object_helper.h"
 #include "msgpack_light/details/object_ref.h"  // IWYU pragma: keep
 
 namespace msgpack_light {
@@ -34,13 +35,49 @@ namespace msgpack_light {
 template <typename Allocator>
 inline typename mutable_array_ref<Allocator>::mutable_object_ref_type
 mutable_array_ref<Allocator>::operator[](std::size_t index) noexcept {
-    return mutable_object_ref_type(data_->data[index], *allocator_);
+    return mutable_object_ref_type(data_->data.array_value[index], *allocator_);
 }
 
 template <typename Allocator>
 inline typename mutable_array_ref<Allocator>::const_object_ref_type
 mutable_array_ref<Allocator>::operator[](std::size_t index) const noexcept {
-    return const_object_ref_type{data_->data[index]};
+    return const_object_ref_type{data_->data.array_value[index]};
+}
+
+template <typename Allocator>
+inline typename mutable_array_ref<Allocator>::mutable_object_ref_type
+mutable_array_ref<Allocator>::emplace_back() {
+    if (data_->size == capacity()) {
+        details::check_object_data_size(size() + 1U);
+        details::reallocate_array_data(*data_,
+            details::grown_capacity(capacity(), size() + 1U),
+            *allocator_);
+    }
+    details::object_data& element = data_->data.array_value[data_->size];
+    details::fill_with_nil(&element, 1U);
+    ++data_->size;
+    return mutable_object_ref_type(element, *allocator_);
+}
+
+template <typename Allocator>
+template <typename Object>
+inline void mutable_array_ref<Allocator>::push_back(const Object& value) {
+    // Copy first, because the value may be an element of this array.
+    details::object_data copy{};
+    details::copy_object_data(copy, value.data(), *allocator_);
+    if (data_->size == capacity()) {
+        try {
+            details::check_object_data_size(size() + 1U);
+            details::reallocate_array_data(*data_,
+                details::grown_capacity(capacity(), size() + 1U),
+                *allocator_);
+        } catch (...) {
+            details::clear_object_data(copy, *allocator_);
+            throw;
+        }
+    }
+    std::memcpy(&data_->data.array_value[data_->size], &copy, sizeof(copy));
+    ++data_->size;
 }
 
 /*
@@ -49,7 +86,7 @@ mutable_array_ref<Allocator>::operator[](std::size_t index) const noexcept {
 
 inline typename const_array_ref::const_object_ref_type
 const_array_ref::operator[](std::size_t index) const noexcept {
-    return const_object_ref_type{data_->data[index]};
+    return const_object_ref_type{data_->data.array_value[index]};
 }
 
 }  // namespace msgpack_light
@@ -19,35 +19,157 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <cstddef>  // IWYU pragma: keep
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <new>
+#include <type_traits>
 #include <utility>
 
+#include "msgpack_light/standard_allocator.h"
+
 namespace msgpack_light::details {
 
+/*!
+ * \brief Class to hold allocators.
+ *
+ * This class uses empty base optimization for empty allocators
+ * to avoid increasing sizes of objects holding allocators.
+ *
+ * \tparam Allocator Type of the allocator.
+ */
+template <typename Allocator,
+    bool UseEmptyBase =
+        std::is_empty_v<Allocator> && !std::is_final_v<Allocator>>
+class allocator_holder : private Allocator {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] allocator Allocator.
+     */
+    explicit allocator_holder(Allocator allocator)
+        : Allocator(std::move(allocator)) {}
+
+    /*!
+     * \brief Get the allocator.
+     *
+     * \return Allocator.
+     */
+    [[nodiscard]] Allocator& allocator() noexcept { return *this; }
+
+    /*!
+     * \brief Get the allocator.
+     *
+     * \return Allocator.
+     */
+    [[nodiscard]] const Allocator& allocator() const noexcept { return *this; }
+};
+
+/*!
+ * \brief Class to hold allocators.
+ *
+ * \tparam Allocator Type of the allocator.
+ */
+template <typename Allocator>
+class allocator_holder<Allocator, false> {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] allocator Allocator.
+     */
+    explicit allocator_holder(Allocator allocator)
+        : allocator_(std::move(allocator)) {}
+
+    /*!
+     * \brief Get the allocator.
+     *
+     * \return Allocator.
+     */
+    [[nodiscard]] Allocator& allocator() noexcept { return allocator_; }
+
+    /*!
+     * \brief Get the allocator.
+     *
+     * \return Allocator.
+     */
+    [[nodiscard]] const Allocator& allocator() const noexcept {
+        return allocator_;
+    }
+
+private:
+    //! Allocator.
+    Allocator allocator_;
+};
+
+//! Number of bytes of capacities in binary_buffer_heap_storage struct.
+constexpr std::size_t binary_buffer_capacity_bytes = 7U;
+
+/*!
+ * \brief Struct of data of buffers allocated using allocators in
+ * basic_binary_buffer class.
+ */
+struct binary_buffer_heap_storage {
+    //! Buffer.
+    unsigned char* data;
+
+    //! Size of the data in the buffer.
+    std::size_t size;
+
+    //! Capacity of the buffer in little endian without the most significant
+    //! byte.
+    unsigned char capacity[binary_buffer_capacity_bytes];  // NOLINT
+
+    //! Tag to distinguish from buffers stored in basic_binary_buffer objects.
+    unsigned char tag;
+};
+
 /*!
  * \brief Class of basic buffers for binary data.
  *
+ * Buffers with sizes up to inline_capacity are stored in this object
+ * without allocation of memory (small buffer optimization).
+ * The last byte of this object holds the size of the inline buffer,
+ * or a tag for allocated buffers.
+ *
  * \warning This class is for internal implementations in this library,
  * so omits some checks to avoid undefined behaviors or performance degradation
  * intentionally with an assumption that the user of this class will avoid
  * such conditions.
+ *
+ * \tparam Allocator Type of the allocator.
  */
-class basic_binary_buffer {
+template <typename Allocator = standard_allocator>
+class basic_binary_buffer : private allocator_holder<Allocator> {
 public:
+    //! Type of the allocator.
+    using allocator_type = Allocator;
+
+    //! Maximum size of buffers stored in this object.
+    static constexpr std::size_t inline_capacity =
+        sizeof(binary_buffer_heap_storage) - 1U;
+
+    //! Maximum capacity of buffers.
+    static constexpr std::uint64_t max_capacity =
+        (std::uint64_t{1} << (8U * binary_buffer_capacity_bytes)) - 1U;
+
     /*!
      * \brief Constructor.
      *
      * \param[in] size Size of the buffer.
+     * \param[in] allocator Allocator.
      */
-    explicit basic_binary_buffer(std::size_t size)
-        : buffer_(static_cast<unsigned char*>(
-              std::malloc(prevent_unsafe_size(size)))),
-          size_(size) {
-        if (buffer_ == nullptr) {
-            throw std::bad_alloc();
+    explicit basic_binary_buffer(
+        std::size_t size, Allocator allocator = Allocator())
+        : allocator_holder<Allocator>(std::move(allocator)) {
+        if (size <= inline_capacity) {
+            storage_.inline_data[inline_capacity] =
+                static_cast<unsigned char>(size);
+        } else {
+            set_heap(allocate(size), size, size);
         }
     }
 
@@ -57,17 +179,22 @@ public:
      * \param[in] other Instance to copy from.
      */
     basic_binary_buffer(const basic_binary_buffer& other)
-        : basic_binary_buffer(other.size()) {
-        std::memcpy(buffer_, other.buffer_, other.size_);
+        : basic_binary_buffer(other.size(), other.allocator()) {
+        std::memcpy(data(), other.data(), other.size());
     }
 
     /*!
      * \brief Move constructor.
      *
+     * The moved instance will be an empty buffer.
+     *
      * \param[in,out] other Instance to move from.
      */
     basic_binary_buffer(basic_binary_buffer&& other) noexcept
-        : buffer_(std::exchange(other.buffer_, nullptr)), size_(other.size_) {}
+        : allocator_holder<Allocator>(std::move(other.allocator())),
+          storage_(other.storage_) {
+        other.storage_.inline_data[inline_capacity] = 0U;
+    }
 
     /*!
      * \brief Copy assignment operator.
@@ -79,10 +206,8 @@ public:
         if (this == &other) {
             return *this;
         }
-        if (size_ != other.size_) {
-            resize(other.size());
-        }
-        std::memcpy(buffer_, other.buffer_, other.size_);
+        resize(other.size(), 0U);
+        std::memcpy(data(), other.data(), other.size());
         return *this;
     }
 
@@ -100,24 +225,50 @@ public:
     /*!
      * \brief Destructor.
      */
-    ~basic_binary_buffer() { std::free(buffer_); }
+    ~basic_binary_buffer() {
+        if (!is_inline()) {
+            deallocate(storage_.heap.data);
+        }
+    }
 
     /*!
      * \brief Change the size of the buffer.
      *
      * \param[in] new_size New size of the buffer.
+     */
+    void resize(std::size_t new_size) { resize(new_size, size()); }
+
+    /*!
+     * \brief Change the size of the buffer.
+     *
+     * The capacity is increased to the new size if needed,
+     * and never decreased.
      *
-     * \warning This function always call std::realloc even when the argument is
-     * equal to the current size.
+     * \param[in] new_size New size of the buffer.
+     * \param[in] preserved_size Number of bytes at the beginning of the buffer
+     * preserved after this function.
      */
-    void resize(std::size_t new_size) {
-        auto* new_buffer = static_cast<unsigned char*>(
-            std::realloc(buffer_, prevent_unsafe_size(new_size)));
-        if (new_buffer == nullptr) {
-            throw std::bad_alloc();
+    void resize(std::size_t new_size, std::size_t preserved_size) {
+        if (new_size > capacity()) {
+            reallocate(new_size, std::min(preserved_size, size()));
+        }
+        if (is_inline()) {
+            storage_.inline_data[inline_capacity] =
+                static_cast<unsigned char>(new_size);
+        } else {
+            storage_.heap.size = new_size;
+        }
+    }
+
+    /*!
+     * \brief Increase the capacity of the buffer.
+     *
+     * \param[in] new_capacity Capacity.
+     */
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity > capacity()) {
+            reallocate(new_capacity, size());
         }
-        buffer_ = new_buffer;
-        size_ = new_size;
     }
 
     /*!
@@ -126,8 +277,9 @@ public:
      * \param[in,out] other Instance to swap with.
      */
     void swap(basic_binary_buffer& other) noexcept {
-        std::swap(buffer_, other.buffer_);
-        std::swap(size_, other.size_);
+        using std::swap;
+        swap(this->allocator(), other.allocator());
+        std::swap(storage_, other.storage_);
     }
 
     /*!
@@ -135,64 +287,175 @@ public:
      *
      * \return Pointer to the buffer.
      */
-    [[nodiscard]] unsigned char* data() noexcept { return buffer_; }
+    [[nodiscard]] unsigned char* data() noexcept {
+        return is_inline() ? storage_.inline_data : storage_.heap.data;
+    }
 
     /*!
      * \brief Get the pointer to the buffer.
      *
      * \return Pointer to the buffer.
      */
-    [[nodiscard]] const unsigned char* data() const noexcept { return buffer_; }
+    [[nodiscard]] const unsigned char* data() const noexcept {
+        return is_inline() ? storage_.inline_data : storage_.heap.data;
+    }
 
     /*!
      * \brief Get the size of the buffer.
      *
      * \return Size of the buffer.
      */
-    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t size() const noexcept {
+        return is_inline() ? storage_.inline_data[inline_capacity]
+                           : storage_.heap.size;
+    }
+
+    /*!
+     * \brief Get the capacity of the buffer.
+     *
+     * \return Capacity of the buffer.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        if (is_inline()) {
+            return inline_capacity;
+        }
+        const unsigned char* bytes = storage_.heap.capacity;
+        // NOLINTBEGIN(readability-magic-numbers)
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(bytes[0]) |
+            (static_cast<std::uint64_t>(bytes[1]) << 8U) |
+            (static_cast<std::uint64_t>(bytes[2]) << 16U) |
+            (static_cast<std::uint64_t>(bytes[3]) << 24U) |
+            (static_cast<std::uint64_t>(bytes[4]) << 32U) |
+            (static_cast<std::uint64_t>(bytes[5]) << 40U) |
+            (static_cast<std::uint64_t>(bytes[6]) << 48U));
+        // NOLINTEND(readability-magic-numbers)
+    }
+
+    /*!
+     * \brief Check whether the buffer is stored in this object.
+     *
+     * \retval true The buffer is stored in this object.
+     * \retval false The buffer is allocated using the allocator.
+     */
+    [[nodiscard]] bool is_inline() const noexcept {
+        return storage_.inline_data[inline_capacity] != heap_tag;
+    }
+
+    /*!
+     * \brief Get the allocator.
+     *
+     * \return Allocator.
+     */
+    [[nodiscard]] const Allocator& get_allocator() const noexcept {
+        return this->allocator();
+    }
 
 private:
+    //! Tag of buffers allocated using the allocator.
+    static constexpr unsigned char heap_tag = 0xFFU;
+
     /*!
-     * \brief Change the input to a size which won't cause
-     * implementation-defined behaviors of std::malloc and std::realloc
-     * functions.
+     * \brief Set a buffer allocated using the allocator.
      *
-     * \param[in] size Size.
-     * \return Size to use in std::malloc and std::realloc functions.
+     * \param[in] data Buffer.
+     * \param[in] size Size of the data in the buffer.
+     * \param[in] capacity Capacity of the buffer.
      */
-    [[nodiscard]] static std::size_t prevent_unsafe_size(std::size_t size) {
-        if (size == 0U) {
-            return 1U;
+    void set_heap(
+        unsigned char* data, std::size_t size, std::size_t capacity) noexcept {
+        storage_.heap.data = data;
+        storage_.heap.size = size;
+        auto value = static_cast<std::uint64_t>(capacity);
+        for (unsigned char& byte : storage_.heap.capacity) {
+            byte = static_cast<unsigned char>(value);
+            value >>= 8U;  // NOLINT(readability-magic-numbers)
         }
-        return size;
+        storage_.heap.tag = heap_tag;
     }
 
-    //! Buffer.
-    unsigned char* buffer_;
+    /*!
+     * \brief Move data to a new buffer allocated using the allocator.
+     *
+     * \param[in] new_capacity Capacity of the new buffer.
+     * \param[in] copied_size Number of bytes copied to the new buffer.
+     */
+    void reallocate(std::size_t new_capacity, std::size_t copied_size) {
+        if (static_cast<std::uint64_t>(new_capacity) > max_capacity) {
+            throw std::bad_alloc();
+        }
+        const std::size_t current_size = size();
+        unsigned char* heap = nullptr;
+        if (is_inline()) {
+            heap = allocate(new_capacity);
+            std::memcpy(heap, storage_.inline_data, copied_size);
+        } else if constexpr (std::is_same_v<Allocator, standard_allocator>) {
+            // standard_allocator uses std::malloc function,
+            // so std::realloc function can be used.
+            heap = static_cast<unsigned char*>(
+                std::realloc(storage_.heap.data, new_capacity));
+            if (heap == nullptr) {
+                throw std::bad_alloc();
+            }
+        } else {
+            heap = allocate(new_capacity);
+            std::memcpy(heap, storage_.heap.data, copied_size);
+            deallocate(storage_.heap.data);
+        }
+        set_heap(heap, current_size, new_capacity);
+    }
 
-    //! Size of the buffer.
-    std::size_t size_;
-};
+    /*!
+     * \brief Allocate a buffer.
+     *
+     * \param[in] size Size of the buffer.
+     * \return Buffer.
+     */
+    [[nodiscard]] unsigned char* allocate(std::size_t size) {
+        auto* buffer =
+            static_cast<unsigned char*>(this->allocator().allocate(size, 1U));
+        if (buffer == nullptr) {
+            throw std::bad_alloc();
+        }
+        return buffer;
+    }
 
-}  // namespace msgpack_light::details
+    /*!
+     * \brief Deallocate a buffer.
+     *
+     * \param[in] buffer Buffer.
+     */
+    void deallocate(unsigned char* buffer) noexcept {
+        this->allocator().deallocate(buffer);
+    }
 
-namespace std {
+    /*!
+     * \brief Union of storages of buffers.
+     */
+    union storage_type {
+        //! Buffer allocated using the allocator.
+        binary_buffer_heap_storage heap;
+
+        //! Buffer stored in this object, followed by its size.
+        unsigned char inline_data[inline_capacity + 1U];  // NOLINT
+    };
+
+    static_assert(sizeof(storage_type) == sizeof(binary_buffer_heap_storage));
+
+    //! Storage of the buffer.
+    storage_type storage_{};
+};
 
 /*!
- * \brief Implementation of std::swap for
- * msgpack_light::details::basic_binary_buffer.
+ * \brief Swap two instances of basic_binary_buffer class.
  *
+ * \tparam Allocator Type of the allocator.
  * \param[in,out] instance1 An instance.
  * \param[in,out] instance2 Another instance.
  */
-template <>
-inline void
-swap(  // NOLINT(readability-inconsistent-declaration-parameter-name)
-    // It's impossible to fix this because different implementation of STL can
-    // have different argument names.
-    msgpack_light::details::basic_binary_buffer& instance1,
-    msgpack_light::details::basic_binary_buffer& instance2) noexcept {
+template <typename Allocator>
+inline void swap(basic_binary_buffer<Allocator>& instance1,
+    basic_binary_buffer<Allocator>& instance2) noexcept {
     instance1.swap(instance2);
 }
 
-}  // namespace std
+}  // namespace msgpack_light::details
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of configurable_serialization_buffer_impl class.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>  // IWYU pragma: keep
+#include <cstring>
+#include <memory>
+
+#include "msgpack_light/details/mutable_static_binary_view.h"
+#include "msgpack_light/details/pack_in_big_endian.h"
+#include "msgpack_light/details/static_memory_buffer_size.h"
+#include "msgpack_light/details/total_size_of.h"  // IWYU pragma: keep
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light::details {
+
+/*!
+ * \brief Class to implement internal implementation of serialization_buffer
+ * class with the size of the buffer selected at runtime.
+ *
+ * When the size of the buffer is zero, data is written to the stream
+ * directly without buffers. Buffers up to static_memory_buffer_size bytes
+ * use storage in this object, and larger buffers are allocated on heap.
+ *
+ * Writes which don't fit in the remaining space of the buffer are passed to
+ * a function selected in the constructor. Without buffers, the space is
+ * always empty and the function writes data to the stream directly,
+ * so that writes don't check the size of the buffer again.
+ */
+class configurable_serialization_buffer_impl {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[out] stream Stream to write output to.
+     * \param[in] buffer_size Size of the buffer. (0 for no buffer.)
+     *
+     * \warning This class hold the reference of the given stream.
+     */
+    configurable_serialization_buffer_impl(
+        output_stream& stream, std::size_t buffer_size)
+        : stream_(stream), buffer_size_(buffer_size) {
+        if (buffer_size > 0U) {
+            // Buffers are left uninitialized.
+            if (buffer_size <= static_buffer_.size()) {
+                begin_ = static_buffer_.data();
+            } else {
+                dynamic_buffer_ = std::unique_ptr<unsigned char[]>(  // NOLINT
+                    new unsigned char[buffer_size]);                 // NOLINT
+                begin_ = dynamic_buffer_.get();
+            }
+            current_ = begin_;
+            end_ = begin_ + buffer_size;
+            write_overflow_ =
+                &configurable_serialization_buffer_impl::flush_and_write;
+        }
+    }
+
+    configurable_serialization_buffer_impl(
+        const configurable_serialization_buffer_impl&) = delete;
+    configurable_serialization_buffer_impl(
+        configurable_serialization_buffer_impl&&) = delete;
+    configurable_serialization_buffer_impl& operator=(
+        const configurable_serialization_buffer_impl&) = delete;
+    configurable_serialization_buffer_impl& operator=(
+        configurable_serialization_buffer_impl&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     */
+    ~configurable_serialization_buffer_impl() noexcept { flush(); }
+
+    /*!
+     * \brief Flush the internal buffer in this instance.
+     */
+    void flush() {
+        if (current_ != begin_) {
+            stream_.write(begin_, static_cast<std::size_t>(current_ - begin_));
+            current_ = begin_;
+        }
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) {
+        if (size == 0U) {
+            return;
+        }
+
+        if (static_cast<std::size_t>(end_ - current_) < size) {
+            write_overflow_(*this, data, size);
+            return;
+        }
+
+        std::memcpy(current_, data, size);
+        current_ += size;
+    }
+
+    /*!
+     * \brief Write a byte of data.
+     *
+     * \param[in] data Data.
+     */
+    void put(unsigned char data) {
+        if (current_ == end_) {
+            write_overflow_(*this, &data, 1U);
+            return;
+        }
+        *current_ = data;
+        ++current_;
+    }
+
+    /*!
+     * \brief Write values in big endian.
+     *
+     * \tparam T Types of the values.
+     * \param[in] values Values.
+     */
+    template <typename... T>
+    void write_in_big_endian(T... values) {
+        constexpr std::size_t size = total_size_of<T...>;
+        if (static_cast<std::size_t>(end_ - current_) < size) {
+            std::array<unsigned char, size> buffer{};
+            pack_in_big_endian(
+                mutable_static_binary_view<size>(buffer.data()), values...);
+            write_overflow_(*this, buffer.data(), buffer.size());
+            return;
+        }
+        pack_in_big_endian(
+            mutable_static_binary_view<size>(current_), values...);
+        current_ += size;
+    }
+
+    /*!
+     * \brief Get the size of the buffer.
+     *
+     * \return Size of the buffer.
+     */
+    [[nodiscard]] std::size_t buffer_size() const noexcept {
+        return buffer_size_;
+    }
+
+private:
+    //! Type of functions to write data not fitting in the buffer.
+    using write_overflow_function_type = void (*)(
+        configurable_serialization_buffer_impl&, const unsigned char*,
+        std::size_t);
+
+    /*!
+     * \brief Write data to the stream directly.
+     *
+     * \param[in] self This object.
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    static void write_directly(configurable_serialization_buffer_impl& self,
+        const unsigned char* data, std::size_t size) {
+        self.stream_.write(data, size);
+    }
+
+    /*!
+     * \brief Flush the buffer and write data.
+     *
+     * \param[in] self This object.
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    static void flush_and_write(configurable_serialization_buffer_impl& self,
+        const unsigned char* data, std::size_t size) {
+        self.flush();
+        if (self.buffer_size_ < size) {
+            self.stream_.write(data, size);
+            return;
+        }
+        std::memcpy(self.current_, data, size);
+        self.current_ += size;
+    }
+
+    //! Stream to write output to.
+    output_stream& stream_;
+
+    //! Size of the buffer.
+    std::size_t buffer_size_;
+
+    //! Buffer in this object. (Left uninitialized.)
+    std::array<unsigned char, static_memory_buffer_size>
+        static_buffer_;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+    //! Buffer allocated for large sizes. (Null for small sizes.)
+    std::unique_ptr<unsigned char[]> dynamic_buffer_{};  // NOLINT
+
+    //! Beginning of the buffer. (Null without buffers.)
+    unsigned char* begin_{nullptr};
+
+    //! Current position in the buffer.
+    unsigned char* current_{nullptr};
+
+    //! End of the buffer.
+    unsigned char* end_{nullptr};
+
+    //! Function to write data not fitting in the buffer.
+    write_overflow_function_type write_overflow_{
+        &configurable_serialization_buffer_impl::write_directly};
+};
+
+}  // namespace msgpack_light::details
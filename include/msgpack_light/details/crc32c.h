@@ -0,0 +1,292 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of functions to calculate CRC32C.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define INTERNAL_MSGPACK_LIGHT_HAS_X86_CRC32C 1
+#include <emmintrin.h>
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#else
+#define INTERNAL_MSGPACK_LIGHT_HAS_X86_CRC32C 0
+#endif
+
+namespace msgpack_light::details {
+
+//! Number of tables in slicing-by-8 algorithm.
+constexpr std::size_t crc32c_num_tables = 8U;
+
+//! Type of tables of CRC32C.
+using crc32c_tables_type =
+    std::array<std::array<std::uint32_t, 256U>, crc32c_num_tables>;
+
+/*!
+ * \brief Create tables of CRC32C for slicing-by-8 algorithm.
+ *
+ * \return Tables.
+ */
+[[nodiscard]] constexpr crc32c_tables_type make_crc32c_tables() noexcept {
+    // Reversed polynomial of CRC32C (Castagnoli).
+    constexpr std::uint32_t polynomial = 0x82F63B78U;
+    constexpr unsigned int bits_per_byte = 8U;
+    constexpr std::size_t num_bytes = 256U;
+
+    crc32c_tables_type tables{};
+    for (std::size_t byte = 0; byte < num_bytes; ++byte) {
+        auto crc = static_cast<std::uint32_t>(byte);
+        for (unsigned int bit = 0; bit < bits_per_byte; ++bit) {
+            crc = (crc >> 1U) ^ ((crc & 1U) != 0U ? polynomial : 0U);
+        }
+        tables[0][byte] = crc;
+    }
+    for (std::size_t table = 1; table < crc32c_num_tables; ++table) {
+        for (std::size_t byte = 0; byte < num_bytes; ++byte) {
+            const std::uint32_t previous = tables[table - 1U][byte];
+            tables[table][byte] =
+                (previous >> bits_per_byte) ^ tables[0][previous & 0xFFU];
+        }
+    }
+    return tables;
+}
+
+//! Tables of CRC32C.
+inline constexpr crc32c_tables_type crc32c_tables = make_crc32c_tables();
+
+/*!
+ * \brief Update CRC32C using tables.
+ *
+ * \param[in] crc Current CRC (without the final inversion).
+ * \param[in] data Pointer to the data.
+ * \param[in] size Size of the data.
+ * \return Updated CRC (without the final inversion).
+ */
+[[nodiscard]] inline std::uint32_t update_crc32c_with_tables(
+    std::uint32_t crc, const unsigned char* data, std::size_t size) noexcept {
+    constexpr unsigned int bits_per_byte = 8U;
+    constexpr std::uint32_t byte_mask = 0xFFU;
+
+    // Slicing-by-8 algorithm.
+    // NOLINTBEGIN(readability-magic-numbers)
+    while (size >= crc32c_num_tables) {
+        const std::uint32_t low = crc ^
+            (static_cast<std::uint32_t>(data[0]) |
+                (static_cast<std::uint32_t>(data[1]) << 8U) |
+                (static_cast<std::uint32_t>(data[2]) << 16U) |
+                (static_cast<std::uint32_t>(data[3]) << 24U));
+        crc = crc32c_tables[7][low & byte_mask] ^
+            crc32c_tables[6][(low >> 8U) & byte_mask] ^
+            crc32c_tables[5][(low >> 16U) & byte_mask] ^
+            crc32c_tables[4][low >> 24U] ^ crc32c_tables[3][data[4]] ^
+            crc32c_tables[2][data[5]] ^ crc32c_tables[1][data[6]] ^
+            crc32c_tables[0][data[7]];
+        data += crc32c_num_tables;
+        size -= crc32c_num_tables;
+    }
+    // NOLINTEND(readability-magic-numbers)
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = (crc >> bits_per_byte) ^
+            crc32c_tables[0][(crc ^ data[i]) & byte_mask];
+    }
+    return crc;
+}
+
+/*!
+ * \brief Calculate x^exponent mod P for the polynomial P of CRC32C.
+ *
+ * \param[in] exponent Exponent.
+ * \return Result in the bit-reflected representation used in CRC.
+ */
+[[nodiscard]] constexpr std::uint32_t crc32c_power_of_x(
+    std::size_t exponent) noexcept {
+    constexpr std::uint32_t polynomial = 0x82F63B78U;
+    std::uint32_t result = 0x80000000U;  // x^0
+    for (std::size_t i = 0; i < exponent; ++i) {
+        // Multiply by x.
+        result = (result >> 1U) ^ ((result & 1U) != 0U ? polynomial : 0U);
+    }
+    return result;
+}
+
+#if INTERNAL_MSGPACK_LIGHT_HAS_X86_CRC32C
+
+/*!
+ * \brief Update CRC32C using crc32 instructions in SSE 4.2.
+ *
+ * \param[in] crc Current CRC (without the final inversion).
+ * \param[in] data Pointer to the data.
+ * \param[in] size Size of the data.
+ * \return Updated CRC (without the final inversion).
+ *
+ * \warning Call this function only when the CPU supports SSE 4.2.
+ */
+[[nodiscard]] __attribute__((target("sse4.2"))) inline std::uint32_t
+update_crc32c_with_sse42(
+    std::uint32_t crc, const unsigned char* data, std::size_t size) noexcept {
+    std::uint64_t crc64 = crc;
+    while (size >= sizeof(std::uint64_t)) {
+        std::uint64_t word = 0U;
+        std::memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+    crc = static_cast<std::uint32_t>(crc64);
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = _mm_crc32_u8(crc, data[i]);
+    }
+    return crc;
+}
+
+//! Size of a lane in update_crc32c_with_pclmul function.
+constexpr std::size_t crc32c_lane_size = 512U;
+
+//! Number of lanes in update_crc32c_with_pclmul function.
+constexpr std::size_t crc32c_num_lanes = 3U;
+
+/*!
+ * \brief Update CRC32C using crc32 instructions in SSE 4.2 and carry-less
+ * multiplication in PCLMULQDQ.
+ *
+ * Large data is split into blocks of three lanes. CRCs of the lanes are
+ * calculated in parallel to hide the latency of crc32 instructions, and
+ * folded into one CRC using carry-less multiplication.
+ *
+ * \param[in] crc Current CRC (without the final inversion).
+ * \param[in] data Pointer to the data.
+ * \param[in] size Size of the data.
+ * \return Updated CRC (without the final inversion).
+ *
+ * \warning Call this function only when the CPU supports SSE 4.2 and
+ * PCLMULQDQ.
+ */
+[[nodiscard]] __attribute__((target("sse4.2,pclmul"))) inline std::uint32_t
+update_crc32c_with_pclmul(
+    std::uint32_t crc, const unsigned char* data, std::size_t size) noexcept {
+    constexpr std::size_t bits_per_byte = 8U;
+    // Carry-less multiplication and crc32 instruction of 64 bits multiply
+    // x^33 in addition to the constants.
+    constexpr std::size_t folding_offset = 33U;
+    constexpr std::uint32_t shift_one_lane =
+        crc32c_power_of_x(crc32c_lane_size * bits_per_byte - folding_offset);
+    constexpr std::uint32_t shift_two_lanes = crc32c_power_of_x(
+        2U * crc32c_lane_size * bits_per_byte - folding_offset);
+    constexpr std::size_t block_size = crc32c_lane_size * crc32c_num_lanes;
+
+    const __m128i shifts =
+        _mm_set_epi64x(static_cast<long long>(shift_one_lane),
+            static_cast<long long>(shift_two_lanes));
+    std::uint64_t crc0 = crc;
+    while (size >= block_size) {
+        std::uint64_t crc1 = 0U;
+        std::uint64_t crc2 = 0U;
+        const unsigned char* lane1 = data + crc32c_lane_size;
+        const unsigned char* lane2 = lane1 + crc32c_lane_size;
+        for (std::size_t offset = 0; offset < crc32c_lane_size;
+             offset += sizeof(std::uint64_t)) {
+            std::uint64_t word0 = 0U;
+            std::uint64_t word1 = 0U;
+            std::uint64_t word2 = 0U;
+            std::memcpy(&word0, data + offset, sizeof(word0));
+            std::memcpy(&word1, lane1 + offset, sizeof(word1));
+            std::memcpy(&word2, lane2 + offset, sizeof(word2));
+            crc0 = _mm_crc32_u64(crc0, word0);
+            crc1 = _mm_crc32_u64(crc1, word1);
+            crc2 = _mm_crc32_u64(crc2, word2);
+        }
+
+        const __m128i crcs = _mm_set_epi64x(
+            static_cast<long long>(crc1), static_cast<long long>(crc0));
+        const __m128i folded0 = _mm_clmulepi64_si128(crcs, shifts, 0x00);
+        const __m128i folded1 = _mm_clmulepi64_si128(crcs, shifts, 0x11);
+        const auto folded = static_cast<std::uint64_t>(
+            _mm_cvtsi128_si64(_mm_xor_si128(folded0, folded1)));
+        crc0 = _mm_crc32_u64(0U, folded) ^ crc2;
+
+        data += block_size;
+        size -= block_size;
+    }
+    return update_crc32c_with_sse42(
+        static_cast<std::uint32_t>(crc0), data, size);
+}
+
+#endif
+
+//! Type of functions to update CRC32C.
+using update_crc32c_function_type = std::uint32_t (*)(
+    std::uint32_t, const unsigned char*, std::size_t) noexcept;
+
+/*!
+ * \brief Select the function to update CRC32C for the current CPU.
+ *
+ * \return Function.
+ */
+[[nodiscard]] inline update_crc32c_function_type
+select_update_crc32c_function() noexcept {
+#if INTERNAL_MSGPACK_LIGHT_HAS_X86_CRC32C
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        if (__builtin_cpu_supports("pclmul")) {
+            return &update_crc32c_with_pclmul;
+        }
+        return &update_crc32c_with_sse42;
+    }
+#endif
+    return &update_crc32c_with_tables;
+}
+
+/*!
+ * \brief Update CRC32C.
+ *
+ * This function uses crc32 instructions in SSE 4.2 and PCLMULQDQ if the CPU
+ * supports them, and tables otherwise. The implementation is selected once
+ * at runtime.
+ *
+ * \param[in] crc Current CRC (without the final inversion).
+ * Use `0xFFFFFFFF` for the initial value.
+ * \param[in] data Pointer to the data.
+ * \param[in] size Size of the data.
+ * \return Updated CRC (without the final inversion).
+ */
+[[nodiscard]] inline std::uint32_t update_crc32c(
+    std::uint32_t crc, const unsigned char* data, std::size_t size) noexcept {
+    static const update_crc32c_function_type function =
+        select_update_crc32c_function();
+    return function(crc, data, size);
+}
+
+/*!
+ * \brief Calculate CRC32C.
+ *
+ * \param[in] data Pointer to the data.
+ * \param[in] size Size of the data.
+ * \return CRC32C.
+ */
+[[nodiscard]] inline std::uint32_t crc32c(
+    const unsigned char* data, std::size_t size) noexcept {
+    constexpr std::uint32_t initial = 0xFFFFFFFFU;
+    return ~update_crc32c(initial, data, size);
+}
+
+}  // namespace msgpack_light::details
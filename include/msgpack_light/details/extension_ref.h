@@ -44,7 +44,7 @@ public:
      *
      * \param[in] data Data.
      */
-    explicit const_extension_ref(const details::extension_data& data)
+    explicit const_extension_ref(const details::object_data& data)
         : data_(&data) {}
 
     /*!
@@ -52,7 +52,7 @@ public:
      *
      * \return Type.
      */
-    [[nodiscard]] std::int8_t type() const { return data_->type; }
+    [[nodiscard]] std::int8_t type() const { return data_->extension_type; }
 
     /*!
      * \brief Get the data of the value.
@@ -60,12 +60,12 @@ public:
      * \return Data.
      */
     [[nodiscard]] binary_view data() const noexcept {
-        return binary_view(data_->data, data_->size);
+        return binary_view(data_->data.extension_value, data_->size);
     }
 
 private:
     //! Data.
-    const details::extension_data* data_;
+    const details::object_data* data_;
 };
 
 }  // namespace msgpack_light
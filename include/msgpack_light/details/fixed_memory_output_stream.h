@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of fixed_memory_output_stream class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light::details {
+
+/*!
+ * \brief Class of streams to write data to a memory region of a fixed size.
+ */
+class fixed_memory_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[out] data Pointer to the memory region.
+     * \param[in] capacity Size of the memory region.
+     *
+     * \warning This class hold the pointer to the given memory region.
+     */
+    fixed_memory_output_stream(unsigned char* data, std::size_t capacity)
+        : data_(data), capacity_(capacity) {}
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        if (size > capacity_ - size_) {
+            throw std::runtime_error(
+                "Data exceeded the size of the memory region.");
+        }
+        if (size > 0U) {
+            std::memcpy(data_ + size_, data, size);
+            size_ += size;
+        }
+    }
+
+    /*!
+     * \brief Get the number of bytes written.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+private:
+    //! Pointer to the memory region.
+    unsigned char* data_;
+
+    //! Size of the memory region.
+    std::size_t capacity_;
+
+    //! Number of bytes written.
+    std::size_t size_{0U};
+};
+
+}  // namespace msgpack_light::details
@@ -0,0 +1,332 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of functions of a LZ77-based compression codec.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace msgpack_light::details {
+
+/*!
+ * \brief Minimum length of matches in lz_compress_block() function.
+ */
+constexpr std::size_t lz_min_match = 4U;
+
+/*!
+ * \brief Maximum offset of matches in lz_compress_block() function.
+ */
+constexpr std::size_t lz_max_offset = 0xFFFFU;
+
+/*!
+ * \brief Number of bits of hashes in lz_compress_block() function.
+ */
+constexpr unsigned int lz_hash_bits = 14U;
+
+/*!
+ * \brief Calculate the maximum size of the compressed data.
+ *
+ * \param[in] size Size of the data to compress.
+ * \return Maximum size of the compressed data.
+ */
+[[nodiscard]] constexpr std::size_t lz_max_compressed_size(
+    std::size_t size) noexcept {
+    constexpr std::size_t length_byte_max = 255U;
+    constexpr std::size_t margin = 16U;
+    return size + size / length_byte_max + margin;
+}
+
+/*!
+ * \brief Calculate the maximum size of the data decompressed from compressed
+ * data.
+ *
+ * Each byte of the compressed data produces at most 255 bytes.
+ *
+ * \param[in] size Size of the compressed data.
+ * \return Maximum size of the decompressed data.
+ */
+[[nodiscard]] constexpr std::size_t lz_max_decompressed_size(
+    std::size_t size) noexcept {
+    constexpr std::size_t length_byte_max = 255U;
+    return size * length_byte_max;
+}
+
+/*!
+ * \brief Read 4 bytes as an integer.
+ *
+ * \param[in] data Pointer to the data.
+ * \return Integer.
+ */
+[[nodiscard]] inline std::uint32_t lz_read32(
+    const unsigned char* data) noexcept {
+    std::uint32_t value = 0U;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+/*!
+ * \brief Calculate the hash of 4 bytes.
+ *
+ * \param[in] value Bytes as an integer.
+ * \return Hash.
+ */
+[[nodiscard]] inline std::uint32_t lz_hash(std::uint32_t value) noexcept {
+    // Multiplicative hashing (golden ratio).
+    constexpr std::uint32_t multiplier = 2654435761U;
+    constexpr unsigned int shift = 32U - lz_hash_bits;
+    return (value * multiplier) >> shift;
+}
+
+/*!
+ * \brief Write a length in the extended format of lengths.
+ *
+ * \param[out] output Pointer to the output.
+ * \param[in] length Length minus 15.
+ * \return Pointer to the next byte of the output.
+ */
+[[nodiscard]] inline unsigned char* lz_write_extended_length(
+    unsigned char* output, std::size_t length) noexcept {
+    constexpr std::size_t length_byte_max = 255U;
+    while (length >= length_byte_max) {
+        *output = static_cast<unsigned char>(length_byte_max);
+        ++output;
+        length -= length_byte_max;
+    }
+    *output = static_cast<unsigned char>(length);
+    ++output;
+    return output;
+}
+
+/*!
+ * \brief Write a sequence of literals and a match.
+ *
+ * \param[out] output Pointer to the output.
+ * \param[in] literals Pointer to the literals.
+ * \param[in] num_literals Number of the literals.
+ * \param[in] offset Offset of the match. (Ignored if match_length is zero.)
+ * \param[in] match_length Length of the match. (Zero for the last sequence.)
+ * \return Pointer to the next byte of the output.
+ */
+[[nodiscard]] inline unsigned char* lz_write_sequence(unsigned char* output,
+    const unsigned char* literals, std::size_t num_literals,
+    std::size_t offset, std::size_t match_length) noexcept {
+    constexpr std::size_t nibble_max = 15U;
+    constexpr unsigned int literal_length_shift = 4U;
+
+    unsigned char* token = output;
+    ++output;
+    const std::size_t match_length_code =
+        (match_length == 0U) ? 0U : match_length - lz_min_match;
+    *token = static_cast<unsigned char>(
+        (std::min(num_literals, nibble_max) << literal_length_shift) |
+        std::min(match_length_code, nibble_max));
+
+    if (num_literals >= nibble_max) {
+        output = lz_write_extended_length(output, num_literals - nibble_max);
+    }
+    std::memcpy(output, literals, num_literals);
+    output += num_literals;
+
+    if (match_length == 0U) {
+        return output;
+    }
+    constexpr unsigned int bits_per_byte = 8U;
+    constexpr std::size_t byte_mask = 0xFFU;
+    output[0] = static_cast<unsigned char>(offset & byte_mask);
+    output[1] =
+        static_cast<unsigned char>((offset >> bits_per_byte) & byte_mask);
+    output += 2;
+    if (match_length_code >= nibble_max) {
+        output =
+            lz_write_extended_length(output, match_length_code - nibble_max);
+    }
+    return output;
+}
+
+/*!
+ * \brief Compress a block of data.
+ *
+ * The format of the compressed data is the same as the block format of LZ4:
+ * a list of sequences each of which has a token, literals, and a match, and
+ * the last sequence has literals only.
+ *
+ * \param[in] input Pointer to the data to compress.
+ * \param[in] input_size Size of the data to compress.
+ * \param[out] output Pointer to the buffer of the compressed data.
+ * The size of this buffer must be at least
+ * `lz_max_compressed_size(input_size)`.
+ * \param[in,out] hash_table Buffer used as the hash table.
+ * \return Size of the compressed data.
+ */
+[[nodiscard]] inline std::size_t lz_compress_block(const unsigned char* input,
+    std::size_t input_size, unsigned char* output,
+    std::vector<std::uint32_t>& hash_table) {
+    // Rules of the format to allow fast decoding.
+    constexpr std::size_t last_literals = 5U;
+    constexpr std::size_t match_find_limit = 12U;
+
+    hash_table.assign(static_cast<std::size_t>(1U) << lz_hash_bits, 0U);
+
+    unsigned char* const output_begin = output;
+    std::size_t anchor = 0U;
+    if (input_size > match_find_limit) {
+        const std::size_t match_start_limit = input_size - match_find_limit;
+        const std::size_t match_end_limit = input_size - last_literals;
+        std::size_t position = 0U;
+        while (position < match_start_limit) {
+            const std::uint32_t sequence = lz_read32(input + position);
+            std::uint32_t& entry = hash_table[lz_hash(sequence)];
+            const std::size_t candidate = entry;
+            entry = static_cast<std::uint32_t>(position);
+            if (candidate >= position ||
+                position - candidate > lz_max_offset ||
+                lz_read32(input + candidate) != sequence) {
+                ++position;
+                continue;
+            }
+
+            std::size_t match_length = lz_min_match;
+            while (position + match_length < match_end_limit &&
+                input[candidate + match_length] ==
+                    input[position + match_length]) {
+                ++match_length;
+            }
+            output = lz_write_sequence(output, input + anchor,
+                position - anchor, position - candidate, match_length);
+            position += match_length;
+            anchor = position;
+        }
+    }
+    output = lz_write_sequence(
+        output, input + anchor, input_size - anchor, 0U, 0U);
+    return static_cast<std::size_t>(output - output_begin);
+}
+
+/*!
+ * \brief Read a length in the extended format of lengths.
+ *
+ * \param[in] input Pointer to the input.
+ * \param[in] input_size Size of the input.
+ * \param[in,out] position Position in the input.
+ * \return Length minus 15.
+ */
+[[nodiscard]] inline std::size_t lz_read_extended_length(
+    const unsigned char* input, std::size_t input_size,
+    std::size_t& position) {
+    constexpr std::size_t length_byte_max = 255U;
+    std::size_t length = 0U;
+    while (true) {
+        if (position >= input_size) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        const auto byte = static_cast<std::size_t>(input[position]);
+        ++position;
+        length += byte;
+        if (byte != length_byte_max) {
+            return length;
+        }
+    }
+}
+
+/*!
+ * \brief Decompress a block of data compressed using lz_compress_block()
+ * function.
+ *
+ * \note This function throws exceptions for invalid data.
+ *
+ * \param[in] input Pointer to the compressed data.
+ * \param[in] input_size Size of the compressed data.
+ * \param[out] output Pointer to the buffer of the decompressed data.
+ * \param[in] output_size Size of the decompressed data.
+ */
+inline void lz_decompress_block(const unsigned char* input,
+    std::size_t input_size, unsigned char* output, std::size_t output_size) {
+    constexpr std::size_t nibble_max = 15U;
+    constexpr unsigned int literal_length_shift = 4U;
+    constexpr unsigned int bits_per_byte = 8U;
+
+    std::size_t input_position = 0U;
+    std::size_t output_position = 0U;
+    while (true) {
+        if (input_position >= input_size) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        const unsigned char token = input[input_position];
+        ++input_position;
+
+        std::size_t num_literals =
+            static_cast<std::size_t>(token) >> literal_length_shift;
+        if (num_literals == nibble_max) {
+            num_literals +=
+                lz_read_extended_length(input, input_size, input_position);
+        }
+        if (num_literals > input_size - input_position ||
+            num_literals > output_size - output_position) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        std::memcpy(output + output_position, input + input_position,
+            num_literals);
+        input_position += num_literals;
+        output_position += num_literals;
+
+        if (input_position == input_size) {
+            break;
+        }
+
+        constexpr std::size_t offset_size = 2U;
+        if (input_size - input_position < offset_size) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        const std::size_t offset =
+            static_cast<std::size_t>(input[input_position]) |
+            (static_cast<std::size_t>(input[input_position + 1U])
+                << bits_per_byte);
+        input_position += offset_size;
+        if (offset == 0U || offset > output_position) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+
+        std::size_t match_length =
+            static_cast<std::size_t>(token) & nibble_max;
+        if (match_length == nibble_max) {
+            match_length +=
+                lz_read_extended_length(input, input_size, input_position);
+        }
+        match_length += lz_min_match;
+        if (match_length > output_size - output_position) {
+            throw std::runtime_error("Invalid compressed data.");
+        }
+        // Matches can overlap with the output, so copy bytes one by one.
+        const std::size_t match_position = output_position - offset;
+        for (std::size_t i = 0; i < match_length; ++i) {
+            output[output_position + i] = output[match_position + i];
+        }
+        output_position += match_length;
+    }
+
+    if (output_position != output_size) {
+        throw std::runtime_error("Invalid compressed data.");
+    }
+}
+
+}  // namespace msgpack_light::details
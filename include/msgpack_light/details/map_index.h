@@ -0,0 +1,424 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of functions of hash indices of keys in maps.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include "msgpack_light/details/allocator_wrapper.h"
+#include "msgpack_light/details/object_data.h"
+#include "msgpack_light/object_data_type.h"
+
+namespace msgpack_light::details {
+
+/*!
+ * \brief Minimum number of key-value pairs in maps to use hash indices.
+ *
+ * Keys in smaller maps are searched linearly.
+ */
+constexpr std::size_t map_index_min_size = 16U;
+
+/*!
+ * \brief Mix bits of a hash value.
+ *
+ * \param[in] value Value.
+ * \return Mixed value.
+ */
+[[nodiscard]] constexpr std::uint64_t mix_hash_bits(
+    std::uint64_t value) noexcept {
+    // Finalizer of SplitMix64.
+    constexpr std::uint64_t multiplier1 = 0xBF58476D1CE4E5B9U;
+    constexpr std::uint64_t multiplier2 = 0x94D049BB133111EBU;
+    constexpr unsigned int shift1 = 30U;
+    constexpr unsigned int shift2 = 27U;
+    constexpr unsigned int shift3 = 31U;
+    value ^= value >> shift1;
+    value *= multiplier1;
+    value ^= value >> shift2;
+    value *= multiplier2;
+    value ^= value >> shift3;
+    return value;
+}
+
+/*!
+ * \brief Class of keys to search in maps.
+ *
+ * Strings and integers are supported. Integers are compared by their values
+ * regardless of the types (signed or unsigned) in which they are stored.
+ */
+class map_lookup_key {
+public:
+    /*!
+     * \brief Constructor of a key of a string.
+     *
+     * \param[in] value Value.
+     */
+    explicit map_lookup_key(std::string_view value) noexcept
+        : type_(object_data_type::string), string_(value) {}
+
+    /*!
+     * \brief Constructor of a key of an unsigned integer.
+     *
+     * \param[in] value Value.
+     */
+    explicit map_lookup_key(std::uint64_t value) noexcept
+        : type_(object_data_type::unsigned_integer), integer_(value) {}
+
+    /*!
+     * \brief Constructor of a key of a signed integer.
+     *
+     * \param[in] value Value.
+     */
+    explicit map_lookup_key(std::int64_t value) noexcept
+        : type_(value < 0 ? object_data_type::signed_integer
+                          : object_data_type::unsigned_integer),
+          integer_(static_cast<std::uint64_t>(value)) {}
+
+    /*!
+     * \brief Create a key from data of a key in a map.
+     *
+     * \param[in] data Data of the key.
+     * \param[out] key Created key.
+     * \retval true Key was created.
+     * \retval false Type of the data is not supported.
+     */
+    [[nodiscard]] static bool from_object_data(
+        const object_data& data, map_lookup_key& key) noexcept {
+        switch (data.type) {
+        case object_data_type::string:
+            key = map_lookup_key(get_string_of(data));
+            return true;
+        case object_data_type::unsigned_integer:
+            key = map_lookup_key(data.data.unsigned_integer_value);
+            return true;
+        case object_data_type::signed_integer:
+            key = map_lookup_key(data.data.signed_integer_value);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /*!
+     * \brief Calculate the hash value.
+     *
+     * \return Hash value.
+     */
+    [[nodiscard]] std::uint64_t hash() const noexcept {
+        if (type_ != object_data_type::string) {
+            return mix_hash_bits(integer_);
+        }
+        // FNV-1a.
+        constexpr std::uint64_t offset_basis = 0xCBF29CE484222325U;
+        constexpr std::uint64_t prime = 0x100000001B3U;
+        std::uint64_t value = offset_basis;
+        for (const char c : string_) {
+            value ^= static_cast<unsigned char>(c);
+            value *= prime;
+        }
+        return mix_hash_bits(value);
+    }
+
+    /*!
+     * \brief Check whether data of a key in a map equals to this key.
+     *
+     * \param[in] data Data of the key.
+     * \return Whether the data equals to this key.
+     */
+    [[nodiscard]] bool matches(const object_data& data) const noexcept {
+        switch (type_) {
+        case object_data_type::string:
+            return data.type == object_data_type::string &&
+                get_string_of(data) == string_;
+        case object_data_type::unsigned_integer:
+            if (data.type == object_data_type::unsigned_integer) {
+                return data.data.unsigned_integer_value == integer_;
+            }
+            return data.type == object_data_type::signed_integer &&
+                data.data.signed_integer_value >= 0 &&
+                static_cast<std::uint64_t>(data.data.signed_integer_value) ==
+                integer_;
+        default:
+            return data.type == object_data_type::signed_integer &&
+                static_cast<std::uint64_t>(data.data.signed_integer_value) ==
+                integer_;
+        }
+    }
+
+private:
+    //! Type. (signed_integer is used only for negative integers.)
+    object_data_type type_;
+
+    //! String.
+    std::string_view string_{};
+
+    //! Integer.
+    std::uint64_t integer_{0U};
+};
+
+/*!
+ * \brief Check whether a type is an integer usable as keys to search in maps.
+ *
+ * \tparam T Type to check.
+ */
+template <typename T>
+constexpr bool is_map_lookup_integer_v =
+    std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+/*!
+ * \brief Create a key of an integer to search in maps.
+ *
+ * \tparam Integer Type of the integer.
+ * \param[in] value Value.
+ * \return Key.
+ */
+template <typename Integer>
+[[nodiscard]] map_lookup_key make_map_lookup_key(Integer value) noexcept {
+    static_assert(is_map_lookup_integer_v<Integer>);
+    if constexpr (std::is_signed_v<Integer>) {
+        return map_lookup_key(static_cast<std::int64_t>(value));
+    } else {
+        return map_lookup_key(static_cast<std::uint64_t>(value));
+    }
+}
+
+/*!
+ * \brief Get slots of a hash index.
+ *
+ * \param[in] index Index.
+ * \return Pointer to the slots.
+ */
+[[nodiscard]] inline std::uint64_t* get_map_index_slots(
+    map_index* index) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<std::uint64_t*>(index + 1);
+}
+
+/*!
+ * \brief Get slots of a hash index.
+ *
+ * \param[in] index Index.
+ * \return Pointer to the slots.
+ */
+[[nodiscard]] inline const std::uint64_t* get_map_index_slots(
+    const map_index* index) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<const std::uint64_t*>(index + 1);
+}
+
+/*!
+ * \brief Add a key to slots of a hash index.
+ *
+ * \param[in,out] index Index.
+ * \param[in] key Data of the key.
+ * \param[in] position Index of the key-value pair.
+ */
+inline void add_to_map_index_slots(
+    map_index& index, const object_data& key, std::size_t position) noexcept {
+    map_lookup_key lookup_key{std::uint64_t{0}};
+    if (!map_lookup_key::from_object_data(key, lookup_key)) {
+        return;
+    }
+    constexpr unsigned int tag_shift = 32U;
+    std::uint64_t* slots = get_map_index_slots(&index);
+    const std::size_t mask = index.num_slots - 1U;
+    const std::uint64_t hash = lookup_key.hash();
+    std::size_t slot = static_cast<std::size_t>(hash) & mask;
+    while (slots[slot] != 0U) {
+        slot = (slot + 1U) & mask;
+    }
+    slots[slot] = ((hash >> tag_shift) << tag_shift) |
+        static_cast<std::uint64_t>(position + 1U);
+}
+
+/*!
+ * \brief Check whether a map can use a hash index.
+ *
+ * \param[in] data Data of the map.
+ * \return Whether the map can use a hash index.
+ */
+[[nodiscard]] inline bool is_map_indexable(const object_data& data) noexcept {
+    return data.size >= map_index_min_size &&
+        data.size < std::numeric_limits<std::uint32_t>::max();
+}
+
+/*!
+ * \brief Mark the hash index of a map invalid.
+ *
+ * \param[in] data Data of the map.
+ */
+inline void invalidate_map_index(object_data& data) noexcept {
+    map_index* index = get_map_header(data.data.map_value)->index;
+    if (index != nullptr) {
+        index->is_valid = false;
+    }
+}
+
+/*!
+ * \brief Build the hash index of a map if needed.
+ *
+ * \tparam Allocator Type of the allocator.
+ * \param[in,out] data Data of the map.
+ * \param[in] allocator Allocator.
+ */
+template <typename Allocator>
+inline void prepare_map_index(
+    object_data& data, allocator_wrapper<Allocator>& allocator) {
+    if (!is_map_indexable(data)) {
+        return;
+    }
+    map_header* header = get_map_header(data.data.map_value);
+    if (header->index != nullptr && header->index->is_valid) {
+        return;
+    }
+
+    // Use at most half of slots.
+    std::size_t num_slots = 1U;
+    while (num_slots < data.size * 2U) {
+        num_slots <<= 1U;
+    }
+    if (header->index != nullptr && header->index->num_slots != num_slots) {
+        allocator.deallocate_map_index(header->index);
+        header->index = nullptr;
+    }
+    if (header->index == nullptr) {
+        header->index = allocator.allocate_map_index(num_slots);
+    }
+
+    map_index* index = header->index;
+    std::memset(get_map_index_slots(index), 0,
+        num_slots * sizeof(std::uint64_t));
+    for (std::size_t i = 0; i < data.size; ++i) {
+        add_to_map_index_slots(*index, data.data.map_value[i].key, i);
+    }
+    index->is_valid = true;
+}
+
+/*!
+ * \brief Add a key-value pair appended to a map to the hash index.
+ *
+ * The index is marked invalid if it has no space for the pair.
+ *
+ * \param[in,out] data Data of the map. (Including the appended pair.)
+ * \param[in] position Index of the appended pair.
+ */
+inline void add_to_map_index(object_data& data, std::size_t position) noexcept {
+    map_index* index = get_map_header(data.data.map_value)->index;
+    if (index == nullptr || !index->is_valid) {
+        return;
+    }
+    if (!is_map_indexable(data) || data.size * 2U > index->num_slots) {
+        index->is_valid = false;
+        return;
+    }
+    add_to_map_index_slots(
+        *index, data.data.map_value[position].key, position);
+}
+
+/*!
+ * \brief Build hash indices of maps in an object recursively.
+ *
+ * \tparam Allocator Type of the allocator.
+ * \param[in,out] data Data of the object.
+ * \param[in] allocator Allocator.
+ */
+template <typename Allocator>
+inline void build_map_indices(
+    object_data& data, allocator_wrapper<Allocator>& allocator) {
+    switch (data.type) {
+    case object_data_type::array:
+        for (std::size_t i = 0; i < data.size; ++i) {
+            build_map_indices(data.data.array_value[i], allocator);
+        }
+        break;
+    case object_data_type::map:
+        for (std::size_t i = 0; i < data.size; ++i) {
+            build_map_indices(data.data.map_value[i].key, allocator);
+            build_map_indices(data.data.map_value[i].value, allocator);
+        }
+        prepare_map_index(data, allocator);
+        break;
+    default:
+        break;
+    }
+}
+
+/*!
+ * \brief Check whether a map has a hash index usable in searches.
+ *
+ * \param[in] data Data of the map.
+ * \return Whether the map has a usable hash index.
+ */
+[[nodiscard]] inline bool has_usable_map_index(
+    const object_data& data) noexcept {
+    const map_index* index = get_map_header(data.data.map_value)->index;
+    return index != nullptr && index->is_valid && is_map_indexable(data);
+}
+
+/*!
+ * \brief Search a key in a map.
+ *
+ * The hash index is used if it has been built and is valid.
+ * Otherwise, keys are searched linearly.
+ *
+ * \param[in] data Data of the map.
+ * \param[in] key Key.
+ * \return Index of the first key-value pair with the key,
+ * or the size of the map if not found.
+ */
+[[nodiscard]] inline std::size_t find_in_map(
+    const object_data& data, const map_lookup_key& key) noexcept {
+    if (!has_usable_map_index(data)) {
+        for (std::size_t i = 0; i < data.size; ++i) {
+            if (key.matches(data.data.map_value[i].key)) {
+                return i;
+            }
+        }
+        return data.size;
+    }
+
+    constexpr unsigned int tag_shift = 32U;
+    constexpr std::uint64_t position_mask = 0xFFFFFFFFU;
+    const map_index* index = get_map_header(data.data.map_value)->index;
+    const std::uint64_t* slots = get_map_index_slots(index);
+    const std::size_t mask = index->num_slots - 1U;
+    const std::uint64_t hash = key.hash();
+    const std::uint64_t tag = hash >> tag_shift;
+    std::size_t slot = static_cast<std::size_t>(hash) & mask;
+    while (slots[slot] != 0U) {
+        const std::uint64_t value = slots[slot];
+        if ((value >> tag_shift) == tag) {
+            const auto position =
+                static_cast<std::size_t>(value & position_mask) - 1U;
+            if (position < data.size &&
+                key.matches(data.data.map_value[position].key)) {
+                return position;
+            }
+        }
+        slot = (slot + 1U) & mask;
+    }
+    return data.size;
+}
+
+}  // namespace msgpack_light::details
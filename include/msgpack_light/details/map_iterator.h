@@ -20,6 +20,7 @@
 #pragma once
 
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
 #include "msgpack_light/details/allocator_wrapper.h"
@@ -33,6 +34,7 @@ namespace msgpack_light {
  * \brief Class of iterators of maps to access non-constant objects.
  *
  * \tparam Allocator Type of the allocator.
+ * \tparam IsKeyMutable Whether keys can be modified through this iterator.
  *
  * \note Instances of this class can be created from
  * msgpack_light::mutable_map_ref class.
@@ -41,15 +43,18 @@ namespace msgpack_light {
  * class, do not call functions in this class without msgpack_light::object
  * instances holding the data.
  */
-template <typename Allocator = standard_allocator>
+template <typename Allocator = standard_allocator, bool IsKeyMutable = true>
 class mutable_map_iterator {
 public:
     //! Type of differences.
     using difference_type = std::ptrdiff_t;
 
+    //! Type to access keys.
+    using key_ref_type = std::conditional_t<IsKeyMutable,
+        mutable_object_ref<Allocator>, const_object_ref>;
+
     //! Type of values.
-    using value_type =
-        std::pair<mutable_object_ref<Allocator>, mutable_object_ref<Allocator>>;
+    using value_type = std::pair<key_ref_type, mutable_object_ref<Allocator>>;
 
     //! Type of references.
     using reference = value_type;
@@ -74,8 +79,7 @@ public:
      *
      * \return References to the current key and value.
      */
-    std::pair<mutable_object_ref<Allocator>, mutable_object_ref<Allocator>>
-    operator*() const noexcept;
+    value_type operator*() const noexcept;
 
     /*!
      * \brief Increment this iterator.
@@ -99,6 +103,17 @@ public:
         return copy;
     }
 
+    /*!
+     * \brief Get the pointer to the current data.
+     *
+     * \warning This function is for internal implementation of this library.
+     *
+     * \return Pointer.
+     */
+    [[nodiscard]] details::key_value_pair_data* pointer() const noexcept {
+        return pointer_;
+    }
+
 private:
     //! Pointer to the current data.
     details::key_value_pair_data* pointer_;
@@ -107,6 +122,19 @@ private:
     details::allocator_wrapper<Allocator>* allocator_;
 };
 
+/*!
+ * \brief Type of iterators of maps to access non-constant values
+ * with constant keys.
+ *
+ * \tparam Allocator Type of the allocator.
+ *
+ * \note find and insert functions in msgpack_light::mutable_map_ref class
+ * return iterators of this type so that keys in hash indices of maps
+ * are not modified.
+ */
+template <typename Allocator = standard_allocator>
+using mutable_map_value_iterator = mutable_map_iterator<Allocator, false>;
+
 /*!
  * \brief Class of iterators of maps to access constant objects.
  *
@@ -31,40 +31,51 @@ namespace msgpack_light {
  * Definition of some members of mutable_map_iterator.
  */
 
-template <typename Allocator>
-inline std::pair<mutable_object_ref<Allocator>, mutable_object_ref<Allocator>>
-mutable_map_iterator<Allocator>::operator*() const noexcept {
-    return {mutable_object_ref<Allocator>(pointer_->key, *allocator_),
-        mutable_object_ref<Allocator>(pointer_->value, *allocator_)};
+template <typename Allocator, bool IsKeyMutable>
+inline typename mutable_map_iterator<Allocator, IsKeyMutable>::value_type
+mutable_map_iterator<Allocator, IsKeyMutable>::operator*() const noexcept {
+    if constexpr (IsKeyMutable) {
+        return {mutable_object_ref<Allocator>(pointer_->key, *allocator_),
+            mutable_object_ref<Allocator>(pointer_->value, *allocator_)};
+    } else {
+        return {const_object_ref{pointer_->key},
+            mutable_object_ref<Allocator>(pointer_->value, *allocator_)};
+    }
 }
 
 /*!
  * \brief Compare two iterators.
  *
  * \tparam Allocator Type of the allocator.
+ * \tparam IsLhsKeyMutable Whether keys can be modified through lhs.
+ * \tparam IsRhsKeyMutable Whether keys can be modified through rhs.
  * \param[in] lhs Light-hand-side instance.
  * \param[in] rhs Right-hand-side instance.
  * \retval true Two instances are equal.
  * \retval false Two instances are not equal.
  */
-template <typename Allocator>
-[[nodiscard]] inline bool operator==(mutable_map_iterator<Allocator> lhs,
-    mutable_map_iterator<Allocator> rhs) noexcept {
-    return &(*lhs).first.data() == &(*rhs).first.data();
+template <typename Allocator, bool IsLhsKeyMutable, bool IsRhsKeyMutable>
+[[nodiscard]] inline bool operator==(
+    mutable_map_iterator<Allocator, IsLhsKeyMutable> lhs,
+    mutable_map_iterator<Allocator, IsRhsKeyMutable> rhs) noexcept {
+    return lhs.pointer() == rhs.pointer();
 }
 
 /*!
  * \brief Compare two iterators.
  *
  * \tparam Allocator Type of the allocator.
+ * \tparam IsLhsKeyMutable Whether keys can be modified through lhs.
+ * \tparam IsRhsKeyMutable Whether keys can be modified through rhs.
  * \param[in] lhs Light-hand-side instance.
  * \param[in] rhs Right-hand-side instance.
  * \retval true Two instances are not equal.
  * \retval false Two instances are equal.
  */
-template <typename Allocator>
-[[nodiscard]] inline bool operator!=(mutable_map_iterator<Allocator> lhs,
-    mutable_map_iterator<Allocator> rhs) noexcept {
+template <typename Allocator, bool IsLhsKeyMutable, bool IsRhsKeyMutable>
+[[nodiscard]] inline bool operator!=(
+    mutable_map_iterator<Allocator, IsLhsKeyMutable> lhs,
+    mutable_map_iterator<Allocator, IsRhsKeyMutable> rhs) noexcept {
     return !(lhs == rhs);
 }
 
@@ -20,10 +20,17 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include "msgpack_light/details/allocator_wrapper.h"
+#include "msgpack_light/details/map_index.h"
 #include "msgpack_light/details/map_iterator.h"
 #include "msgpack_light/details/object_data.h"
+#include "msgpack_light/details/object_helper.h"
 #include "msgpack_light/details/object_ref_decl.h"  // IWYU pragma: keep
 #include "msgpack_light/standard_allocator.h"
 
@@ -56,7 +63,7 @@ public:
      *
      * \param[in] data Data.
      */
-    explicit const_map_ref(const details::map_data& data) : data_(&data) {}
+    explicit const_map_ref(const details::object_data& data) : data_(&data) {}
 
     /*!
      * \brief Get the size.
@@ -87,7 +94,7 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_map_iterator begin() const noexcept {
-        return const_map_iterator{data_->data};
+        return const_map_iterator{data_->data.map_value};
     }
 
     /*!
@@ -96,12 +103,67 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_map_iterator end() const noexcept {
-        return const_map_iterator{data_->data + data_->size};
+        return const_map_iterator{data_->data.map_value + data_->size};
+    }
+
+    /*!
+     * \brief Find a key-value pair with a key of a string.
+     *
+     * \param[in] key Key.
+     * \return Iterator to the first key-value pair with the key,
+     * or end() if not found.
+     *
+     * \note This function uses the hash index of keys if it has been built
+     * by msgpack_light::mutable_map_ref::find function or build_index
+     * function of objects. Otherwise, keys are searched linearly.
+     */
+    [[nodiscard]] const_map_iterator find(std::string_view key) const noexcept {
+        return find_impl(details::map_lookup_key(key));
+    }
+
+    /*!
+     * \brief Find a key-value pair with a key of an integer.
+     *
+     * \tparam Integer Type of the integer.
+     * \param[in] key Key.
+     * \return Iterator to the first key-value pair with the key,
+     * or end() if not found.
+     *
+     * \note Integers are compared by their values regardless of the types
+     * (signed or unsigned) in which they are stored.
+     */
+    template <typename Integer,
+        std::enable_if_t<details::is_map_lookup_integer_v<Integer>,
+            std::nullptr_t> = nullptr>
+    [[nodiscard]] const_map_iterator find(Integer key) const noexcept {
+        return find_impl(details::make_map_lookup_key(key));
+    }
+
+    /*!
+     * \brief Check whether find functions use the hash index of keys.
+     *
+     * \retval true The hash index is used.
+     * \retval false Keys are searched linearly.
+     */
+    [[nodiscard]] bool is_indexed() const noexcept {
+        return details::has_usable_map_index(*data_);
     }
 
 private:
+    /*!
+     * \brief Find a key-value pair.
+     *
+     * \param[in] key Key.
+     * \return Iterator.
+     */
+    [[nodiscard]] const_map_iterator find_impl(
+        const details::map_lookup_key& key) const noexcept {
+        return const_map_iterator{
+            data_->data.map_value + details::find_in_map(*data_, key)};
+    }
+
     //! Data.
-    const details::map_data* data_;
+    const details::object_data* data_;
 };
 
 /*!
@@ -112,6 +174,16 @@ private:
  * \note Instances of this class can be created from
  * msgpack_light::object, msgpack_light::mutable_object_ref classes.
  *
+ * \note find functions build a hash index of keys for large maps.
+ * The index is marked invalid when keys become modifiable
+ * via key function or iterators from begin function,
+ * and rebuilt in the next call of find functions.
+ * Iterators returned from find and insert functions do not allow
+ * modification of keys.
+ *
+ * \warning Keys must not be modified through references obtained before
+ * the last call of find functions, or the index can miss the keys.
+ *
  * \warning This class only holds pointers to data in msgpack_light::object
  * class, do not call functions in this class without msgpack_light::object
  * instances holding the data.
@@ -140,7 +212,7 @@ public:
      * \param[in] data Data.
      * \param[in] allocator Allocator.
      */
-    mutable_map_ref(details::map_data& data,
+    mutable_map_ref(details::object_data& data,
         details::allocator_wrapper<Allocator>& allocator)
         : data_(&data), allocator_(&allocator) {}
 
@@ -189,7 +261,9 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] mutable_map_iterator<Allocator> begin() noexcept {
-        return mutable_map_iterator<Allocator>{data_->data, allocator_};
+        details::invalidate_map_index(*data_);
+        return mutable_map_iterator<Allocator>{
+            data_->data.map_value, allocator_};
     }
 
     /*!
@@ -199,7 +273,7 @@ public:
      */
     [[nodiscard]] mutable_map_iterator<Allocator> end() noexcept {
         return mutable_map_iterator<Allocator>{
-            data_->data + data_->size, allocator_};
+            data_->data.map_value + data_->size, allocator_};
     }
 
     /*!
@@ -208,7 +282,7 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_map_iterator begin() const noexcept {
-        return const_map_iterator{data_->data};
+        return const_map_iterator{data_->data.map_value};
     }
 
     /*!
@@ -217,12 +291,251 @@ public:
      * \return Iterator.
      */
     [[nodiscard]] const_map_iterator end() const noexcept {
-        return const_map_iterator{data_->data + data_->size};
+        return const_map_iterator{data_->data.map_value + data_->size};
+    }
+
+    /*!
+     * \brief Find a key-value pair with a key of a string.
+     *
+     * \param[in] key Key.
+     * \return Iterator to the first key-value pair with the key,
+     * or end() if not found.
+     */
+    [[nodiscard]] mutable_map_value_iterator<Allocator> find(
+        std::string_view key) {
+        return find_impl(details::map_lookup_key(key));
+    }
+
+    /*!
+     * \brief Find a key-value pair with a key of an integer.
+     *
+     * \tparam Integer Type of the integer.
+     * \param[in] key Key.
+     * \return Iterator to the first key-value pair with the key,
+     * or end() if not found.
+     *
+     * \note Integers are compared by their values regardless of the types
+     * (signed or unsigned) in which they are stored.
+     */
+    template <typename Integer,
+        std::enable_if_t<details::is_map_lookup_integer_v<Integer>,
+            std::nullptr_t> = nullptr>
+    [[nodiscard]] mutable_map_value_iterator<Allocator> find(Integer key) {
+        return find_impl(details::make_map_lookup_key(key));
+    }
+
+    /*!
+     * \brief Find a key-value pair with a key of a string.
+     *
+     * \param[in] key Key.
+     * \return Iterator to the first key-value pair with the key,
+     * or end() if not found.
+     */
+    [[nodiscard]] const_map_iterator find(std::string_view key) const noexcept {
+        return const_map_ref(*data_).find(key);
+    }
+
+    /*!
+     * \brief Find a key-value pair with a key of an integer.
+     *
+     * \tparam Integer Type of the integer.
+     * \param[in] key Key.
+     * \return Iterator to the first key-value pair with the key,
+     * or end() if not found.
+     */
+    template <typename Integer,
+        std::enable_if_t<details::is_map_lookup_integer_v<Integer>,
+            std::nullptr_t> = nullptr>
+    [[nodiscard]] const_map_iterator find(Integer key) const noexcept {
+        return const_map_ref(*data_).find(key);
+    }
+
+    /*!
+     * \brief Check whether find functions use the hash index of keys.
+     *
+     * \retval true The hash index is used.
+     * \retval false Keys are searched linearly.
+     */
+    [[nodiscard]] bool is_indexed() const noexcept {
+        return details::has_usable_map_index(*data_);
+    }
+
+    /*!
+     * \brief Get the number of key-value pairs which can be stored without
+     * reallocation.
+     *
+     * \return Capacity.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return details::get_map_header(data_->data.map_value)->capacity;
+    }
+
+    /*!
+     * \brief Reserve memory for key-value pairs.
+     *
+     * \param[in] capacity Number of key-value pairs.
+     */
+    void reserve(std::size_t capacity) {
+        if (capacity > this->capacity()) {
+            details::check_object_data_size(capacity);
+            details::reallocate_map_data(*data_, capacity, *allocator_);
+        }
+    }
+
+    /*!
+     * \brief Add a key-value pair of nil to the end.
+     *
+     * \return Iterator to the added key-value pair.
+     *
+     * \note This function does not check duplicate keys.
+     *
+     * \warning References to key-value pairs are invalidated
+     * when memory is reallocated.
+     */
+    mutable_map_iterator<Allocator> emplace_back();
+
+    /*!
+     * \brief Insert a key of a string with a value of nil
+     * if the key does not exist.
+     *
+     * \param[in] key Key.
+     * \return Iterator to the key-value pair with the key,
+     * and whether the key-value pair was inserted.
+     *
+     * \warning References to key-value pairs are invalidated
+     * when memory is reallocated.
+     */
+    std::pair<mutable_map_value_iterator<Allocator>, bool> insert(
+        std::string_view key);
+
+    /*!
+     * \brief Insert a key of an integer with a value of nil
+     * if the key does not exist.
+     *
+     * \tparam Integer Type of the integer.
+     * \param[in] key Key.
+     * \return Iterator to the key-value pair with the key,
+     * and whether the key-value pair was inserted.
+     *
+     * \warning References to key-value pairs are invalidated
+     * when memory is reallocated.
+     */
+    template <typename Integer,
+        std::enable_if_t<details::is_map_lookup_integer_v<Integer>,
+            std::nullptr_t> = nullptr>
+    std::pair<mutable_map_value_iterator<Allocator>, bool> insert(
+        Integer key);
+
+    /*!
+     * \brief Erase a key-value pair.
+     *
+     * Order of the remaining key-value pairs is kept.
+     *
+     * \tparam IsKeyMutable Whether keys can be modified through the iterator.
+     * \param[in] position Iterator to the key-value pair.
+     * \return Iterator to the key-value pair following the erased one.
+     */
+    template <bool IsKeyMutable>
+    mutable_map_iterator<Allocator> erase(
+        mutable_map_iterator<Allocator, IsKeyMutable> position) noexcept {
+        details::key_value_pair_data* pairs = data_->data.map_value;
+        const auto index = static_cast<std::size_t>(position.pointer() - pairs);
+        details::clear_object_data(pairs[index].key, *allocator_);
+        details::clear_object_data(pairs[index].value, *allocator_);
+        std::memmove(pairs + index, pairs + index + 1U,
+            (size() - index - 1U) * sizeof(details::key_value_pair_data));
+        --data_->size;
+        details::invalidate_map_index(*data_);
+        return mutable_map_iterator<Allocator>{pairs + index, allocator_};
+    }
+
+    /*!
+     * \brief Erase key-value pairs with a key of a string.
+     *
+     * \param[in] key Key.
+     * \return Number of erased key-value pairs.
+     */
+    std::size_t erase(std::string_view key) noexcept {
+        return erase_impl(details::map_lookup_key(key));
+    }
+
+    /*!
+     * \brief Erase key-value pairs with a key of an integer.
+     *
+     * \tparam Integer Type of the integer.
+     * \param[in] key Key.
+     * \return Number of erased key-value pairs.
+     */
+    template <typename Integer,
+        std::enable_if_t<details::is_map_lookup_integer_v<Integer>,
+            std::nullptr_t> = nullptr>
+    std::size_t erase(Integer key) noexcept {
+        return erase_impl(details::make_map_lookup_key(key));
     }
 
 private:
+    /*!
+     * \brief Prepare a key-value pair of nil after the last one.
+     *
+     * \return Key-value pair. (Not counted in the size yet.)
+     */
+    details::key_value_pair_data& prepare_back() {
+        if (data_->size == capacity()) {
+            details::check_object_data_size(size() + 1U);
+            details::reallocate_map_data(*data_,
+                details::grown_capacity(capacity(), size() + 1U),
+                *allocator_);
+        }
+        details::key_value_pair_data& pair = data_->data.map_value[data_->size];
+        details::fill_with_nil(&pair, 1U);
+        return pair;
+    }
+
+    /*!
+     * \brief Erase key-value pairs.
+     *
+     * \param[in] key Key.
+     * \return Number of erased key-value pairs.
+     */
+    std::size_t erase_impl(const details::map_lookup_key& key) noexcept {
+        std::size_t num_kept = 0;
+        for (std::size_t i = 0; i < data_->size; ++i) {
+            details::key_value_pair_data& pair = data_->data.map_value[i];
+            if (key.matches(pair.key)) {
+                details::clear_object_data(pair.key, *allocator_);
+                details::clear_object_data(pair.value, *allocator_);
+                continue;
+            }
+            if (num_kept != i) {
+                std::memcpy(
+                    &data_->data.map_value[num_kept], &pair, sizeof(pair));
+            }
+            ++num_kept;
+        }
+        const std::size_t num_erased = data_->size - num_kept;
+        data_->size = static_cast<std::uint32_t>(num_kept);
+        if (num_erased > 0U) {
+            details::invalidate_map_index(*data_);
+        }
+        return num_erased;
+    }
+
+    /*!
+     * \brief Find a key-value pair.
+     *
+     * \param[in] key Key.
+     * \return Iterator.
+     */
+    [[nodiscard]] mutable_map_value_iterator<Allocator> find_impl(
+        const details::map_lookup_key& key) {
+        details::prepare_map_index(*data_, *allocator_);
+        return mutable_map_value_iterator<Allocator>{
+            data_->data.map_value + details::find_in_map(*data_, key),
+            allocator_};
+    }
+
     //! Data.
-    details::map_data* data_;
+    details::object_data* data_;
 
     //! Allocator.
     details::allocator_wrapper<Allocator>* allocator_;
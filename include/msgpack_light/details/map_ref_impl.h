@@ -19,8 +19,14 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
+#include "msgpack_light/details/map_index.h"
 #include "msgpack_light/details/map_ref.h"
 #include "msgpack_light/details/object_data.h"
 #include "msgpack_light/details/object_ref.h"  // IWYU pragma: keep
@@ -34,25 +40,75 @@ namespace msgpack_light {
 template <typename Allocator>
 inline typename mutable_map_ref<Allocator>::mutable_object_ref_type
 mutable_map_ref<Allocator>::key(std::size_t index) noexcept {
-    return mutable_object_ref_type(data_->data[index].key, *allocator_);
+    details::invalidate_map_index(*data_);
+    return mutable_object_ref_type(
+        data_->data.map_value[index].key, *allocator_);
 }
 
 template <typename Allocator>
 inline typename mutable_map_ref<Allocator>::const_object_ref_type
 mutable_map_ref<Allocator>::key(std::size_t index) const noexcept {
-    return const_object_ref_type{data_->data[index].key};
+    return const_object_ref_type{data_->data.map_value[index].key};
 }
 
 template <typename Allocator>
 inline typename mutable_map_ref<Allocator>::mutable_object_ref_type
 mutable_map_ref<Allocator>::value(std::size_t index) noexcept {
-    return mutable_object_ref_type(data_->data[index].value, *allocator_);
+    return mutable_object_ref_type(
+        data_->data.map_value[index].value, *allocator_);
 }
 
 template <typename Allocator>
 inline typename mutable_map_ref<Allocator>::const_object_ref_type
 mutable_map_ref<Allocator>::value(std::size_t index) const noexcept {
-    return const_object_ref_type{data_->data[index].value};
+    return const_object_ref_type{data_->data.map_value[index].value};
+}
+
+template <typename Allocator>
+inline mutable_map_iterator<Allocator>
+mutable_map_ref<Allocator>::emplace_back() {
+    details::key_value_pair_data& pair = prepare_back();
+    ++data_->size;
+    // The key will be modified through the returned iterator.
+    details::invalidate_map_index(*data_);
+    return mutable_map_iterator<Allocator>{&pair, allocator_};
+}
+
+template <typename Allocator>
+inline std::pair<mutable_map_value_iterator<Allocator>, bool>
+mutable_map_ref<Allocator>::insert(std::string_view key) {
+    auto iter = find(key);
+    if (iter.pointer() != data_->data.map_value + data_->size) {
+        return {iter, false};
+    }
+    details::key_value_pair_data& pair = prepare_back();
+    mutable_object_ref_type(pair.key, *allocator_).set_string(key);
+    ++data_->size;
+    details::add_to_map_index(*data_, data_->size - 1U);
+    return {mutable_map_value_iterator<Allocator>{&pair, allocator_}, true};
+}
+
+template <typename Allocator>
+template <typename Integer,
+    std::enable_if_t<details::is_map_lookup_integer_v<Integer>,
+        std::nullptr_t>>
+inline std::pair<mutable_map_value_iterator<Allocator>, bool>
+mutable_map_ref<Allocator>::insert(Integer key) {
+    auto iter = find(key);
+    if (iter.pointer() != data_->data.map_value + data_->size) {
+        return {iter, false};
+    }
+    details::key_value_pair_data& pair = prepare_back();
+    if constexpr (std::is_signed_v<Integer>) {
+        mutable_object_ref_type(pair.key, *allocator_)
+            .set_signed_integer(static_cast<std::int64_t>(key));
+    } else {
+        mutable_object_ref_type(pair.key, *allocator_)
+            .set_unsigned_integer(static_cast<std::uint64_t>(key));
+    }
+    ++data_->size;
+    details::add_to_map_index(*data_, data_->size - 1U);
+    return {mutable_map_value_iterator<Allocator>{&pair, allocator_}, true};
 }
 
 /*
@@ -61,12 +117,12 @@ mutable_map_ref<Allocator>::value(std::size_t index) const noexcept {
 
 inline typename const_map_ref::const_object_ref_type const_map_ref::key(
     std::size_t index) const noexcept {
-    return const_object_ref_type{data_->data[index].key};
+    return const_object_ref_type{data_->data.map_value[index].key};
 }
 
 inline typename const_map_ref::const_object_ref_type const_map_ref::value(
     std::size_t index) const noexcept {
-    return const_object_ref_type{data_->data[index].value};
+    return const_object_ref_type{data_->data.map_value[index].value};
 }
 
 }  // namespace msgpack_light
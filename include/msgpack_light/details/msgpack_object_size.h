@@ -0,0 +1,188 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of msgpack_object_size function.
+ */
+#pragma once
+
+#include <cstddef>  // IWYU pragma: keep
+#include <cstdint>
+#include <stdexcept>
+
+namespace msgpack_light::details {
+
+/*!
+ * \brief Read an unsigned integer in big endian.
+ *
+ * \tparam N Number of bytes.
+ * \param[in] data Pointer to the data.
+ * \param[in] size Size of the data.
+ * \param[in,out] position Position of the integer. This will be moved to the
+ * next byte of the integer.
+ * \return Value.
+ */
+template <std::size_t N>
+[[nodiscard]] inline std::uint64_t read_big_endian_unsigned_integer(
+    const unsigned char* data, std::size_t size, std::size_t& position) {
+    if (size - position < N) {
+        throw std::runtime_error("Incomplete MessagePack data.");
+    }
+    std::uint64_t value = 0U;
+    for (std::size_t i = 0; i < N; ++i) {
+        value <<= 8U;  // NOLINT(readability-magic-numbers)
+        value |= static_cast<std::uint64_t>(data[position + i]);
+    }
+    position += N;
+    return value;
+}
+
+/*!
+ * \brief Calculate the size of the first object in MessagePack data.
+ *
+ * This function checks the formats of the object and its children without
+ * recursive calls, so deeply nested data can be checked safely.
+ *
+ * \note This function throws exceptions for invalid or incomplete data.
+ *
+ * \param[in] data Pointer to the data.
+ * \param[in] size Size of the data.
+ * \return Number of bytes of the first object.
+ */
+[[nodiscard]] inline std::size_t msgpack_object_size(
+    const unsigned char* data, std::size_t size) {
+    std::size_t position = 0U;
+    // Number of objects which have not been read yet.
+    std::uint64_t remaining_objects = 1U;
+    while (remaining_objects > 0U) {
+        --remaining_objects;
+        if (position >= size) {
+            throw std::runtime_error("Incomplete MessagePack data.");
+        }
+        const unsigned int prefix = data[position];
+        ++position;
+
+        // NOLINTBEGIN(readability-magic-numbers)
+        std::uint64_t data_size = 0U;
+        if (prefix <= 0x7FU || prefix >= 0xE0U) {
+            // positive fixint, negative fixint
+        } else if (prefix <= 0x8FU) {
+            // fixmap
+            remaining_objects +=
+                static_cast<std::uint64_t>(prefix & 0x0FU) * 2U;
+        } else if (prefix <= 0x9FU) {
+            // fixarray
+            remaining_objects += static_cast<std::uint64_t>(prefix & 0x0FU);
+        } else if (prefix <= 0xBFU) {
+            // fixstr
+            data_size = static_cast<std::uint64_t>(prefix & 0x1FU);
+        } else {
+            switch (prefix) {
+            case 0xC0U:  // nil
+            case 0xC2U:  // false
+            case 0xC3U:  // true
+                break;
+            case 0xC4U:  // bin 8
+            case 0xD9U:  // str 8
+                data_size =
+                    read_big_endian_unsigned_integer<1U>(data, size, position);
+                break;
+            case 0xC5U:  // bin 16
+            case 0xDAU:  // str 16
+                data_size =
+                    read_big_endian_unsigned_integer<2U>(data, size, position);
+                break;
+            case 0xC6U:  // bin 32
+            case 0xDBU:  // str 32
+                data_size =
+                    read_big_endian_unsigned_integer<4U>(data, size, position);
+                break;
+            case 0xC7U:  // ext 8
+                data_size = 1U +
+                    read_big_endian_unsigned_integer<1U>(data, size, position);
+                break;
+            case 0xC8U:  // ext 16
+                data_size = 1U +
+                    read_big_endian_unsigned_integer<2U>(data, size, position);
+                break;
+            case 0xC9U:  // ext 32
+                data_size = 1U +
+                    read_big_endian_unsigned_integer<4U>(data, size, position);
+                break;
+            case 0xCCU:  // uint 8
+            case 0xD0U:  // int 8
+                data_size = 1U;
+                break;
+            case 0xCDU:  // uint 16
+            case 0xD1U:  // int 16
+                data_size = 2U;
+                break;
+            case 0xCAU:  // float 32
+            case 0xCEU:  // uint 32
+            case 0xD2U:  // int 32
+                data_size = 4U;
+                break;
+            case 0xCBU:  // float 64
+            case 0xCFU:  // uint 64
+            case 0xD3U:  // int 64
+                data_size = 8U;
+                break;
+            case 0xD4U:  // fixext 1
+                data_size = 2U;
+                break;
+            case 0xD5U:  // fixext 2
+                data_size = 3U;
+                break;
+            case 0xD6U:  // fixext 4
+                data_size = 5U;
+                break;
+            case 0xD7U:  // fixext 8
+                data_size = 9U;
+                break;
+            case 0xD8U:  // fixext 16
+                data_size = 17U;
+                break;
+            case 0xDCU:  // array 16
+                remaining_objects +=
+                    read_big_endian_unsigned_integer<2U>(data, size, position);
+                break;
+            case 0xDDU:  // array 32
+                remaining_objects +=
+                    read_big_endian_unsigned_integer<4U>(data, size, position);
+                break;
+            case 0xDEU:  // map 16
+                remaining_objects += 2U *
+                    read_big_endian_unsigned_integer<2U>(data, size, position);
+                break;
+            case 0xDFU:  // map 32
+                remaining_objects += 2U *
+                    read_big_endian_unsigned_integer<4U>(data, size, position);
+                break;
+            default:  // 0xC1 (never used)
+                throw std::runtime_error("Invalid MessagePack data.");
+            }
+        }
+        // NOLINTEND(readability-magic-numbers)
+
+        if (static_cast<std::uint64_t>(size - position) < data_size) {
+            throw std::runtime_error("Incomplete MessagePack data.");
+        }
+        position += static_cast<std::size_t>(data_size);
+    }
+    return position;
+}
+
+}  // namespace msgpack_light::details
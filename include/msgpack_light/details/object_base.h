@@ -28,6 +28,7 @@
 #include "msgpack_light/details/allocator_wrapper.h"
 #include "msgpack_light/details/array_ref.h"
 #include "msgpack_light/details/extension_ref.h"
+#include "msgpack_light/details/map_index.h"
 #include "msgpack_light/details/map_ref.h"
 #include "msgpack_light/details/object_data.h"
 #include "msgpack_light/details/object_helper.h"
@@ -130,8 +131,7 @@ public:
         if (data().type != object_data_type::string) {
             throw std::runtime_error("This object is not a string.");
         }
-        return std::string_view(
-            data().data.string_value.data, data().data.string_value.size);
+        return get_string_of(data());
     }
 
     /*!
@@ -144,7 +144,7 @@ public:
             throw std::runtime_error("This object is not a binary.");
         }
         return binary_view(
-            data().data.binary_value.data, data().data.binary_value.size);
+            get_binary_data_of(data()), get_binary_size_of(data()));
     }
 
     /*!
@@ -156,7 +156,7 @@ public:
         if (data().type != object_data_type::array) {
             throw std::runtime_error("This object is not an array.");
         }
-        return const_array_ref{data().data.array_value};
+        return const_array_ref{data()};
     }
 
     /*!
@@ -168,7 +168,7 @@ public:
         if (data().type != object_data_type::map) {
             throw std::runtime_error("This object is not a map.");
         }
-        return const_map_ref{data().data.map_value};
+        return const_map_ref{data()};
     }
 
     /*!
@@ -180,7 +180,7 @@ public:
         if (data().type != object_data_type::extension) {
             throw std::runtime_error("This object is not an extension.");
         }
-        return const_extension_ref{data().data.extension_value};
+        return const_extension_ref{data()};
     }
 
     //!\}
@@ -296,13 +296,24 @@ public:
      * \brief Set this object to a string.
      *
      * \param[in] value Value.
+     *
+     * \note Strings with sizes up to details::inline_bytes_capacity are
+     * stored without allocation of memory.
      */
     void set_string(std::string_view value) {
+        if (value.size() <= inline_bytes_capacity) {
+            const object_data inline_data = make_inline_bytes(
+                object_data_type::string, value.data(), value.size());
+            clear();
+            data() = inline_data;
+            return;
+        }
+        check_object_data_size(value.size());
         auto* ptr = allocator().allocate_char(value.size());
         std::memcpy(ptr, value.data(), value.size());
         clear();
-        data().data.string_value.data = ptr;
-        data().data.string_value.size = value.size();
+        data().data.string_value = ptr;
+        data().size = static_cast<std::uint32_t>(value.size());
         data().type = object_data_type::string;
     }
 
@@ -310,13 +321,24 @@ public:
      * \brief Set this object to a binary.
      *
      * \param[in] value Value.
+     *
+     * \note Binaries with sizes up to details::inline_bytes_capacity are
+     * stored without allocation of memory.
      */
     void set_binary(binary_view value) {
+        if (value.size() <= inline_bytes_capacity) {
+            const object_data inline_data = make_inline_bytes(
+                object_data_type::binary, value.data(), value.size());
+            clear();
+            data() = inline_data;
+            return;
+        }
+        check_object_data_size(value.size());
         auto* ptr = allocator().allocate_unsigned_char(value.size());
         std::memcpy(ptr, value.data(), value.size());
         clear();
-        data().data.binary_value.data = ptr;
-        data().data.binary_value.size = value.size();
+        data().data.binary_value = ptr;
+        data().size = static_cast<std::uint32_t>(value.size());
         data().type = object_data_type::binary;
     }
 
@@ -327,14 +349,13 @@ public:
      * \return Object to access the array.
      */
     mutable_array_ref<Allocator> set_array(std::size_t size = 0U) {
+        check_object_data_size(size);
         clear();
-        data().data.array_value.data = allocator().allocate_object_data(size);
-        data().data.array_value.size = size;
-        std::memset(
-            data().data.array_value.data, 0, size * sizeof(object_data));
+        data().data.array_value = allocator().allocate_object_data(size);
+        data().size = static_cast<std::uint32_t>(size);
+        fill_with_nil(data().data.array_value, size);
         data().type = object_data_type::array;
-        return mutable_array_ref<Allocator>(
-            data().data.array_value, allocator());
+        return mutable_array_ref<Allocator>(data(), allocator());
     }
 
     /*!
@@ -344,14 +365,13 @@ public:
      * \return Object to access the map.
      */
     mutable_map_ref<Allocator> set_map(std::size_t size = 0U) {
+        check_object_data_size(size);
         clear();
-        data().data.map_value.data =
-            allocator().allocate_key_value_pair_data(size);
-        data().data.map_value.size = size;
-        std::memset(
-            data().data.map_value.data, 0, size * sizeof(key_value_pair_data));
+        data().data.map_value = allocator().allocate_key_value_pair_data(size);
+        data().size = static_cast<std::uint32_t>(size);
+        fill_with_nil(data().data.map_value, size);
         data().type = object_data_type::map;
-        return mutable_map_ref<Allocator>(data().data.map_value, allocator());
+        return mutable_map_ref<Allocator>(data(), allocator());
     }
 
     /*!
@@ -361,12 +381,13 @@ public:
      * \param[in] value_data Data of the value.
      */
     void set_extension(std::int8_t type, binary_view value_data) {
+        check_object_data_size(value_data.size());
         auto* ptr = allocator().allocate_unsigned_char(value_data.size());
         std::memcpy(ptr, value_data.data(), value_data.size());
         clear();
-        data().data.extension_value.type = type;
-        data().data.extension_value.data = ptr;
-        data().data.extension_value.size = value_data.size();
+        data().data.extension_value = ptr;
+        data().size = static_cast<std::uint32_t>(value_data.size());
+        data().extension_type = type;
         data().type = object_data_type::extension;
     }
 
@@ -377,6 +398,22 @@ public:
 
     //!\}
 
+    /*!
+     * \name Search of keys
+     */
+    //!\{
+
+    /*!
+     * \brief Build hash indices of keys in large maps in this object.
+     *
+     * Maps in arrays and maps are included. After this function,
+     * msgpack_light::const_map_ref::find function uses the indices
+     * until keys are modified.
+     */
+    void build_index() { build_map_indices(data(), allocator()); }
+
+    //!\}
+
     using const_object_base<Derived>::as_array;
     using const_object_base<Derived>::as_map;
 
@@ -394,8 +431,7 @@ public:
         if (data().type != object_data_type::array) {
             throw std::runtime_error("This object is not an array.");
         }
-        return mutable_array_ref<Allocator>(
-            data().data.array_value, allocator());
+        return mutable_array_ref<Allocator>(data(), allocator());
     }
 
     /*!
@@ -407,7 +443,7 @@ public:
         if (data().type != object_data_type::map) {
             throw std::runtime_error("This object is not a map.");
         }
-        return mutable_map_ref<Allocator>(data().data.map_value, allocator());
+        return mutable_map_ref<Allocator>(data(), allocator());
     }
 
     //!\}
@@ -21,75 +21,45 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
 
 #include "msgpack_light/object_data_type.h"
 
 namespace msgpack_light::details {
 
-struct object_data;
-
-/*!
- * \brief Struct of data of strings.
- */
-struct string_data {
-    //! Data.
-    char* data;
-
-    //! Size of the data.
-    std::size_t size;
-};
-
-/*!
- * \brief Struct of data of binaries.
- */
-struct binary_data {
-    //! Data.
-    unsigned char* data;
-
-    //! Size of the data.
-    std::size_t size;
-};
-
-/*!
- * \brief Struct of data of arrays.
- */
-struct array_data {
-    //! Data.
-    object_data* data;
-
-    //! Size of the data.
-    std::size_t size;
-};
-
 struct key_value_pair_data;
 
 /*!
- * \brief Struct of data of maps.
+ * \brief Maximum size of strings, binaries, arrays, maps, and extensions
+ * in object_data.
+ *
+ * This is the limit in MessagePack specification.
  */
-struct map_data {
-    //! Data.
-    key_value_pair_data* data;
-
-    //! Size of the data.
-    std::size_t size;
-};
+constexpr std::size_t max_object_data_size = 0xFFFFFFFFU;
 
 /*!
- * \brief Struct of data of extensions.
+ * \brief Flag of object_data::flags for strings and binaries stored inline.
  */
-struct extension_data {
-    //! Type.
-    std::int8_t type;
-
-    //! Data.
-    unsigned char* data;
-
-    //! Size of the data.
-    std::size_t size;
-};
+constexpr std::uint8_t object_data_inline_flag = 1U;
 
 /*!
  * \brief Struct of data of objects in MessagePack.
+ *
+ * This struct is packed into 16 bytes:
+ *
+ * | Bytes | Member                                          |
+ * | :---- | :---------------------------------------------- |
+ * | 0-7   | data (values or pointers)                       |
+ * | 8-11  | size                                            |
+ * | 12    | type                                            |
+ * | 13    | extension_type                                  |
+ * | 14    | flags                                           |
+ * | 15    | inline_size                                     |
+ *
+ * Strings and binaries stored inline use bytes 0-11 for their bytes
+ * and inline_size for their sizes.
  */
 struct object_data {
     //! Data.
@@ -109,26 +79,146 @@ struct object_data {
         //! 64-bit floating-point numbers.
         double double_value;
 
-        //! String.
-        string_data string_value;
+        //! Characters of a string.
+        char* string_value;
 
-        //! Binary.
-        binary_data binary_value;
+        //! Bytes of a binary.
+        unsigned char* binary_value;
 
-        //! Array.
-        array_data array_value;
+        //! Elements of an array.
+        object_data* array_value;
 
-        //! Map.
-        map_data map_value;
+        //! Key-value pairs of a map.
+        key_value_pair_data* map_value;
 
-        //! Extension.
-        extension_data extension_value;
+        //! Bytes of data of an extension.
+        unsigned char* extension_value;
     } data{};
 
+    //! Size of strings, binaries, arrays, maps, and extensions.
+    std::uint32_t size{0U};
+
     //! Type of the data.
     object_data_type type{object_data_type::nil};
+
+    //! Type of extensions.
+    std::int8_t extension_type{0};
+
+    //! Flags. (Combination of object_data_inline_flag.)
+    std::uint8_t flags{0U};
+
+    //! Size of strings and binaries stored inline.
+    std::uint8_t inline_size{0U};
 };
 
+static_assert(sizeof(object_data) == 16U);
+static_assert(offsetof(object_data, size) == sizeof(std::uint64_t));
+
+/*!
+ * \brief Maximum size of strings and binaries stored in object_data
+ * without allocation of memory.
+ */
+constexpr std::size_t inline_bytes_capacity = offsetof(object_data, type);
+
+/*!
+ * \brief Check whether a string or a binary is stored inline.
+ *
+ * \param[in] data Data of the string or binary.
+ * \return Whether the data is stored inline.
+ */
+[[nodiscard]] inline bool is_inline_bytes(const object_data& data) noexcept {
+    return (data.flags & object_data_inline_flag) != 0U;
+}
+
+/*!
+ * \brief Get bytes of a string or a binary stored inline.
+ *
+ * \param[in] data Data of the string or binary.
+ * \return Pointer to the bytes.
+ */
+[[nodiscard]] inline unsigned char* get_inline_bytes(
+    object_data& data) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<unsigned char*>(&data);
+}
+
+/*!
+ * \brief Get bytes of a string or a binary stored inline.
+ *
+ * \param[in] data Data of the string or binary.
+ * \return Pointer to the bytes.
+ */
+[[nodiscard]] inline const unsigned char* get_inline_bytes(
+    const object_data& data) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<const unsigned char*>(&data);
+}
+
+/*!
+ * \brief Get a string.
+ *
+ * \param[in] data Data of the string.
+ * \return String.
+ */
+[[nodiscard]] inline std::string_view get_string_of(
+    const object_data& data) noexcept {
+    if (is_inline_bytes(data)) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return std::string_view(reinterpret_cast<const char*>(
+                                    get_inline_bytes(data)),
+            data.inline_size);
+    }
+    return std::string_view(data.data.string_value, data.size);
+}
+
+/*!
+ * \brief Get the pointer to the data of a binary.
+ *
+ * \param[in] data Data of the binary.
+ * \return Pointer to the data.
+ */
+[[nodiscard]] inline const unsigned char* get_binary_data_of(
+    const object_data& data) noexcept {
+    if (is_inline_bytes(data)) {
+        return get_inline_bytes(data);
+    }
+    return data.data.binary_value;
+}
+
+/*!
+ * \brief Get the size of a binary.
+ *
+ * \param[in] data Data of the binary.
+ * \return Size.
+ */
+[[nodiscard]] inline std::size_t get_binary_size_of(
+    const object_data& data) noexcept {
+    if (is_inline_bytes(data)) {
+        return data.inline_size;
+    }
+    return data.size;
+}
+
+/*!
+ * \brief Create data of a string or a binary stored inline.
+ *
+ * \param[in] type Type. (string or binary.)
+ * \param[in] bytes Bytes.
+ * \param[in] size Number of bytes. (Must not exceed inline_bytes_capacity.)
+ * \return Data.
+ */
+[[nodiscard]] inline object_data make_inline_bytes(
+    object_data_type type, const void* bytes, std::size_t size) noexcept {
+    object_data data{};
+    if (size > 0U) {
+        std::memcpy(get_inline_bytes(data), bytes, size);
+    }
+    data.type = type;
+    data.flags = object_data_inline_flag;
+    data.inline_size = static_cast<std::uint8_t>(size);
+    return data;
+}
+
 /*!
  * \brief Struct of data of key-value pairs in maps.
  */
@@ -140,4 +230,109 @@ struct key_value_pair_data {
     object_data value{};
 };
 
+/*!
+ * \brief Reset data to nil objects by filling with zeros.
+ *
+ * Zero bytes represent nil objects in object_data.
+ *
+ * \tparam T Type of data (object_data or key_value_pair_data).
+ * \param[out] data Pointer to the data.
+ * \param[in] size Number of elements.
+ */
+template <typename T>
+inline void fill_with_nil(T* data, std::size_t size) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(object_data_type::nil == object_data_type{});
+    // The pointer is cast to void* because the types are not trivial
+    // only due to their default member initializers.
+    std::memset(static_cast<void*>(data), 0, size * sizeof(T));
+}
+
+/*!
+ * \brief Struct of hash indices of keys in maps.
+ *
+ * Slots (`std::uint64_t`) follow this struct in the same memory block.
+ * Each slot holds the upper 32 bits of the hash of a key in the upper bits
+ * and the index of the key-value pair plus one in the lower bits.
+ * Zero means an empty slot.
+ */
+struct map_index {
+    //! Number of slots. (Power of two.)
+    std::size_t num_slots;
+
+    //! Whether this index is consistent with the keys in the map.
+    bool is_valid;
+};
+
+/*!
+ * \brief Struct of headers placed before elements of arrays.
+ */
+struct array_header {
+    //! Number of elements which can be stored without reallocation.
+    std::size_t capacity;
+};
+
+static_assert(sizeof(array_header) % alignof(object_data) == 0);
+
+/*!
+ * \brief Get the header of elements of an array.
+ *
+ * \param[in] data Pointer to the elements.
+ * \return Pointer to the header.
+ */
+[[nodiscard]] inline array_header* get_array_header(
+    object_data* data) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<array_header*>(data) - 1;
+}
+
+/*!
+ * \brief Get the header of elements of an array.
+ *
+ * \param[in] data Pointer to the elements.
+ * \return Pointer to the header.
+ */
+[[nodiscard]] inline const array_header* get_array_header(
+    const object_data* data) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<const array_header*>(data) - 1;
+}
+
+/*!
+ * \brief Struct of headers placed before key-value pairs of maps.
+ */
+struct map_header {
+    //! Hash index of keys. (Null if not built.)
+    map_index* index;
+
+    //! Number of key-value pairs which can be stored without reallocation.
+    std::size_t capacity;
+};
+
+static_assert(sizeof(map_header) % alignof(key_value_pair_data) == 0);
+
+/*!
+ * \brief Get the header of key-value pairs of a map.
+ *
+ * \param[in] data Pointer to the key-value pairs.
+ * \return Pointer to the header.
+ */
+[[nodiscard]] inline map_header* get_map_header(
+    key_value_pair_data* data) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<map_header*>(data) - 1;
+}
+
+/*!
+ * \brief Get the header of key-value pairs of a map.
+ *
+ * \param[in] data Pointer to the key-value pairs.
+ * \return Pointer to the header.
+ */
+[[nodiscard]] inline const map_header* get_map_header(
+    const key_value_pair_data* data) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<const map_header*>(data) - 1;
+}
+
 }  // namespace msgpack_light::details
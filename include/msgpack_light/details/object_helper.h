@@ -19,7 +19,10 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
+#include <stdexcept>
 
 #include "msgpack_light/details/allocator_wrapper.h"
 #include "msgpack_light/details/object_data.h"
@@ -27,6 +30,19 @@
 
 namespace msgpack_light::details {
 
+/*!
+ * \brief Check the size of strings, binaries, arrays, maps, and extensions.
+ *
+ * \param[in] size Size.
+ * \throws std::runtime_error If the size is larger than
+ * max_object_data_size.
+ */
+inline void check_object_data_size(std::size_t size) {
+    if (size > max_object_data_size) {
+        throw std::runtime_error("Size is too large.");
+    }
+}
+
 /*!
  * \brief Clear data.
  *
@@ -39,31 +55,35 @@ inline void clear_object_data(
     object_data& data, allocator_wrapper<Allocator>& allocator) noexcept {
     switch (data.type) {
     case object_data_type::string:
-        allocator.deallocate_char(data.data.string_value.data);
+        if (!is_inline_bytes(data)) {
+            allocator.deallocate_char(data.data.string_value);
+        }
         break;
     case object_data_type::binary:
-        allocator.deallocate_unsigned_char(data.data.binary_value.data);
+        if (!is_inline_bytes(data)) {
+            allocator.deallocate_unsigned_char(data.data.binary_value);
+        }
         break;
     case object_data_type::array:
-        for (std::size_t i = 0; i < data.data.array_value.size; ++i) {
-            clear_object_data(data.data.array_value.data[i], allocator);
+        for (std::size_t i = 0; i < data.size; ++i) {
+            clear_object_data(data.data.array_value[i], allocator);
         }
-        allocator.deallocate_object_data(data.data.array_value.data);
+        allocator.deallocate_object_data(data.data.array_value);
         break;
     case object_data_type::map:
-        for (std::size_t i = 0; i < data.data.map_value.size; ++i) {
-            clear_object_data(data.data.map_value.data[i].key, allocator);
-            clear_object_data(data.data.map_value.data[i].value, allocator);
+        for (std::size_t i = 0; i < data.size; ++i) {
+            clear_object_data(data.data.map_value[i].key, allocator);
+            clear_object_data(data.data.map_value[i].value, allocator);
         }
-        allocator.deallocate_key_value_pair_data(data.data.map_value.data);
+        allocator.deallocate_key_value_pair_data(data.data.map_value);
         break;
     case object_data_type::extension:
-        allocator.deallocate_unsigned_char(data.data.extension_value.data);
+        allocator.deallocate_unsigned_char(data.data.extension_value);
         break;
     default:
         break;
     };
-    data.type = object_data_type::nil;
+    data = object_data{};
 }
 
 /*!
@@ -77,58 +97,116 @@ inline void clear_object_data(
 template <typename Allocator>
 inline void copy_object_data(object_data& to, const object_data& from,
     allocator_wrapper<Allocator>& allocator) {
+    if (is_inline_bytes(from)) {
+        to = from;
+        return;
+    }
     switch (from.type) {
-    case object_data_type::string:
-        to.data.string_value.data =
-            allocator.allocate_char(from.data.string_value.size);
-        std::memcpy(to.data.string_value.data, from.data.string_value.data,
-            from.data.string_value.size);
-        to.data.string_value.size = from.data.string_value.size;
-        to.type = object_data_type::string;
+    case object_data_type::string: {
+        char* ptr = allocator.allocate_char(from.size);
+        std::memcpy(ptr, from.data.string_value, from.size);
+        to = from;
+        to.data.string_value = ptr;
         break;
-    case object_data_type::binary:
-        to.data.binary_value.data =
-            allocator.allocate_unsigned_char(from.data.binary_value.size);
-        std::memcpy(to.data.binary_value.data, from.data.binary_value.data,
-            from.data.binary_value.size);
-        to.data.binary_value.size = from.data.binary_value.size;
-        to.type = object_data_type::binary;
+    }
+    case object_data_type::binary: {
+        unsigned char* ptr = allocator.allocate_unsigned_char(from.size);
+        std::memcpy(ptr, from.data.binary_value, from.size);
+        to = from;
+        to.data.binary_value = ptr;
         break;
-    case object_data_type::array:
-        to.data.array_value.data =
-            allocator.allocate_object_data(from.data.array_value.size);
-        to.data.array_value.size = from.data.array_value.size;
-        to.type = object_data_type::array;
-        for (std::size_t i = 0; i < from.data.array_value.size; ++i) {
-            copy_object_data(to.data.array_value.data[i],
-                from.data.array_value.data[i], allocator);
+    }
+    case object_data_type::array: {
+        object_data* ptr = allocator.allocate_object_data(from.size);
+        fill_with_nil(ptr, from.size);
+        to = from;
+        to.data.array_value = ptr;
+        for (std::size_t i = 0; i < from.size; ++i) {
+            copy_object_data(ptr[i], from.data.array_value[i], allocator);
         }
         break;
-    case object_data_type::map:
-        to.data.map_value.data =
-            allocator.allocate_key_value_pair_data(from.data.map_value.size);
-        to.data.map_value.size = from.data.map_value.size;
-        to.type = object_data_type::map;
-        for (std::size_t i = 0; i < from.data.map_value.size; ++i) {
-            copy_object_data(to.data.map_value.data[i].key,
-                from.data.map_value.data[i].key, allocator);
-            copy_object_data(to.data.map_value.data[i].value,
-                from.data.map_value.data[i].value, allocator);
+    }
+    case object_data_type::map: {
+        key_value_pair_data* ptr =
+            allocator.allocate_key_value_pair_data(from.size);
+        fill_with_nil(ptr, from.size);
+        to = from;
+        to.data.map_value = ptr;
+        for (std::size_t i = 0; i < from.size; ++i) {
+            copy_object_data(
+                ptr[i].key, from.data.map_value[i].key, allocator);
+            copy_object_data(
+                ptr[i].value, from.data.map_value[i].value, allocator);
         }
         break;
-    case object_data_type::extension:
-        to.data.extension_value.data =
-            allocator.allocate_unsigned_char(from.data.extension_value.size);
-        std::memcpy(to.data.extension_value.data,
-            from.data.extension_value.data, from.data.extension_value.size);
-        to.data.extension_value.size = from.data.extension_value.size;
-        to.data.extension_value.type = from.data.extension_value.type;
-        to.type = object_data_type::extension;
+    }
+    case object_data_type::extension: {
+        unsigned char* ptr = allocator.allocate_unsigned_char(from.size);
+        std::memcpy(ptr, from.data.extension_value, from.size);
+        to = from;
+        to.data.extension_value = ptr;
         break;
+    }
     default:
         to = from;
         break;
     };
 }
 
+/*!
+ * \brief Calculate the capacity of arrays and maps after growth.
+ *
+ * \param[in] capacity Current capacity.
+ * \param[in] required Required capacity.
+ * \return Capacity after growth.
+ */
+[[nodiscard]] inline std::size_t grown_capacity(
+    std::size_t capacity, std::size_t required) noexcept {
+    constexpr std::size_t min_capacity = 4U;
+    return std::min(std::max({required, capacity * 2U, min_capacity}),
+        std::max(required, max_object_data_size));
+}
+
+/*!
+ * \brief Reallocate elements of an array.
+ *
+ * \tparam Allocator Type of the allocator.
+ * \param[in,out] data Data of the array.
+ * \param[in] capacity New capacity. (Must not be less than the size.)
+ * \param[in] allocator Allocator.
+ */
+template <typename Allocator>
+inline void reallocate_array_data(object_data& data, std::size_t capacity,
+    allocator_wrapper<Allocator>& allocator) {
+    object_data* new_data = allocator.allocate_object_data(capacity);
+    std::memcpy(
+        new_data, data.data.array_value, data.size * sizeof(object_data));
+    allocator.deallocate_object_data(data.data.array_value);
+    data.data.array_value = new_data;
+}
+
+/*!
+ * \brief Reallocate key-value pairs of a map.
+ *
+ * The hash index of keys is moved to the new memory.
+ *
+ * \tparam Allocator Type of the allocator.
+ * \param[in,out] data Data of the map.
+ * \param[in] capacity New capacity. (Must not be less than the size.)
+ * \param[in] allocator Allocator.
+ */
+template <typename Allocator>
+inline void reallocate_map_data(object_data& data, std::size_t capacity,
+    allocator_wrapper<Allocator>& allocator) {
+    key_value_pair_data* new_data =
+        allocator.allocate_key_value_pair_data(capacity);
+    std::memcpy(new_data, data.data.map_value,
+        data.size * sizeof(key_value_pair_data));
+    map_header* old_header = get_map_header(data.data.map_value);
+    get_map_header(new_data)->index = old_header->index;
+    old_header->index = nullptr;
+    allocator.deallocate_key_value_pair_data(data.data.map_value);
+    data.data.map_value = new_data;
+}
+
 }  // namespace msgpack_light::details
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of parallel_for function.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "msgpack_light/details/thread_pool.h"
+
+namespace msgpack_light::details {
+
+/*!
+ * \brief Determine the number of threads.
+ *
+ * \param[in] num_threads Number of threads specified by users.
+ * (0 for the number of hardware threads.)
+ * \return Number of threads.
+ */
+[[nodiscard]] inline std::size_t resolve_num_threads(std::size_t num_threads) {
+    if (num_threads > 0U) {
+        return num_threads;
+    }
+    const unsigned int hardware_threads = std::thread::hardware_concurrency();
+    if (hardware_threads == 0U) {
+        return 1U;
+    }
+    return static_cast<std::size_t>(hardware_threads);
+}
+
+/*!
+ * \brief Class of states of helpers of parallel_for function in thread pools.
+ */
+class parallel_for_helper_state {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] work Function to execute tasks.
+     */
+    explicit parallel_for_helper_state(const std::function<void()>& work)
+        : work_(&work) {}
+
+    /*!
+     * \brief Execute tasks in a helper if the caller still waits for helpers.
+     */
+    void help() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (closed_) {
+                return;
+            }
+            ++num_running_;
+        }
+        (*work_)();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            --num_running_;
+        }
+        condition_.notify_all();
+    }
+
+    /*!
+     * \brief Stop starting helpers and wait for running helpers.
+     */
+    void close_and_wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        closed_ = true;
+        condition_.wait(lock, [this] { return num_running_ == 0U; });
+    }
+
+private:
+    //! Function to execute tasks. (Valid until close_and_wait returns.)
+    const std::function<void()>* work_;
+
+    //! Mutex of the data.
+    std::mutex mutex_{};
+
+    //! Condition variable to notify finish of helpers.
+    std::condition_variable condition_{};
+
+    //! Number of running helpers.
+    std::size_t num_running_{0U};
+
+    //! Whether helpers can no longer start.
+    bool closed_{false};
+};
+
+/*!
+ * \brief Execute tasks in parallel.
+ *
+ * Tasks are executed in threads of thread_pool::instance() and the current
+ * thread. Threads in the pool are created at the first use and reused in
+ * later calls. Each thread takes the next task until all tasks are executed.
+ * Helpers which have not started when the current thread finishes all tasks
+ * are skipped, so that nested calls don't wait for busy threads.
+ * If some tasks throw exceptions, the first exception is re-thrown
+ * after all threads finish.
+ *
+ * \tparam Function Type of the function.
+ * \param[in] num_tasks Number of tasks.
+ * \param[in] num_threads Number of threads including the current thread.
+ * \param[in] function Function to execute a task.
+ * This is called with the index of a task as the argument.
+ */
+template <typename Function>
+inline void parallel_for(
+    std::size_t num_tasks, std::size_t num_threads, Function&& function) {
+    std::atomic<std::size_t> next_task{0U};
+    std::mutex exception_mutex;
+    std::exception_ptr first_exception;
+
+    const std::function<void()> work = [&] {
+        while (true) {
+            const std::size_t task =
+                next_task.fetch_add(1U, std::memory_order_relaxed);
+            if (task >= num_tasks) {
+                return;
+            }
+            try {
+                function(task);
+            } catch (...) {
+                std::unique_lock<std::mutex> lock(exception_mutex);
+                if (!first_exception) {
+                    first_exception = std::current_exception();
+                }
+                // Skip remaining tasks.
+                next_task.store(num_tasks, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    const std::size_t num_helpers =
+        std::min(num_threads, num_tasks) > 0U
+        ? std::min(num_threads, num_tasks) - 1U
+        : 0U;
+    if (num_helpers == 0U) {
+        work();
+    } else {
+        // Helpers may start after this function returns, so the state is
+        // shared with them.
+        const auto state = std::make_shared<parallel_for_helper_state>(work);
+        try {
+            thread_pool& pool = thread_pool::instance();
+            pool.reserve(num_helpers);
+            for (std::size_t i = 0; i < num_helpers; ++i) {
+                pool.post([state] { state->help(); });
+            }
+        } catch (...) {
+            // Continue with helpers already posted.
+        }
+        work();
+        state->close_and_wait();
+    }
+
+    if (first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+}  // namespace msgpack_light::details
@@ -22,44 +22,44 @@
 #ifndef MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION
 #if defined(MSGPACK_LIGHT_DOCUMENTATION)
 /*!
- * \brief Macro to select use of buffers in serialization.
+ * \brief Macro to select use of buffers in serialization by default.
+ *
+ * The default can be overridden for each serialization using
+ * msgpack_light::serialization_options::buffer_size.
  */
 #define MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION \
 <compiler-specific-default-value>
 #elif defined(_MSC_VER)
-// With MSVC, non_buffered_serialization_buffer_impl was slightly faster.
+// With MSVC, serialization without buffers was slightly faster.
 #define MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION 0
 #elif defined(__clang__)
-// With Clang, buffered_serialization_buffer_impl was faster.
+// With Clang, serialization with buffers was faster.
 #define MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION 1
 #elif defined(__GNUC__) || defined(__GNUG__)
-// With GCC, non_buffered_serialization_buffer_impl was faster.
+// With GCC, serialization without buffers was faster.
 #define MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION 0
 #else
 #define MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION 0
 #endif
 #endif
 
-#if MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION
+#include <cstddef>
 
-#include "msgpack_light/details/buffered_serialization_buffer_impl.h"
+#include "msgpack_light/details/configurable_serialization_buffer_impl.h"
+#include "msgpack_light/details/static_memory_buffer_size.h"
 
 namespace msgpack_light::details {
 
 //! Type of internal implementation of serialization_buffer class.
-using serialization_buffer_impl = buffered_serialization_buffer_impl;
-
-}  // namespace msgpack_light::details
-
-#else
-
-#include "msgpack_light/details/non_buffered_serialization_buffer_impl.h"
-
-namespace msgpack_light::details {
+using serialization_buffer_impl = configurable_serialization_buffer_impl;
 
-//! Type of internal implementation of serialization_buffer class.
-using serialization_buffer_impl = non_buffered_serialization_buffer_impl;
+/*!
+ * \brief Default size of buffers in serialization_buffer class.
+ *
+ * This is selected by MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION macro.
+ */
+constexpr std::size_t default_serialization_buffer_size =
+    (MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION) ? static_memory_buffer_size
+                                                : 0U;
 
 }  // namespace msgpack_light::details
-
-#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of size_counting_output_stream class.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light::details {
+
+/*!
+ * \brief Class of streams to count the number of bytes written without
+ * storing data.
+ */
+class size_counting_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data. (Not used.)
+     * \param[in] size Size of the data.
+     */
+    void write(
+        [[maybe_unused]] const unsigned char* data, std::size_t size) override {
+        size_ += size;
+    }
+
+    /*!
+     * \brief Get the number of bytes written.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+private:
+    //! Number of bytes written.
+    std::size_t size_{0U};
+};
+
+}  // namespace msgpack_light::details
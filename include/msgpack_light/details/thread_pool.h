@@ -0,0 +1,162 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of thread_pool class.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace msgpack_light::details {
+
+/*!
+ * \brief Class of pools of threads reused in parallel executions.
+ *
+ * Threads are created when required and kept until this object is destroyed.
+ */
+class thread_pool {
+public:
+    //! Type of jobs.
+    using job_type = std::function<void()>;
+
+    /*!
+     * \brief Constructor.
+     *
+     * No thread is created here.
+     */
+    thread_pool() = default;
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool(thread_pool&&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    thread_pool& operator=(thread_pool&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * Jobs not started yet are discarded.
+     */
+    ~thread_pool() noexcept {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /*!
+     * \brief Create threads if this pool has threads less than a number.
+     *
+     * \param[in] num_threads Number of threads.
+     *
+     * \note When threads cannot be created, this pool continues with the
+     * threads already created.
+     */
+    void reserve(std::size_t num_threads) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        try {
+            while (workers_.size() < num_threads) {
+                workers_.emplace_back([this] { run_worker(); });
+            }
+        } catch (...) {
+            // Continue with threads already created.
+        }
+    }
+
+    /*!
+     * \brief Add a job.
+     *
+     * \param[in] job Job. This must not throw exceptions.
+     */
+    void post(job_type job) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        condition_.notify_one();
+    }
+
+    /*!
+     * \brief Get the number of threads.
+     *
+     * \return Number of threads.
+     */
+    [[nodiscard]] std::size_t num_threads() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return workers_.size();
+    }
+
+    /*!
+     * \brief Get the pool shared in this process.
+     *
+     * The pool is created in the first call of this function.
+     *
+     * \return Pool.
+     */
+    [[nodiscard]] static thread_pool& instance() {
+        static thread_pool pool;
+        return pool;
+    }
+
+private:
+    /*!
+     * \brief Execute jobs in a worker thread.
+     */
+    void run_worker() {
+        while (true) {
+            job_type job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(
+                    lock, [this] { return stopped_ || !jobs_.empty(); });
+                if (stopped_) {
+                    return;
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+
+    //! Mutex of the data.
+    std::mutex mutex_{};
+
+    //! Condition variable to notify jobs.
+    std::condition_variable condition_{};
+
+    //! Jobs not started yet.
+    std::deque<job_type> jobs_{};
+
+    //! Worker threads.
+    std::vector<std::thread> workers_{};
+
+    //! Whether this pool is stopped.
+    bool stopped_{false};
+};
+
+}  // namespace msgpack_light::details
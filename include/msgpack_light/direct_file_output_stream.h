@@ -0,0 +1,282 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of direct_file_output_stream class.
+ *
+ * \note This header can be used only in Linux.
+ */
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "msgpack_light/aligned_allocator.h"
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Alignment of buffers and writes in direct_file_output_stream class.
+ */
+constexpr std::size_t direct_io_alignment = 4096U;
+
+/*!
+ * \brief Default size of buffers in direct_file_output_stream class.
+ */
+constexpr std::size_t default_direct_file_buffer_size =
+    static_cast<std::size_t>(1024U) * 1024U;
+
+/*!
+ * \brief Class of streams to write data to files bypassing the page cache
+ * (`O_DIRECT`) in Linux.
+ *
+ * Data is copied to a buffer aligned to direct_io_alignment, and written when
+ * the buffer is full. The tail of data which isn't aligned is written without
+ * `O_DIRECT` in flush() function and the destructor.
+ *
+ * When file systems don't support `O_DIRECT`, this class writes data through
+ * the page cache.
+ *
+ * \note This class can be used only in Linux.
+ */
+class direct_file_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_path File path.
+     * \param[in] buffer_size Size of the buffer. This must be a multiple of
+     * direct_io_alignment.
+     * \param[in] preallocation_size Size of the file to preallocate. (Zero to
+     * disable preallocation.) This doesn't change the size of the file.
+     */
+    explicit direct_file_output_stream(const char* file_path,
+        std::size_t buffer_size = default_direct_file_buffer_size,
+        std::size_t preallocation_size = 0U)
+        : buffer_size_(buffer_size) {
+        if (buffer_size == 0U || buffer_size % direct_io_alignment != 0U) {
+            throw std::invalid_argument("Invalid size of the buffer.");
+        }
+
+        constexpr int permission = 0644;
+        constexpr int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+        file_ = ::open(file_path, flags | O_DIRECT, permission);
+        if (file_ < 0 && errno == EINVAL) {
+            // The file system doesn't support O_DIRECT.
+            file_ = ::open(file_path, flags, permission);
+        }
+        if (file_ < 0) {
+            throw std::runtime_error(
+                std::string("Failed to open ") + file_path);
+        }
+        uses_direct_io_ = (::fcntl(file_, F_GETFL) & O_DIRECT) != 0;
+
+        if (preallocation_size > 0U) {
+            // Preallocation is only an optimization, so errors are ignored.
+            (void)::fallocate(file_, FALLOC_FL_KEEP_SIZE, 0,
+                static_cast<::off_t>(preallocation_size));
+        }
+
+        try {
+            buffer_ = static_cast<unsigned char*>(
+                allocator_.allocate(buffer_size, direct_io_alignment));
+        } catch (...) {
+            (void)::close(file_);
+            throw;
+        }
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_path File path.
+     * \param[in] buffer_size Size of the buffer. This must be a multiple of
+     * direct_io_alignment.
+     * \param[in] preallocation_size Size of the file to preallocate. (Zero to
+     * disable preallocation.) This doesn't change the size of the file.
+     */
+    explicit direct_file_output_stream(const std::string& file_path,
+        std::size_t buffer_size = default_direct_file_buffer_size,
+        std::size_t preallocation_size = 0U)
+        : direct_file_output_stream(
+              file_path.c_str(), buffer_size, preallocation_size) {}
+
+    direct_file_output_stream(const direct_file_output_stream&) = delete;
+    direct_file_output_stream(direct_file_output_stream&&) = delete;
+    direct_file_output_stream& operator=(
+        const direct_file_output_stream&) = delete;
+    direct_file_output_stream& operator=(direct_file_output_stream&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * This writes the remaining data and closes the file.
+     */
+    ~direct_file_output_stream() {
+        try {
+            write_buffer();
+        } catch (...) {
+            // Errors cannot be reported here.
+        }
+        allocator_.deallocate(buffer_);
+        (void)::close(file_);
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        while (size > 0U) {
+            const std::size_t copied_size =
+                std::min(size, buffer_size_ - current_size_);
+            std::memcpy(buffer_ + current_size_, data, copied_size);
+            current_size_ += copied_size;
+            data += copied_size;
+            size -= copied_size;
+            if (current_size_ == buffer_size_) {
+                write_buffer();
+            }
+        }
+    }
+
+    /*!
+     * \brief Write all the data to the file and wait for the data to be
+     * stored in the storage device.
+     */
+    void flush() {
+        write_buffer();
+        if (::fsync(file_) != 0) {
+            throw std::runtime_error("Failed to flush data to a file.");
+        }
+    }
+
+    /*!
+     * \brief Check whether `O_DIRECT` is used.
+     *
+     * \retval true `O_DIRECT` is used.
+     * \retval false `O_DIRECT` isn't used.
+     */
+    [[nodiscard]] bool uses_direct_io() const noexcept {
+        return uses_direct_io_;
+    }
+
+private:
+    /*!
+     * \brief Write data in the buffer.
+     *
+     * Aligned data is written with `O_DIRECT`. The remaining tail is written
+     * without `O_DIRECT` and kept at the beginning of the buffer, so that it
+     * is written again with the following data.
+     */
+    void write_buffer() {
+        const std::size_t aligned_size =
+            current_size_ - current_size_ % direct_io_alignment;
+        write_at(buffer_, aligned_size, file_offset_);
+        file_offset_ += aligned_size;
+        const std::size_t tail_size = current_size_ - aligned_size;
+        current_size_ = tail_size;
+        if (tail_size == 0U) {
+            return;
+        }
+
+        std::memmove(buffer_, buffer_ + aligned_size, tail_size);
+        if (uses_direct_io_) {
+            set_direct_io(false);
+            try {
+                write_at(buffer_, tail_size, file_offset_);
+            } catch (...) {
+                set_direct_io(true);
+                throw;
+            }
+            set_direct_io(true);
+        } else {
+            write_at(buffer_, tail_size, file_offset_);
+        }
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     * \param[in] offset Offset in the file.
+     */
+    void write_at(
+        const unsigned char* data, std::size_t size, std::uint64_t offset) {
+        while (size > 0U) {
+            const ::ssize_t result = ::pwrite(
+                file_, data, size, static_cast<::off_t>(offset));
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Failed to write data to a file.");
+            }
+            data += result;
+            size -= static_cast<std::size_t>(result);
+            offset += static_cast<std::uint64_t>(result);
+        }
+    }
+
+    /*!
+     * \brief Enable or disable `O_DIRECT`.
+     *
+     * \param[in] enabled Whether to enable `O_DIRECT`.
+     */
+    void set_direct_io(bool enabled) {
+        const int flags = ::fcntl(file_, F_GETFL);
+        const int new_flags =
+            enabled ? (flags | O_DIRECT) : (flags & ~O_DIRECT);
+        if (flags < 0 || ::fcntl(file_, F_SETFL, new_flags) != 0) {
+            throw std::runtime_error("Failed to change flags of a file.");
+        }
+    }
+
+    //! File descriptor.
+    int file_{-1};
+
+    //! Whether O_DIRECT is used.
+    bool uses_direct_io_{false};
+
+    //! Allocator of the buffer.
+    aligned_allocator allocator_{direct_io_alignment};
+
+    //! Buffer.
+    unsigned char* buffer_{nullptr};
+
+    //! Size of the buffer.
+    std::size_t buffer_size_;
+
+    //! Size of the data in the buffer.
+    std::size_t current_size_{0U};
+
+    //! Offset in the file of the data in the buffer.
+    std::uint64_t file_offset_{0U};
+};
+
+}  // namespace msgpack_light
@@ -0,0 +1,447 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of fd_output_stream class.
+ *
+ * \note This header can be used only in POSIX environments.
+ */
+#pragma once
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#endif
+
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Enumeration of policies when writing to file descriptors would block
+ * (`EAGAIN`).
+ */
+enum class would_block_policy {
+    //! Wait until the file descriptor becomes writable.
+    wait,
+
+    //! Throw an exception. Data not written is kept in the buffer.
+    fail
+};
+
+/*!
+ * \brief Struct of options of fd_output_stream class.
+ */
+struct fd_output_stream_options {
+    //! Size of the buffer of small writes.
+    std::size_t buffer_size{static_cast<std::size_t>(64U) * 1024U};
+
+    /*!
+     * \brief Minimum size of data written without copying to the buffer.
+     *
+     * Such data is written together with the buffered data using `writev` (or
+     * `sendmsg` for sockets).
+     */
+    std::size_t direct_write_threshold{static_cast<std::size_t>(16U) * 1024U};
+
+    //! Policy when writing would block.
+    would_block_policy on_would_block{would_block_policy::wait};
+
+    /*!
+     * \brief Timeout in milliseconds to wait for file descriptors to become
+     * writable or for completions of sends with `MSG_ZEROCOPY`. (Negative
+     * values for no timeout.)
+     */
+    int wait_timeout_milliseconds{-1};
+
+    /*!
+     * \brief Whether to use `MSG_ZEROCOPY` for large data written to sockets.
+     *
+     * This is ignored when `MSG_ZEROCOPY` isn't supported.
+     */
+    bool use_zerocopy{false};
+
+    //! Minimum size of data sent with `MSG_ZEROCOPY`.
+    std::size_t zerocopy_threshold{static_cast<std::size_t>(64U) * 1024U};
+};
+
+/*!
+ * \brief Class of streams to write data to file descriptors (sockets, pipes,
+ * files, ...).
+ *
+ * Small data is copied to a buffer, and large data is written directly
+ * together with the buffered data in one system call (`writev` or `sendmsg`).
+ * Partial writes are continued until all data is written. When the file
+ * descriptor is non-blocking and writing would block, the policy in the
+ * options is applied.
+ *
+ * \note This class doesn't close the file descriptor.
+ * \note This class can be used only in POSIX environments.
+ */
+class fd_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_descriptor File descriptor.
+     * \param[in] options Options.
+     */
+    explicit fd_output_stream(int file_descriptor,
+        const fd_output_stream_options& options = fd_output_stream_options())
+        : file_(file_descriptor), options_(options) {
+        if (options.buffer_size == 0U) {
+            throw std::invalid_argument("Invalid size of the buffer.");
+        }
+        buffer_.reserve(options.buffer_size);
+
+        int type = 0;
+        ::socklen_t type_size = sizeof(type);
+        is_socket_ = ::getsockopt(
+                         file_, SOL_SOCKET, SO_TYPE, &type, &type_size) == 0;
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+        if (options.use_zerocopy && is_socket_) {
+            const int enabled = 1;
+            uses_zerocopy_ = ::setsockopt(file_, SOL_SOCKET, SO_ZEROCOPY,
+                                 &enabled, sizeof(enabled)) == 0;
+        }
+#endif
+    }
+
+    fd_output_stream(const fd_output_stream&) = delete;
+    fd_output_stream(fd_output_stream&&) = delete;
+    fd_output_stream& operator=(const fd_output_stream&) = delete;
+    fd_output_stream& operator=(fd_output_stream&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * This writes the buffered data if possible.
+     */
+    ~fd_output_stream() {
+        try {
+            flush();
+        } catch (...) {
+            // Errors cannot be reported here.
+        }
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        if (size >= options_.direct_write_threshold) {
+            write_all(data, size);
+            return;
+        }
+        if (options_.buffer_size - buffer_.size() < size) {
+            flush();
+        }
+        buffer_.insert(buffer_.end(), data, data + size);
+    }
+
+    /*!
+     * \brief Write the buffered data.
+     */
+    void flush() {
+        if (!buffer_.empty()) {
+            write_all(nullptr, 0U);
+        }
+    }
+
+    /*!
+     * \brief Get the size of the buffered data.
+     *
+     * \return Size of the buffered data.
+     */
+    [[nodiscard]] std::size_t buffered_size() const noexcept {
+        return buffer_.size();
+    }
+
+    /*!
+     * \brief Check whether `MSG_ZEROCOPY` is used.
+     *
+     * \retval true `MSG_ZEROCOPY` is used.
+     * \retval false `MSG_ZEROCOPY` isn't used.
+     */
+    [[nodiscard]] bool uses_zerocopy() const noexcept {
+        return uses_zerocopy_;
+    }
+
+private:
+    /*!
+     * \brief Write the buffered data and additional data.
+     *
+     * \param[in] data Pointer to the additional data.
+     * \param[in] size Size of the additional data.
+     */
+    void write_all(const unsigned char* data, std::size_t size) {
+        std::array<::iovec, 2> iovecs{};
+        std::size_t num_iovecs = 0U;
+        if (!buffer_.empty()) {
+            iovecs[num_iovecs].iov_base = buffer_.data();
+            iovecs[num_iovecs].iov_len = buffer_.size();
+            ++num_iovecs;
+        }
+        if (size > 0U) {
+            iovecs[num_iovecs].iov_base =
+                const_cast<unsigned char*>(data);  // NOLINT
+            iovecs[num_iovecs].iov_len = size;
+            ++num_iovecs;
+        }
+        const bool zerocopy =
+            uses_zerocopy_ && size >= options_.zerocopy_threshold;
+
+        std::size_t first = 0U;
+        while (first < num_iovecs) {
+            const ::ssize_t result =
+                write_iovecs(iovecs.data() + first, num_iovecs - first,
+                    zerocopy);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    if (options_.on_would_block == would_block_policy::wait) {
+                        wait_until_writable();
+                        continue;
+                    }
+                    if (zerocopy) {
+                        // Data already sent must not be changed until the
+                        // kernel completes sending.
+                        wait_for_zerocopy_completions();
+                    }
+                    keep_unsent_data(iovecs.data() + first,
+                        num_iovecs - first, size > 0U);
+                    throw std::runtime_error(
+                        "Writing to a file descriptor would block.");
+                }
+                throw std::runtime_error(
+                    "Failed to write data to a file descriptor.");
+            }
+            auto written = static_cast<std::size_t>(result);
+            while (first < num_iovecs && written >= iovecs[first].iov_len) {
+                written -= iovecs[first].iov_len;
+                iovecs[first].iov_len = 0U;
+                ++first;
+            }
+            if (first < num_iovecs) {
+                iovecs[first].iov_base =
+                    static_cast<unsigned char*>(iovecs[first].iov_base) +
+                    written;
+                iovecs[first].iov_len -= written;
+            }
+        }
+        buffer_.clear();
+
+        if (zerocopy) {
+            // The data must not be changed until the kernel completes sending.
+            wait_for_zerocopy_completions();
+        }
+    }
+
+    /*!
+     * \brief Write data in iovecs.
+     *
+     * \param[in] iovecs iovecs.
+     * \param[in] num_iovecs Number of iovecs.
+     * \param[in] zerocopy Whether to use `MSG_ZEROCOPY`.
+     * \return Result of the system call.
+     */
+    ::ssize_t write_iovecs(
+        ::iovec* iovecs, std::size_t num_iovecs, bool zerocopy) {
+        if (!is_socket_) {
+            return ::writev(file_, iovecs, static_cast<int>(num_iovecs));
+        }
+        ::msghdr message{};
+        message.msg_iov = iovecs;
+        message.msg_iovlen = num_iovecs;
+        int flags = 0;
+#if defined(MSG_NOSIGNAL)
+        flags |= MSG_NOSIGNAL;
+#endif
+#if defined(MSG_ZEROCOPY)
+        if (zerocopy) {
+            const ::ssize_t result =
+                ::sendmsg(file_, &message, flags | MSG_ZEROCOPY);
+            if (result >= 0) {
+                ++num_zerocopy_sends_;
+                return result;
+            }
+            if (errno != ENOBUFS) {
+                return result;
+            }
+            // Fall back to the normal send when memory for MSG_ZEROCOPY
+            // isn't available.
+        }
+#else
+        (void)zerocopy;
+#endif
+        return ::sendmsg(file_, &message, flags);
+    }
+
+    /*!
+     * \brief Wait until the file descriptor becomes writable.
+     */
+    void wait_until_writable() const {
+        ::pollfd target{};
+        target.fd = file_;
+        target.events = POLLOUT;
+        while (true) {
+            const int result =
+                ::poll(&target, 1U, options_.wait_timeout_milliseconds);
+            if (result > 0) {
+                return;
+            }
+            if (result == 0) {
+                throw std::runtime_error(
+                    "Timeout of writing to a file descriptor.");
+            }
+            if (errno != EINTR) {
+                throw std::runtime_error(
+                    "Failed to wait for a file descriptor.");
+            }
+        }
+    }
+
+    /*!
+     * \brief Keep data not written in the buffer.
+     *
+     * \param[in] iovecs iovecs of the data not written.
+     * \param[in] num_iovecs Number of iovecs.
+     * \param[in] has_additional_data Whether the last iovec is the additional
+     * data.
+     */
+    void keep_unsent_data(const ::iovec* iovecs, std::size_t num_iovecs,
+        bool has_additional_data) {
+        std::size_t num_buffer_iovecs = num_iovecs;
+        if (has_additional_data) {
+            --num_buffer_iovecs;
+        }
+        if (num_buffer_iovecs > 0U) {
+            const auto* begin =
+                static_cast<const unsigned char*>(iovecs[0].iov_base);
+            buffer_.erase(buffer_.begin(),
+                buffer_.begin() + (begin - buffer_.data()));
+        } else {
+            buffer_.clear();
+        }
+        if (has_additional_data) {
+            const ::iovec& last = iovecs[num_iovecs - 1U];
+            const auto* begin =
+                static_cast<const unsigned char*>(last.iov_base);
+            buffer_.insert(buffer_.end(), begin, begin + last.iov_len);
+        }
+    }
+
+    /*!
+     * \brief Wait for completions of sends with `MSG_ZEROCOPY`.
+     */
+    void wait_for_zerocopy_completions() {
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+        while (num_zerocopy_completions_ < num_zerocopy_sends_) {
+            constexpr std::size_t control_size = 128U;
+            std::array<unsigned char, control_size> control{};
+            ::msghdr message{};
+            message.msg_control = control.data();
+            message.msg_controllen = control.size();
+            if (::recvmsg(file_, &message, MSG_ERRQUEUE) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    throw std::runtime_error(
+                        "Failed to receive completions of sends.");
+                }
+                // Wait for notifications in the error queue.
+                ::pollfd target{};
+                target.fd = file_;
+                const int result =
+                    ::poll(&target, 1U, options_.wait_timeout_milliseconds);
+                if (result == 0) {
+                    throw std::runtime_error(
+                        "Timeout of waiting for completions of sends.");
+                }
+                if (result < 0 && errno != EINTR) {
+                    throw std::runtime_error(
+                        "Failed to wait for completions of sends.");
+                }
+                continue;
+            }
+            for (::cmsghdr* header = CMSG_FIRSTHDR(&message);
+                 header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+                const bool is_error =
+                    (header->cmsg_level == SOL_IP &&
+                        header->cmsg_type == IP_RECVERR) ||
+                    (header->cmsg_level == SOL_IPV6 &&
+                        header->cmsg_type == IPV6_RECVERR);
+                if (!is_error) {
+                    continue;
+                }
+                ::sock_extended_err error{};
+                std::memcpy(&error, CMSG_DATA(header), sizeof(error));
+                if (error.ee_errno == 0 &&
+                    error.ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+                    // ee_data is the last ID of completed sends.
+                    const std::uint64_t completed =
+                        static_cast<std::uint64_t>(error.ee_data) + 1U;
+                    if (completed > num_zerocopy_completions_) {
+                        num_zerocopy_completions_ = completed;
+                    }
+                }
+            }
+        }
+#endif
+    }
+
+    //! File descriptor.
+    int file_;
+
+    //! Options.
+    fd_output_stream_options options_;
+
+    //! Buffer.
+    std::vector<unsigned char> buffer_{};
+
+    //! Whether the file descriptor is a socket.
+    bool is_socket_{false};
+
+    //! Whether MSG_ZEROCOPY is used.
+    bool uses_zerocopy_{false};
+
+    //! Number of sends with MSG_ZEROCOPY.
+    std::uint64_t num_zerocopy_sends_{0U};
+
+    //! Number of completed sends with MSG_ZEROCOPY.
+    std::uint64_t num_zerocopy_completions_{0U};
+};
+
+}  // namespace msgpack_light
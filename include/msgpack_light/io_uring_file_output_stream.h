@@ -0,0 +1,624 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of io_uring_file_output_stream class.
+ *
+ * \note This header can be used only in Linux.
+ */
+#pragma once
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Default size of buffers in io_uring_file_output_stream class.
+ */
+constexpr std::size_t default_io_uring_buffer_size =
+    static_cast<std::size_t>(1024U) * 1024U;
+
+/*!
+ * \brief Default number of buffers in io_uring_file_output_stream class.
+ */
+constexpr std::size_t default_io_uring_num_buffers = 4U;
+
+/*!
+ * \brief Class of streams to write data to files using io_uring in Linux.
+ *
+ * Data is copied to buffers registered to io_uring, and filled buffers are
+ * written using fixed-buffer writes (`IORING_OP_WRITE_FIXED`) without
+ * waiting for completion. Writes of all the buffers can be in flight at the
+ * same time, and write() function waits for a completion only when no buffer
+ * is free.
+ *
+ * When io_uring is unavailable (old kernels, disabled by the system, ...),
+ * this class writes buffers using `pwrite` function instead.
+ *
+ * \note This class can be used only in Linux.
+ */
+class io_uring_file_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_path File path.
+     * \param[in] buffer_size Size of each buffer.
+     * \param[in] num_buffers Number of buffers (maximum number of writes in
+     * flight).
+     * \param[in] use_io_uring Whether to use io_uring. If false, `pwrite` is
+     * used.
+     */
+    explicit io_uring_file_output_stream(const char* file_path,
+        std::size_t buffer_size = default_io_uring_buffer_size,
+        std::size_t num_buffers = default_io_uring_num_buffers,
+        bool use_io_uring = true)
+        : buffer_size_(validate_buffer_sizes(buffer_size, num_buffers)),
+          buffers_(buffer_size * num_buffers),
+          buffer_states_(num_buffers) {
+        for (std::size_t i = 1; i < num_buffers; ++i) {
+            free_buffers_.push_back(i);
+        }
+
+        constexpr int permission = 0644;
+        file_ = ::open(file_path,
+            O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,  // NOLINT
+            permission);
+        if (file_ < 0) {
+            throw std::runtime_error(
+                std::string("Failed to open ") + file_path);
+        }
+
+        if (use_io_uring && !setup_ring()) {
+            destroy_ring();
+        }
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_path File path.
+     * \param[in] buffer_size Size of each buffer.
+     * \param[in] num_buffers Number of buffers (maximum number of writes in
+     * flight).
+     * \param[in] use_io_uring Whether to use io_uring. If false, `pwrite` is
+     * used.
+     */
+    explicit io_uring_file_output_stream(const std::string& file_path,
+        std::size_t buffer_size = default_io_uring_buffer_size,
+        std::size_t num_buffers = default_io_uring_num_buffers,
+        bool use_io_uring = true)
+        : io_uring_file_output_stream(
+              file_path.c_str(), buffer_size, num_buffers, use_io_uring) {}
+
+    io_uring_file_output_stream(const io_uring_file_output_stream&) = delete;
+    io_uring_file_output_stream(io_uring_file_output_stream&&) = delete;
+    io_uring_file_output_stream& operator=(
+        const io_uring_file_output_stream&) = delete;
+    io_uring_file_output_stream& operator=(
+        io_uring_file_output_stream&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * This writes the remaining data and closes the file.
+     */
+    ~io_uring_file_output_stream() {
+        try {
+            write_all_buffers();
+        } catch (...) {
+            // Errors cannot be reported here.
+            // Still wait for writes in flight to keep buffers valid.
+            while (num_in_flight_ > 0U && wait_for_completions()) {
+            }
+        }
+        destroy_ring();
+        (void)::close(file_);
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        while (size > 0U) {
+            const std::size_t copied_size =
+                std::min(size, buffer_size_ - current_size_);
+            std::memcpy(buffer_of(current_buffer_) + current_size_, data,
+                copied_size);
+            current_size_ += copied_size;
+            data += copied_size;
+            size -= copied_size;
+            if (current_size_ == buffer_size_) {
+                submit_current_buffer();
+            }
+        }
+    }
+
+    /*!
+     * \brief Write all the data to the file and wait for the data to be
+     * stored in the storage device.
+     */
+    void flush() {
+        write_all_buffers();
+        if (::fsync(file_) != 0) {
+            throw std::runtime_error("Failed to flush data to a file.");
+        }
+    }
+
+    /*!
+     * \brief Check whether io_uring is used.
+     *
+     * \retval true io_uring is used.
+     * \retval false `pwrite` is used.
+     */
+    [[nodiscard]] bool uses_io_uring() const noexcept { return ring_ >= 0; }
+
+private:
+    //! Maximum number of buffers (limit of io_uring).
+    static constexpr std::size_t max_num_buffers = 1024U;
+
+    //! State of a buffer.
+    struct buffer_state {
+        //! Offset in the file.
+        std::uint64_t offset{0U};
+
+        //! Size of the data.
+        std::size_t size{0U};
+    };
+
+    /*!
+     * \brief Validate sizes of buffers.
+     *
+     * \param[in] buffer_size Size of each buffer.
+     * \param[in] num_buffers Number of buffers.
+     * \return Size of each buffer.
+     */
+    [[nodiscard]] static std::size_t validate_buffer_sizes(
+        std::size_t buffer_size, std::size_t num_buffers) {
+        // Limit of io_uring.
+        constexpr std::size_t max_buffer_size = 0x7FFFF000U;
+        if (buffer_size == 0U || buffer_size > max_buffer_size ||
+            num_buffers == 0U || num_buffers > max_num_buffers) {
+            throw std::invalid_argument("Invalid sizes of buffers.");
+        }
+        return buffer_size;
+    }
+
+    /*!
+     * \brief Get the pointer to a buffer.
+     *
+     * \param[in] index Index of the buffer.
+     * \return Pointer to the buffer.
+     */
+    [[nodiscard]] unsigned char* buffer_of(std::size_t index) noexcept {
+        return buffers_.data() + index * buffer_size_;
+    }
+
+    /*!
+     * \brief Write the current buffer and wait for all writes.
+     */
+    void write_all_buffers() {
+        if (current_size_ > 0U) {
+            submit_current_buffer();
+        }
+        while (num_in_flight_ > 0U) {
+            if (!wait_for_completions()) {
+                throw std::runtime_error("Failed to write data to a file.");
+            }
+        }
+        check_error();
+    }
+
+    /*!
+     * \brief Start writing the current buffer and get the next buffer.
+     */
+    void submit_current_buffer() {
+        check_error();
+        buffer_state& state = buffer_states_[current_buffer_];
+        state.offset = file_offset_;
+        state.size = current_size_;
+        file_offset_ += current_size_;
+
+        if (uses_io_uring()) {
+            submit_write(current_buffer_);
+        } else {
+            write_with_pwrite(buffer_of(current_buffer_), state.size,
+                state.offset);
+            free_buffers_.push_back(current_buffer_);
+        }
+
+        while (free_buffers_.empty()) {
+            if (!wait_for_completions()) {
+                throw std::runtime_error("Failed to write data to a file.");
+            }
+            check_error();
+        }
+        current_buffer_ = free_buffers_.back();
+        free_buffers_.pop_back();
+        current_size_ = 0U;
+    }
+
+    /*!
+     * \brief Throw an exception if writing failed.
+     */
+    void check_error() const {
+        if (error_) {
+            throw std::runtime_error("Failed to write data to a file.");
+        }
+    }
+
+    /*!
+     * \brief Write data using `pwrite` function.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     * \param[in] offset Offset in the file.
+     */
+    void write_with_pwrite(
+        const unsigned char* data, std::size_t size, std::uint64_t offset) {
+        while (size > 0U) {
+            const ::ssize_t result = ::pwrite(
+                file_, data, size, static_cast<::off_t>(offset));
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error_ = true;
+                throw std::runtime_error("Failed to write data to a file.");
+            }
+            data += result;
+            size -= static_cast<std::size_t>(result);
+            offset += static_cast<std::uint64_t>(result);
+        }
+    }
+
+    /*!
+     * \brief Set up io_uring.
+     *
+     * \retval true Succeeded.
+     * \retval false Failed.
+     */
+    [[nodiscard]] bool setup_ring() noexcept {
+        ::io_uring_params params{};
+        const auto num_entries = static_cast<unsigned int>(
+            buffer_states_.size());
+        ring_ = static_cast<int>(
+            ::syscall(__NR_io_uring_setup, num_entries, &params));
+        if (ring_ < 0) {
+            return false;
+        }
+
+        sq_ring_size_ =
+            params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+        cq_ring_size_ = params.cq_off.cqes +
+            params.cq_entries * sizeof(::io_uring_cqe);
+        const bool single_mmap =
+            (params.features & IORING_FEAT_SINGLE_MMAP) != 0U;
+        if (single_mmap) {
+            sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+            cq_ring_size_ = sq_ring_size_;
+        }
+        sq_ring_ = map_ring(sq_ring_size_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == nullptr) {
+            return false;
+        }
+        if (single_mmap) {
+            cq_ring_ = sq_ring_;
+        } else {
+            cq_ring_ = map_ring(cq_ring_size_, IORING_OFF_CQ_RING);
+            if (cq_ring_ == nullptr) {
+                return false;
+            }
+        }
+        sqes_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+        sqes_ = static_cast<::io_uring_sqe*>(
+            map_ring(sqes_size_, IORING_OFF_SQES));
+        if (sqes_ == nullptr) {
+            return false;
+        }
+
+        auto* sq_bytes = static_cast<unsigned char*>(sq_ring_);
+        sq_tail_ = reinterpret_cast<unsigned int*>(  // NOLINT
+            sq_bytes + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned int*>(  // NOLINT
+            sq_bytes + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned int*>(  // NOLINT
+            sq_bytes + params.sq_off.array);
+        auto* cq_bytes = static_cast<unsigned char*>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned int*>(  // NOLINT
+            cq_bytes + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned int*>(  // NOLINT
+            cq_bytes + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned int*>(  // NOLINT
+            cq_bytes + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<::io_uring_cqe*>(  // NOLINT
+            cq_bytes + params.cq_off.cqes);
+
+        // A fixed-size array is used to avoid allocation of memory here.
+        std::array<::iovec, max_num_buffers> iovecs{};
+        const std::size_t num_buffers = buffer_states_.size();
+        for (std::size_t i = 0; i < num_buffers; ++i) {
+            iovecs[i].iov_base = buffer_of(i);
+            iovecs[i].iov_len = buffer_size_;
+        }
+        return ::syscall(__NR_io_uring_register, ring_,
+                   IORING_REGISTER_BUFFERS, iovecs.data(),
+                   static_cast<unsigned int>(num_buffers)) == 0;
+    }
+
+    /*!
+     * \brief Map memory of io_uring.
+     *
+     * \param[in] size Size.
+     * \param[in] offset Offset.
+     * \return Pointer to the memory, or null pointer on failure.
+     */
+    [[nodiscard]] void* map_ring(std::size_t size, ::off_t offset) noexcept {
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring_, offset);
+        if (ptr == MAP_FAILED) {  // NOLINT
+            return nullptr;
+        }
+        return ptr;
+    }
+
+    /*!
+     * \brief Destroy io_uring.
+     */
+    void destroy_ring() noexcept {
+        if (sqes_ != nullptr) {
+            (void)::munmap(sqes_, sqes_size_);
+            sqes_ = nullptr;
+        }
+        if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+            (void)::munmap(cq_ring_, cq_ring_size_);
+        }
+        cq_ring_ = nullptr;
+        if (sq_ring_ != nullptr) {
+            (void)::munmap(sq_ring_, sq_ring_size_);
+            sq_ring_ = nullptr;
+        }
+        if (ring_ >= 0) {
+            (void)::close(ring_);
+            ring_ = -1;
+        }
+    }
+
+    /*!
+     * \brief Submit a write of a buffer to io_uring.
+     *
+     * When io_uring is temporarily busy (`EAGAIN` or `EBUSY`), completions of
+     * other writes are processed before retrying, or the buffer is written
+     * using `pwrite` function if no other write is in flight.
+     *
+     * \param[in] index Index of the buffer.
+     */
+    void submit_write(std::size_t index) {
+        while (true) {
+            if (try_submit_write(index)) {
+                return;
+            }
+            if (errno != EAGAIN && errno != EBUSY) {
+                error_ = true;
+                throw std::runtime_error("Failed to write data to a file.");
+            }
+            if (num_in_flight_ == 0U) {
+                const buffer_state& state = buffer_states_[index];
+                write_with_pwrite(buffer_of(index), state.size, state.offset);
+                free_buffers_.push_back(index);
+                return;
+            }
+            if (!wait_for_completions()) {
+                throw std::runtime_error("Failed to write data to a file.");
+            }
+        }
+    }
+
+    /*!
+     * \brief Try to submit a write of a buffer to io_uring.
+     *
+     * \param[in] index Index of the buffer.
+     * \retval true Succeeded.
+     * \retval false Failed. The reason is in `errno`.
+     */
+    [[nodiscard]] bool try_submit_write(std::size_t index) noexcept {
+        const buffer_state& state = buffer_states_[index];
+        // Only this thread writes the tail.
+        const unsigned int tail = *sq_tail_;
+        const unsigned int entry_index = tail & sq_mask_;
+        ::io_uring_sqe& sqe = sqes_[entry_index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_WRITE_FIXED;
+        sqe.fd = file_;
+        sqe.off = state.offset;
+        sqe.addr = reinterpret_cast<std::uint64_t>(  // NOLINT
+            buffer_of(index));
+        sqe.len = static_cast<std::uint32_t>(state.size);
+        sqe.buf_index = static_cast<std::uint16_t>(index);
+        sqe.user_data = static_cast<std::uint64_t>(index);
+        sq_array_[entry_index] = entry_index;
+        __atomic_store_n(sq_tail_, tail + 1U, __ATOMIC_RELEASE);
+
+        while (::syscall(__NR_io_uring_enter, ring_, 1U, 0U, 0U, nullptr,
+                   0U) < 0) {
+            if (errno != EINTR) {
+                // The write is not submitted.
+                __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+                return false;
+            }
+        }
+        ++num_in_flight_;
+        return true;
+    }
+
+    /*!
+     * \brief Wait for at least one completion of writes and process
+     * completions.
+     *
+     * \retval true Succeeded.
+     * \retval false Failed to wait.
+     */
+    [[nodiscard]] bool wait_for_completions() {
+        if (num_in_flight_ == 0U) {
+            return true;
+        }
+        while (::syscall(__NR_io_uring_enter, ring_, 0U, 1U,
+                   IORING_ENTER_GETEVENTS, nullptr, 0U) < 0) {
+            if (errno != EINTR) {
+                error_ = true;
+                return false;
+            }
+        }
+
+        unsigned int head = *cq_head_;
+        const unsigned int tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const ::io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            const auto index = static_cast<std::size_t>(cqe.user_data);
+            const int result = cqe.res;
+            --num_in_flight_;
+            free_buffers_.push_back(index);
+            complete_write(index, result);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    /*!
+     * \brief Process a completion of a write.
+     *
+     * \param[in] index Index of the buffer.
+     * \param[in] result Result of the write.
+     */
+    void complete_write(std::size_t index, int result) noexcept {
+        const buffer_state& state = buffer_states_[index];
+        try {
+            if (result < 0) {
+                if (result == -EINVAL || result == -EOPNOTSUPP ||
+                    result == -EAGAIN || result == -EINTR) {
+                    // Retry without io_uring (unsupported operations, ...).
+                    write_with_pwrite(
+                        buffer_of(index), state.size, state.offset);
+                    return;
+                }
+                error_ = true;
+                return;
+            }
+            const auto written = static_cast<std::size_t>(result);
+            if (written < state.size) {
+                // Write the rest of the data.
+                write_with_pwrite(buffer_of(index) + written,
+                    state.size - written, state.offset + written);
+            }
+        } catch (...) {
+            error_ = true;
+        }
+    }
+
+    //! File descriptor.
+    int file_{-1};
+
+    //! Size of each buffer.
+    std::size_t buffer_size_;
+
+    //! Memory of buffers.
+    std::vector<unsigned char> buffers_;
+
+    //! States of buffers.
+    std::vector<buffer_state> buffer_states_;
+
+    //! Indices of free buffers.
+    std::vector<std::size_t> free_buffers_{};
+
+    //! Index of the buffer being filled.
+    std::size_t current_buffer_{0U};
+
+    //! Size of the data in the current buffer.
+    std::size_t current_size_{0U};
+
+    //! Offset in the file of the current buffer.
+    std::uint64_t file_offset_{0U};
+
+    //! Number of writes in flight.
+    std::size_t num_in_flight_{0U};
+
+    //! Whether an error occurred.
+    bool error_{false};
+
+    //! File descriptor of io_uring. (Negative if io_uring isn't used.)
+    int ring_{-1};
+
+    //! Memory of the submission queue.
+    void* sq_ring_{nullptr};
+
+    //! Size of the memory of the submission queue.
+    std::size_t sq_ring_size_{0U};
+
+    //! Memory of the completion queue.
+    void* cq_ring_{nullptr};
+
+    //! Size of the memory of the completion queue.
+    std::size_t cq_ring_size_{0U};
+
+    //! Submission queue entries.
+    ::io_uring_sqe* sqes_{nullptr};
+
+    //! Size of the memory of the submission queue entries.
+    std::size_t sqes_size_{0U};
+
+    //! Tail of the submission queue.
+    unsigned int* sq_tail_{nullptr};
+
+    //! Mask of indices in the submission queue.
+    unsigned int sq_mask_{0U};
+
+    //! Array of indices in the submission queue.
+    unsigned int* sq_array_{nullptr};
+
+    //! Head of the completion queue.
+    unsigned int* cq_head_{nullptr};
+
+    //! Tail of the completion queue.
+    unsigned int* cq_tail_{nullptr};
+
+    //! Mask of indices in the completion queue.
+    unsigned int cq_mask_{0U};
+
+    //! Completion queue entries.
+    ::io_uring_cqe* cqes_{nullptr};
+};
+
+}  // namespace msgpack_light
@@ -19,23 +19,43 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <utility>
 
 #include "msgpack_light/binary.h"
 #include "msgpack_light/details/static_memory_buffer_size.h"
 #include "msgpack_light/output_stream.h"
+#include "msgpack_light/standard_allocator.h"
 
 namespace msgpack_light {
 
 /*!
  * \brief Class of streams to write data to memory.
+ *
+ * \tparam Allocator Type of the allocator. (Same as allocators in
+ * msgpack_light::object class.)
  */
-class memory_output_stream final : public output_stream {
+template <typename Allocator = standard_allocator>
+class basic_memory_output_stream final : public output_stream {
 public:
+    //! Type of the allocator.
+    using allocator_type = Allocator;
+
+    /*!
+     * \brief Constructor.
+     */
+    basic_memory_output_stream() : basic_memory_output_stream(Allocator()) {}
+
     /*!
      * \brief Constructor.
+     *
+     * \param[in] allocator Allocator.
      */
-    memory_output_stream() { buffer_.reserve(initial_buffer_size); }
+    explicit basic_memory_output_stream(Allocator allocator)
+        : buffer_(initial_buffer_size, std::move(allocator)) {
+        buffer_.resize(0U);
+    }
 
     /*!
      * \brief Write data.
@@ -44,6 +64,12 @@ public:
      * \param[in] size Size of the data.
      */
     void write(const unsigned char* data, std::size_t size) override {
+        if (buffer_.capacity() - buffer_.size() < size &&
+            buffer_.capacity() < initial_buffer_size) {
+            // Allocate the buffer released by release function.
+            buffer_.reserve(
+                std::max(initial_buffer_size, buffer_.size() + size));
+        }
         buffer_.append(data, size);
     }
 
@@ -52,6 +78,20 @@ public:
      */
     void clear() { buffer_.resize(0U); }
 
+    /*!
+     * \brief Release the written data without copying.
+     *
+     * After this function, this stream is empty, and a new buffer is
+     * allocated in the next write.
+     *
+     * \return Written data.
+     */
+    [[nodiscard]] basic_binary<Allocator> release() {
+        basic_binary<Allocator> data = std::move(buffer_);
+        buffer_ = basic_binary<Allocator>(data.get_allocator());
+        return data;
+    }
+
     /*!
      * \brief Get the pointer to the written data.
      *
@@ -68,12 +108,23 @@ public:
      */
     [[nodiscard]] std::size_t size() const noexcept { return buffer_.size(); }
 
+    /*!
+     * \brief Get the size of the internal buffer.
+     *
+     * \return Size of the internal buffer.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return buffer_.capacity();
+    }
+
     /*!
      * \brief Get the data as msgpack_light::binary instance.
      *
      * \return Data.
      */
-    [[nodiscard]] const binary& as_binary() const { return buffer_; }
+    [[nodiscard]] const basic_binary<Allocator>& as_binary() const {
+        return buffer_;
+    }
 
 private:
     //! Size of the initial buffer.
@@ -82,7 +133,13 @@ private:
     static_assert(initial_buffer_size > details::static_memory_buffer_size);
 
     //! Buffer.
-    binary buffer_{};
+    basic_binary<Allocator> buffer_;
 };
 
+/*!
+ * \brief Class of streams to write data to memory using
+ * msgpack_light::standard_allocator.
+ */
+using memory_output_stream = basic_memory_output_stream<standard_allocator>;
+
 }  // namespace msgpack_light
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of mmap_output_stream class.
+ *
+ * \note This header can be used only in Linux.
+ */
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "msgpack_light/output_stream.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Default initial capacity of files in mmap_output_stream class.
+ */
+constexpr std::size_t default_mmap_initial_capacity =
+    static_cast<std::size_t>(1024U) * 1024U;
+
+/*!
+ * \brief Class of streams to write data to files mapped to memory in Linux.
+ *
+ * Data is written directly to the memory mapped to the file. When the file is
+ * full, the file is extended to twice its size and mapped again. The file is
+ * truncated to the size of the written data in the destructor.
+ *
+ * Data can also be written in place using reserve() and commit() functions:
+ *
+ * \code
+ * unsigned char* ptr = stream.reserve(max_size);
+ * // Write data of written_size bytes to ptr.
+ * stream.commit(written_size);
+ * \endcode
+ *
+ * \note This class can be used only in Linux.
+ */
+class mmap_output_stream final : public output_stream {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_path File path.
+     * \param[in] initial_capacity Initial capacity of the file.
+     */
+    explicit mmap_output_stream(const char* file_path,
+        std::size_t initial_capacity = default_mmap_initial_capacity) {
+        if (initial_capacity == 0U) {
+            throw std::invalid_argument("Invalid capacity.");
+        }
+        constexpr int permission = 0644;
+        file_ = ::open(file_path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+            permission);
+        if (file_ < 0) {
+            throw std::runtime_error(
+                std::string("Failed to open ") + file_path);
+        }
+        if (::ftruncate(file_, static_cast<::off_t>(initial_capacity)) != 0) {
+            (void)::close(file_);
+            throw std::runtime_error("Failed to extend a file.");
+        }
+        void* data = ::mmap(nullptr, initial_capacity, PROT_READ | PROT_WRITE,
+            MAP_SHARED, file_, 0);
+        if (data == MAP_FAILED) {  // NOLINT
+            (void)::close(file_);
+            throw std::runtime_error("Failed to map a file to memory.");
+        }
+        data_ = static_cast<unsigned char*>(data);
+        capacity_ = initial_capacity;
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] file_path File path.
+     * \param[in] initial_capacity Initial capacity of the file.
+     */
+    explicit mmap_output_stream(const std::string& file_path,
+        std::size_t initial_capacity = default_mmap_initial_capacity)
+        : mmap_output_stream(file_path.c_str(), initial_capacity) {}
+
+    mmap_output_stream(const mmap_output_stream&) = delete;
+    mmap_output_stream(mmap_output_stream&&) = delete;
+    mmap_output_stream& operator=(const mmap_output_stream&) = delete;
+    mmap_output_stream& operator=(mmap_output_stream&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * This truncates the file to the size of the written data and closes the
+     * file.
+     */
+    ~mmap_output_stream() {
+        (void)::munmap(data_, capacity_);
+        (void)::ftruncate(file_, static_cast<::off_t>(size_));
+        (void)::close(file_);
+    }
+
+    /*!
+     * \brief Write data.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    void write(const unsigned char* data, std::size_t size) override {
+        std::memcpy(reserve(size), data, size);
+        size_ += size;
+    }
+
+    /*!
+     * \brief Reserve memory to write data in place.
+     *
+     * \warning The returned pointer is invalidated by the following calls of
+     * functions writing data.
+     *
+     * \param[in] size Size of the memory.
+     * \return Pointer to the memory.
+     */
+    [[nodiscard]] unsigned char* reserve(std::size_t size) {
+        if (capacity_ - size_ < size) {
+            grow(size);
+        }
+        return data_ + size_;
+    }
+
+    /*!
+     * \brief Commit data written in the memory returned by reserve()
+     * function.
+     *
+     * \param[in] size Size of the written data. This must not be larger than
+     * the size of the reserved memory.
+     */
+    void commit(std::size_t size) {
+        if (capacity_ - size_ < size) {
+            throw std::out_of_range("Committed size is too large.");
+        }
+        size_ += size;
+    }
+
+    /*!
+     * \brief Wait for the written data to be stored in the storage device.
+     */
+    void flush() {
+        if (::msync(data_, capacity_, MS_SYNC) != 0) {
+            throw std::runtime_error("Failed to flush data to a file.");
+        }
+    }
+
+    /*!
+     * \brief Get the pointer to the written data.
+     *
+     * \return Pointer to the written data.
+     */
+    [[nodiscard]] const unsigned char* data() const noexcept { return data_; }
+
+    /*!
+     * \brief Get the size of the written data.
+     *
+     * \return Size of the written data.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /*!
+     * \brief Get the current capacity of the file.
+     *
+     * \return Capacity.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    /*!
+     * \brief Extend the file.
+     *
+     * \param[in] size Size of the data to write after extension.
+     */
+    void grow(std::size_t size) {
+        if (size > static_cast<std::size_t>(-1) / 2U - size_) {
+            throw std::runtime_error("Size is too large.");
+        }
+        std::size_t new_capacity = capacity_ * 2U;
+        if (new_capacity < size_ + size) {
+            new_capacity = size_ + size;
+        }
+        if (::ftruncate(file_, static_cast<::off_t>(new_capacity)) != 0) {
+            throw std::runtime_error("Failed to extend a file.");
+        }
+        void* data = ::mremap(data_, capacity_, new_capacity, MREMAP_MAYMOVE);
+        if (data == MAP_FAILED) {  // NOLINT
+            throw std::runtime_error("Failed to map a file to memory.");
+        }
+        data_ = static_cast<unsigned char*>(data);
+        capacity_ = new_capacity;
+    }
+
+    //! File descriptor.
+    int file_{-1};
+
+    //! Mapped memory.
+    unsigned char* data_{nullptr};
+
+    //! Size of the written data.
+    std::size_t size_{0U};
+
+    //! Capacity of the file.
+    std::size_t capacity_{0U};
+};
+
+}  // namespace msgpack_light
@@ -19,8 +19,6 @@
  */
 #pragma once
 
-#include <cstring>
-
 #include "msgpack_light/details/allocator_wrapper.h"    // IWYU pragma: export
 #include "msgpack_light/details/array_iterator.h"       // IWYU pragma: export
 #include "msgpack_light/details/array_iterator_impl.h"  // IWYU pragma: export
@@ -87,7 +85,7 @@ public:
      */
     object(object&& other) noexcept
         : data_(other.data_), allocator_(std::move(other.allocator_)) {
-        std::memset(&other.data_, 0, sizeof(other.data_));
+        details::fill_with_nil(&other.data_, 1U);
     }
 
     /*!
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of parallel_serialize function.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/details/parallel_for.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/output_stream.h"
+#include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/type_support/array.h"   // IWYU pragma: export
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: export
+
+namespace msgpack_light {
+
+/*!
+ * \brief Struct of options of parallel serialization.
+ */
+struct parallel_serialization_options {
+    //! Number of threads. (0 for the number of hardware threads.)
+    std::size_t num_threads{0U};
+
+    /*!
+     * \brief Minimum number of elements in a chunk.
+     *
+     * Containers with elements less than twice of this number are serialized
+     * in the current thread.
+     */
+    std::size_t min_chunk_size{static_cast<std::size_t>(4096U)};
+
+    //! Number of chunks per thread used to balance loads of threads.
+    std::size_t chunks_per_thread{4U};
+};
+
+namespace details {
+
+/*!
+ * \brief Serialize chunks of elements in parallel.
+ *
+ * \tparam T Type of elements.
+ * \param[in] elements Pointer to the elements.
+ * \param[in] size Number of the elements.
+ * \param[in] parallel_options Options of parallel serialization.
+ * \param[in] options Options of serialization.
+ * \return Streams of the serialized chunks. (Empty if elements should be
+ * serialized in the current thread.)
+ */
+template <typename T>
+[[nodiscard]] inline std::vector<memory_output_stream>
+serialize_chunks_in_parallel(const T* elements, std::size_t size,
+    const parallel_serialization_options& parallel_options,
+    const serialization_options& options) {
+    const std::size_t num_threads =
+        resolve_num_threads(parallel_options.num_threads);
+    const std::size_t min_chunk_size =
+        std::max<std::size_t>(parallel_options.min_chunk_size, 1U);
+    const std::size_t num_chunks = std::min(size / min_chunk_size,
+        num_threads * std::max<std::size_t>(parallel_options.chunks_per_thread,
+                          1U));
+    if (num_threads < 2U || num_chunks < 2U) {
+        return std::vector<memory_output_stream>();
+    }
+
+    std::vector<memory_output_stream> chunks(num_chunks);
+    parallel_for(num_chunks, num_threads, [&](std::size_t chunk) {
+        const std::size_t begin = size * chunk / num_chunks;
+        const std::size_t end = size * (chunk + 1U) / num_chunks;
+        serialization_buffer buffer(chunks[chunk], options);
+        for (std::size_t i = begin; i < end; ++i) {
+            buffer.serialize(elements[i]);
+        }
+        buffer.flush();
+    });
+    return chunks;
+}
+
+/*!
+ * \brief Check whether a type is a container serialized as an array which can
+ * be serialized in parallel.
+ *
+ * \tparam Container Type of the container.
+ */
+template <typename Container>
+struct is_parallel_serializable_container : std::false_type {};
+
+/*!
+ * \brief Check whether a type is a container serialized as an array which can
+ * be serialized in parallel.
+ *
+ * \tparam T Type of elements.
+ * \tparam Allocator Type of the allocator.
+ *
+ * \note Vectors of unsigned char are serialized as binaries.
+ */
+template <typename T, typename Allocator>
+struct is_parallel_serializable_container<std::vector<T, Allocator>>
+    : std::bool_constant<!std::is_same_v<T, unsigned char>> {};
+
+/*!
+ * \brief Check whether a type is a container serialized as an array which can
+ * be serialized in parallel.
+ *
+ * \tparam T Type of elements.
+ * \tparam N Number of elements.
+ */
+template <typename T, std::size_t N>
+struct is_parallel_serializable_container<std::array<T, N>> : std::true_type {
+};
+
+/*!
+ * \brief Check whether a type is a container serialized as an array which can
+ * be serialized in parallel.
+ *
+ * \tparam Container Type of the container.
+ */
+template <typename Container>
+constexpr bool is_parallel_serializable_container_v =
+    is_parallel_serializable_container<Container>::value;
+
+/*!
+ * \brief Check the type of containers for parallel serialization.
+ *
+ * \tparam Container Type of the container.
+ */
+template <typename Container>
+inline void check_parallel_serializable_container() {
+    static_assert(is_parallel_serializable_container_v<Container>,
+        "Only std::vector and std::array serialized as arrays can be "
+        "serialized in parallel.");
+}
+
+}  // namespace details
+
+/*!
+ * \brief Serialize an array in a contiguous container in parallel to an
+ * output stream.
+ *
+ * Elements are split into chunks, and each chunk is serialized into its own
+ * buffer in worker threads. Then the size of the array and the chunks are
+ * written to the stream in order without concatenation.
+ * The result is the same as msgpack_light::serialize_to function.
+ *
+ * \tparam Container Type of the container (`std::vector` or `std::array`).
+ * \param[out] stream Stream to write serialized data.
+ * \param[in] data Container.
+ * \param[in] parallel_options Options of parallel serialization.
+ * \param[in] options Options of serialization.
+ */
+template <typename Container>
+inline void parallel_serialize_to(output_stream& stream, const Container& data,
+    const parallel_serialization_options& parallel_options =
+        parallel_serialization_options(),
+    const serialization_options& options = serialization_options()) {
+    details::check_parallel_serializable_container<Container>();
+    const auto* elements = std::data(data);
+    const std::size_t size = std::size(data);
+
+    serialization_buffer buffer(stream, options);
+    buffer.serialize_array_size(size);
+    auto chunks = details::serialize_chunks_in_parallel(
+        elements, size, parallel_options, options);
+    if (chunks.empty()) {
+        for (std::size_t i = 0; i < size; ++i) {
+            buffer.serialize(elements[i]);
+        }
+        buffer.flush();
+        return;
+    }
+    buffer.flush();
+    for (const auto& chunk : chunks) {
+        stream.write(chunk.data(), chunk.size());
+    }
+}
+
+/*!
+ * \brief Serialize an array in a contiguous container in parallel and return
+ * the resulting binary data.
+ *
+ * The result is the same as msgpack_light::serialize function.
+ *
+ * \tparam Container Type of the container (`std::vector` or `std::array`).
+ * \param[in] data Container.
+ * \param[in] parallel_options Options of parallel serialization.
+ * \param[in] options Options of serialization.
+ * \return Serialized binary data.
+ */
+template <typename Container>
+[[nodiscard]] inline binary parallel_serialize(const Container& data,
+    const parallel_serialization_options& parallel_options =
+        parallel_serialization_options(),
+    const serialization_options& options = serialization_options()) {
+    details::check_parallel_serializable_container<Container>();
+    const auto* elements = std::data(data);
+    const std::size_t size = std::size(data);
+
+    memory_output_stream header;
+    {
+        serialization_buffer buffer(header, options);
+        buffer.serialize_array_size(size);
+        buffer.flush();
+    }
+    auto chunks = details::serialize_chunks_in_parallel(
+        elements, size, parallel_options, options);
+    if (chunks.empty()) {
+        serialization_buffer buffer(header, options);
+        for (std::size_t i = 0; i < size; ++i) {
+            buffer.serialize(elements[i]);
+        }
+        buffer.flush();
+        return header.release();
+    }
+
+    std::size_t total_size = header.size();
+    for (const auto& chunk : chunks) {
+        total_size += chunk.size();
+    }
+    binary result(total_size);
+    std::memcpy(result.data(), header.data(), header.size());
+    std::size_t position = header.size();
+    for (const auto& chunk : chunks) {
+        std::memcpy(result.data() + position, chunk.data(), chunk.size());
+        position += chunk.size();
+    }
+    return result;
+}
+
+}  // namespace msgpack_light
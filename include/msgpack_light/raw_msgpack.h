@@ -0,0 +1,205 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of raw_msgpack class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/details/msgpack_object_size.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class to refer data already serialized in MessagePack.
+ *
+ * Serialization of instances of this class writes the data without any
+ * conversion, so already serialized data can be embedded in other data.
+ *
+ * \note This class doesn't manage memory of data as binary_view.
+ *
+ * \warning The data must be exactly one object in MessagePack.
+ * This is checked only in debug builds or when validate() function is called.
+ */
+class raw_msgpack {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * Create empty data.
+     *
+     * \note Empty data is not a valid object in MessagePack.
+     */
+    raw_msgpack() noexcept = default;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Pointer to the data.
+     * \param[in] size Size of the data.
+     */
+    raw_msgpack(const unsigned char* data, std::size_t size) noexcept
+        : data_(data, size) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Data.
+     */
+    explicit raw_msgpack(binary_view data) noexcept : data_(data) {}
+
+    /*!
+     * \brief Get the pointer to the data.
+     *
+     * \return Pointer to the data.
+     */
+    [[nodiscard]] const unsigned char* data() const noexcept {
+        return data_.data();
+    }
+
+    /*!
+     * \brief Get the size of the data.
+     *
+     * \return Size of the data.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return data_.size(); }
+
+    /*!
+     * \brief Get the data as msgpack_light::binary_view instance.
+     *
+     * \return Data.
+     */
+    [[nodiscard]] binary_view as_binary_view() const noexcept { return data_; }
+
+    /*!
+     * \brief Check whether the data is exactly one valid object in
+     * MessagePack.
+     *
+     * \retval true The data is valid.
+     * \retval false The data is invalid.
+     */
+    [[nodiscard]] bool is_valid() const noexcept {
+        try {
+            return details::msgpack_object_size(data_.data(), data_.size()) ==
+                data_.size();
+        } catch (const std::runtime_error& /*error*/) {
+            return false;
+        }
+    }
+
+    /*!
+     * \brief Check that the data is exactly one valid object in MessagePack.
+     *
+     * \note This function throws an exception for invalid data.
+     */
+    void validate() const {
+        if (details::msgpack_object_size(data_.data(), data_.size()) !=
+            data_.size()) {
+            throw std::runtime_error(
+                "Data has bytes after an object in MessagePack.");
+        }
+    }
+
+private:
+    //! Data.
+    binary_view data_{};
+};
+
+/*!
+ * \brief Class to refer a list of key-value pairs already serialized in
+ * MessagePack.
+ *
+ * Serialization of instances of this class writes a map with the given keys and
+ * values. Keys and values are written without any conversion.
+ *
+ * \note This class doesn't manage memory of the list as binary_view.
+ */
+class raw_msgpack_map {
+public:
+    //! Type of key-value pairs.
+    using value_type = std::pair<raw_msgpack, raw_msgpack>;
+
+    /*!
+     * \brief Constructor.
+     *
+     * Create an empty map.
+     */
+    raw_msgpack_map() noexcept = default;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Pointer to the key-value pairs.
+     * \param[in] size Number of the key-value pairs.
+     */
+    raw_msgpack_map(const value_type* data, std::size_t size) noexcept
+        : data_(data), size_(size) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \tparam Container Type of the container of key-value pairs.
+     * (`std::vector<std::pair<raw_msgpack, raw_msgpack>>`, ...)
+     * \param[in] pairs Container of key-value pairs.
+     */
+    template <typename Container>
+    explicit raw_msgpack_map(const Container& pairs) noexcept
+        : raw_msgpack_map(pairs.data(), pairs.size()) {}
+
+    /*!
+     * \brief Get the pointer to the key-value pairs.
+     *
+     * \return Pointer to the key-value pairs.
+     */
+    [[nodiscard]] const value_type* data() const noexcept { return data_; }
+
+    /*!
+     * \brief Get the number of the key-value pairs.
+     *
+     * \return Number of the key-value pairs.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /*!
+     * \brief Get an iterator to the first key-value pair.
+     *
+     * \return Iterator.
+     */
+    [[nodiscard]] const value_type* begin() const noexcept { return data_; }
+
+    /*!
+     * \brief Get an iterator to the past-the-end key-value pair.
+     *
+     * \return Iterator.
+     */
+    [[nodiscard]] const value_type* end() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    //! Key-value pairs.
+    const value_type* data_{nullptr};
+
+    //! Number of the key-value pairs.
+    std::size_t size_{0U};
+};
+
+}  // namespace msgpack_light
@@ -0,0 +1,370 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of record_log_reader class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/record_log_writer.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class to read record logs written by record_log_writer class.
+ *
+ * Records are found using the index in the log, so access to a record
+ * requires reading at most `index_interval` sizes of records regardless of
+ * the size of the log.
+ *
+ * Logs without the index and the footer, written by record_log_writer
+ * objects which were not finished, can be read using recover() function.
+ *
+ * \note This class doesn't manage the memory of the log. To read large files,
+ * map them to memory (using `mmap` function, for example).
+ */
+class record_log_reader {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \note This function throws exceptions for invalid logs.
+     *
+     * \param[in] data Pointer to the log.
+     * \param[in] size Size of the log.
+     */
+    record_log_reader(const unsigned char* data, std::size_t size)
+        : data_(data) {
+        if (!read_footer(size)) {
+            throw std::runtime_error("Invalid record log.");
+        }
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \note This function throws exceptions for invalid logs.
+     *
+     * \param[in] data Log.
+     */
+    explicit record_log_reader(binary_view data)
+        : record_log_reader(data.data(), data.size()) {}
+
+    /*!
+     * \brief Read a log which may not have the index and the footer.
+     *
+     * If the log has a valid footer, this function is the same as the
+     * constructor. Otherwise, this function scans sizes of records from the
+     * beginning of the log and builds an index in memory. Records after the
+     * last complete record are ignored.
+     *
+     * \param[in] data Pointer to the log.
+     * \param[in] size Size of the log.
+     * \param[in] index_interval Number of records per entry of the index
+     * built in memory.
+     * \return Reader.
+     */
+    [[nodiscard]] static record_log_reader recover(const unsigned char* data,
+        std::size_t size,
+        std::uint32_t index_interval = default_record_log_index_interval) {
+        if (index_interval == 0U) {
+            throw std::invalid_argument("Invalid interval of indices.");
+        }
+        record_log_reader reader{data};
+        if (!reader.read_footer(size)) {
+            reader.scan_records(size, index_interval);
+        }
+        return reader;
+    }
+
+    /*!
+     * \brief Read a log which may not have the index and the footer.
+     *
+     * \param[in] data Log.
+     * \param[in] index_interval Number of records per entry of the index
+     * built in memory.
+     * \return Reader.
+     */
+    [[nodiscard]] static record_log_reader recover(binary_view data,
+        std::uint32_t index_interval = default_record_log_index_interval) {
+        return recover(data.data(), data.size(), index_interval);
+    }
+
+    /*!
+     * \brief Check whether records were found by scanning the log
+     * without the footer.
+     *
+     * \retval true Records were found by scanning the log.
+     * \retval false Records were found using the index in the log.
+     */
+    [[nodiscard]] bool is_recovered() const noexcept { return is_recovered_; }
+
+    /*!
+     * \brief Get the number of records.
+     *
+     * \return Number of records.
+     */
+    [[nodiscard]] std::uint64_t num_records() const noexcept {
+        return num_records_;
+    }
+
+    /*!
+     * \brief Get the number of records per entry of the index.
+     *
+     * \return Number of records per entry of the index.
+     */
+    [[nodiscard]] std::uint32_t index_interval() const noexcept {
+        return index_interval_;
+    }
+
+    /*!
+     * \brief Get a record.
+     *
+     * \note This function throws exceptions for invalid logs.
+     *
+     * \param[in] index Index of the record.
+     * \return Data of the record.
+     */
+    [[nodiscard]] binary_view record(std::uint64_t index) const {
+        if (index >= num_records_) {
+            throw std::out_of_range("Index of a record is out of range.");
+        }
+        binary_view result;
+        (void)read_record(offset_of(index), result);
+        return result;
+    }
+
+    /*!
+     * \brief Get the record at an index.
+     *
+     * \param[in] index Index of the record.
+     * \return Data of the record.
+     */
+    [[nodiscard]] binary_view operator[](std::uint64_t index) const {
+        return record(index);
+    }
+
+    /*!
+     * \brief Call a function for records in a range.
+     *
+     * \note This function throws exceptions for invalid logs.
+     *
+     * \tparam Function Type of the function.
+     * \param[in] begin Index of the first record.
+     * \param[in] end Index of the past-the-end record.
+     * \param[in] function Function called with data of each record
+     * (msgpack_light::binary_view instance) in the order of records.
+     */
+    template <typename Function>
+    void for_each_record(
+        std::uint64_t begin, std::uint64_t end, Function&& function) const {
+        if (begin > end || end > num_records_) {
+            throw std::out_of_range("Indices of records are out of range.");
+        }
+        if (begin == end) {
+            return;
+        }
+        std::size_t offset = offset_of(begin);
+        binary_view record_data;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            offset = read_record(offset, record_data);
+            function(record_data);
+        }
+    }
+
+private:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Pointer to the log.
+     */
+    explicit record_log_reader(const unsigned char* data) noexcept
+        : data_(data) {}
+
+    /*!
+     * \brief Read the footer.
+     *
+     * \param[in] size Size of the log.
+     * \retval true The footer is valid.
+     * \retval false The footer is invalid.
+     */
+    [[nodiscard]] bool read_footer(std::size_t size) noexcept {
+        if (size < record_log_footer_size + record_log_length_size) {
+            return false;
+        }
+        const unsigned char* footer = data_ + size - record_log_footer_size;
+        constexpr std::size_t index_offset_position = 8U;
+        constexpr std::size_t index_interval_position = 16U;
+        constexpr std::size_t magic_position = 20U;
+        for (std::size_t i = 0; i < record_log_magic.size(); ++i) {
+            if (footer[magic_position + i] != record_log_magic[i]) {
+                return false;
+            }
+        }
+        const auto num_records = read_big_endian<std::uint64_t>(footer);
+        const auto index_offset = read_big_endian<std::uint64_t>(
+            footer + index_offset_position);
+        const auto index_interval = read_big_endian<std::uint32_t>(
+            footer + index_interval_position);
+        if (index_interval == 0U) {
+            return false;
+        }
+
+        const std::uint64_t index_size = num_records / index_interval +
+            (num_records % index_interval != 0U ? 1U : 0U);
+        const std::uint64_t index_end = size - record_log_footer_size;
+        if (index_offset < record_log_length_size ||
+            index_offset > index_end ||
+            (index_end - index_offset) / sizeof(std::uint64_t) != index_size ||
+            (index_end - index_offset) % sizeof(std::uint64_t) != 0U) {
+            return false;
+        }
+        const auto records_size =
+            static_cast<std::size_t>(index_offset) - record_log_length_size;
+        if (read_big_endian<std::uint32_t>(data_ + records_size) !=
+            record_log_index_marker) {
+            return false;
+        }
+        num_records_ = num_records;
+        index_interval_ = index_interval;
+        records_size_ = records_size;
+        index_ = data_ + index_offset;
+        return true;
+    }
+
+    /*!
+     * \brief Scan records and build the index in memory.
+     *
+     * \param[in] size Size of the log.
+     * \param[in] index_interval Number of records per entry of the index.
+     */
+    void scan_records(std::size_t size, std::uint32_t index_interval) {
+        is_recovered_ = true;
+        index_interval_ = index_interval;
+        num_records_ = 0U;
+        std::size_t offset = 0U;
+        while (size - offset >= record_log_length_size) {
+            const std::uint32_t record_size =
+                read_big_endian<std::uint32_t>(data_ + offset);
+            if (record_size == record_log_index_marker ||
+                size - offset - record_log_length_size < record_size) {
+                break;
+            }
+            if (num_records_ % index_interval == 0U) {
+                recovered_index_.push_back(offset);
+            }
+            offset += record_log_length_size + record_size;
+            ++num_records_;
+        }
+        records_size_ = offset;
+    }
+
+    /*!
+     * \brief Get the offset of a record.
+     *
+     * \param[in] index Index of the record.
+     * \return Offset.
+     */
+    [[nodiscard]] std::size_t offset_of(std::uint64_t index) const {
+        const std::uint64_t entry = index / index_interval_;
+        std::uint64_t offset = 0U;
+        if (is_recovered_) {
+            offset = recovered_index_[static_cast<std::size_t>(entry)];
+        } else {
+            offset = read_big_endian<std::uint64_t>(index_ +
+                static_cast<std::size_t>(entry) * sizeof(std::uint64_t));
+        }
+        if (offset > records_size_) {
+            throw std::runtime_error("Invalid record log.");
+        }
+        binary_view skipped;
+        for (std::uint64_t i = entry * index_interval_; i < index; ++i) {
+            offset = read_record(static_cast<std::size_t>(offset), skipped);
+        }
+        return static_cast<std::size_t>(offset);
+    }
+
+    /*!
+     * \brief Read a record.
+     *
+     * \param[in] offset Offset of the record.
+     * \param[out] record_data Data of the record.
+     * \return Offset of the next record.
+     */
+    [[nodiscard]] std::size_t read_record(
+        std::size_t offset, binary_view& record_data) const {
+        if (records_size_ - offset < record_log_length_size) {
+            throw std::runtime_error("Invalid record log.");
+        }
+        const auto size =
+            static_cast<std::size_t>(read_big_endian<std::uint32_t>(
+                data_ + offset));
+        offset += record_log_length_size;
+        if (records_size_ - offset < size) {
+            throw std::runtime_error("Invalid record log.");
+        }
+        record_data = binary_view(data_ + offset, size);
+        return offset + size;
+    }
+
+    /*!
+     * \brief Read an integer in big endian.
+     *
+     * \tparam T Type of the integer.
+     * \param[in] input Pointer to the input.
+     * \return Value.
+     */
+    template <typename T>
+    [[nodiscard]] static T read_big_endian(
+        const unsigned char* input) noexcept {
+        constexpr unsigned int bits_per_byte = 8U;
+        T value = 0U;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            value = static_cast<T>(value << bits_per_byte);
+            value |= static_cast<T>(input[i]);
+        }
+        return value;
+    }
+
+    //! Pointer to the log.
+    const unsigned char* data_;
+
+    //! Size of records in the log.
+    std::size_t records_size_{0U};
+
+    //! Pointer to the index.
+    const unsigned char* index_{nullptr};
+
+    //! Number of records.
+    std::uint64_t num_records_{0U};
+
+    //! Number of records per entry of the index.
+    std::uint32_t index_interval_{0U};
+
+    //! Index built by scanning records.
+    std::vector<std::uint64_t> recovered_index_{};
+
+    //! Whether records were found by scanning the log.
+    bool is_recovered_{false};
+};
+
+}  // namespace msgpack_light
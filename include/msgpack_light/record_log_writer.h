@@ -0,0 +1,246 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of record_log_writer class.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/output_stream.h"
+#include "msgpack_light/serialize.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Default number of records per entry of indices in record logs.
+ */
+constexpr std::uint32_t default_record_log_index_interval = 1024U;
+
+/*!
+ * \brief Magic number at the end of record logs ("MPRL").
+ */
+constexpr std::array<unsigned char, 4U> record_log_magic = {
+    0x4D, 0x50, 0x52, 0x4C};  // NOLINT(readability-magic-numbers)
+
+/*!
+ * \brief Size of footers of record logs.
+ */
+constexpr std::size_t record_log_footer_size = 24U;
+
+/*!
+ * \brief Size of prefixes of records in record logs.
+ */
+constexpr std::size_t record_log_length_size = 4U;
+
+/*!
+ * \brief Prefix written in place of a size of a record before the index of
+ * record logs.
+ */
+constexpr std::uint32_t record_log_index_marker = 0xFFFFFFFFU;
+
+/*!
+ * \brief Maximum size of a record in record logs.
+ */
+constexpr std::size_t record_log_max_record_size = 0xFFFFFFFEU;
+
+/*!
+ * \brief Class to write record logs.
+ *
+ * A record log is a sequence of records followed by an index and a footer:
+ *
+ * 1. Records. Each record has its size (4 bytes, big endian) and its data.
+ * 2. Marker of the index (`0xFFFFFFFF`, 4 bytes).
+ * 3. Index. Offsets of every `index_interval` records (records 0,
+ *    `index_interval`, `2 * index_interval`, ...) from the beginning of the
+ *    log (8 bytes each, big endian).
+ * 4. Footer (24 bytes).
+ *    - Number of records (8 bytes, big endian).
+ *    - Offset of the index (8 bytes, big endian).
+ *    - `index_interval` (4 bytes, big endian).
+ *    - Magic number "MPRL" (4 bytes).
+ *
+ * Use record_log_reader class to read the records.
+ *
+ * \note The index and the footer are written in finish() function, which is
+ * called in the destructor if not called before.
+ * Logs without the index and the footer (for example, when a process crashed
+ * before finish() function) can be read using record_log_reader::recover()
+ * function.
+ */
+class record_log_writer {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] stream Stream to write the log to.
+     * \param[in] index_interval Number of records per entry of the index.
+     * Larger values make the index smaller, and access to records slower.
+     */
+    explicit record_log_writer(output_stream& stream,
+        std::uint32_t index_interval = default_record_log_index_interval)
+        : stream_(stream), index_interval_(index_interval) {
+        if (index_interval == 0U) {
+            throw std::invalid_argument("Invalid interval of indices.");
+        }
+    }
+
+    record_log_writer(const record_log_writer&) = delete;
+    record_log_writer(record_log_writer&&) = delete;
+    record_log_writer& operator=(const record_log_writer&) = delete;
+    record_log_writer& operator=(record_log_writer&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This will call finish() function if not called before.
+     */
+    ~record_log_writer() noexcept {
+        try {
+            finish();
+        } catch (...) {
+            // Errors cannot be reported here.
+        }
+    }
+
+    /*!
+     * \brief Write a record.
+     *
+     * \param[in] data Pointer to the data of the record.
+     * \param[in] size Size of the data of the record.
+     */
+    void write_record(const unsigned char* data, std::size_t size) {
+        if (finished_) {
+            throw std::runtime_error("Record log is already finished.");
+        }
+        if (size > record_log_max_record_size) {
+            throw std::runtime_error("Size is too large.");
+        }
+        if (num_records_ % index_interval_ == 0U) {
+            index_.push_back(position_);
+        }
+        std::array<unsigned char, record_log_length_size> length{};
+        write_big_endian(length.data(), static_cast<std::uint32_t>(size));
+        stream_.write(length.data(), length.size());
+        stream_.write(data, size);
+        position_ += record_log_length_size + size;
+        ++num_records_;
+    }
+
+    /*!
+     * \brief Serialize a value and write it as a record.
+     *
+     * \tparam T Type of the value.
+     * \param[in] value Value.
+     */
+    template <typename T>
+    void write(const T& value) {
+        record_buffer_.clear();
+        serialize_to(record_buffer_, value);
+        write_record(record_buffer_.data(), record_buffer_.size());
+    }
+
+    /*!
+     * \brief Write the index and the footer.
+     *
+     * No record can be written after call of this function.
+     */
+    void finish() {
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+
+        std::array<unsigned char, record_log_length_size> marker{};
+        write_big_endian(marker.data(), record_log_index_marker);
+        stream_.write(marker.data(), marker.size());
+
+        const std::uint64_t index_offset = position_ + marker.size();
+        std::array<unsigned char, sizeof(std::uint64_t)> entry{};
+        for (const std::uint64_t offset : index_) {
+            write_big_endian(entry.data(), offset);
+            stream_.write(entry.data(), entry.size());
+        }
+
+        std::array<unsigned char, record_log_footer_size> footer{};
+        constexpr std::size_t index_offset_position = 8U;
+        constexpr std::size_t index_interval_position = 16U;
+        constexpr std::size_t magic_position = 20U;
+        write_big_endian(footer.data(), num_records_);
+        write_big_endian(footer.data() + index_offset_position, index_offset);
+        write_big_endian(
+            footer.data() + index_interval_position, index_interval_);
+        for (std::size_t i = 0; i < record_log_magic.size(); ++i) {
+            footer[magic_position + i] = record_log_magic[i];
+        }
+        stream_.write(footer.data(), footer.size());
+    }
+
+    /*!
+     * \brief Get the number of written records.
+     *
+     * \return Number of records.
+     */
+    [[nodiscard]] std::uint64_t num_records() const noexcept {
+        return num_records_;
+    }
+
+private:
+    /*!
+     * \brief Write an integer in big endian.
+     *
+     * \tparam T Type of the integer.
+     * \param[out] output Pointer to the output.
+     * \param[in] value Value.
+     */
+    template <typename T>
+    static void write_big_endian(unsigned char* output, T value) noexcept {
+        constexpr unsigned int bits_per_byte = 8U;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            output[i] = static_cast<unsigned char>(
+                value >> (bits_per_byte * (sizeof(T) - 1U - i)));
+        }
+    }
+
+    //! Stream to write the log to.
+    output_stream& stream_;
+
+    //! Number of records per entry of the index.
+    std::uint32_t index_interval_;
+
+    //! Offsets of indexed records.
+    std::vector<std::uint64_t> index_{};
+
+    //! Number of written records.
+    std::uint64_t num_records_{0U};
+
+    //! Current position in the log.
+    std::uint64_t position_{0U};
+
+    //! Buffer of serialized records.
+    memory_output_stream record_buffer_{};
+
+    //! Whether the log is finished.
+    bool finished_{false};
+};
+
+}  // namespace msgpack_light
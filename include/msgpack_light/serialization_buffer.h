@@ -27,6 +27,7 @@
 #include "msgpack_light/details/serialization_buffer_impl.h"
 #include "msgpack_light/output_stream.h"
 #include "msgpack_light/serialization_buffer_fwd.h"  // IWYU pragma: keep
+#include "msgpack_light/serialization_options.h"
 #include "msgpack_light/type_support/fwd.h"
 
 namespace msgpack_light {
@@ -52,7 +53,20 @@ public:
      *
      * \warning This class hold the reference of the given stream.
      */
-    explicit serialization_buffer(output_stream& stream) : buffer_(stream) {}
+    explicit serialization_buffer(output_stream& stream)
+        : buffer_(stream, details::default_serialization_buffer_size) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[out] stream Stream to write output to.
+     * \param[in] options Options of serialization.
+     *
+     * \warning This class hold the reference of the given stream.
+     */
+    serialization_buffer(
+        output_stream& stream, const serialization_options& options)
+        : buffer_(stream, options.buffer_size), options_(options) {}
 
     serialization_buffer(const serialization_buffer&) = delete;
     serialization_buffer(serialization_buffer&&) = delete;
@@ -74,6 +88,15 @@ public:
      */
     void flush() { buffer_.flush(); }
 
+    /*!
+     * \brief Get the options of serialization.
+     *
+     * \return Options.
+     */
+    [[nodiscard]] const serialization_options& options() const noexcept {
+        return options_;
+    }
+
     //!\}
 
     /*!
@@ -802,6 +825,9 @@ public:
 private:
     //! Instance to perform internal processing.
     details::serialization_buffer_impl buffer_;
+
+    //! Options of serialization.
+    serialization_options options_{};
 };
 
 }  // namespace msgpack_light
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of serialization_context class.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Class of contexts to serialize data reusing buffers.
+ *
+ * This class reuses the buffer in memory across serializations
+ * to avoid allocation of memory in each serialization.
+ * When the buffer becomes larger than the maximum capacity to retain
+ * due to large data, the buffer is replaced with a small one
+ * in the next serialization.
+ */
+class serialization_context {
+public:
+    //! Default maximum capacity of the buffer retained across serializations.
+    static constexpr std::size_t default_max_retained_capacity =
+        static_cast<std::size_t>(1024U) * 1024U;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] max_retained_capacity Maximum capacity of the buffer
+     * retained across serializations.
+     */
+    explicit serialization_context(
+        std::size_t max_retained_capacity = default_max_retained_capacity)
+        : max_retained_capacity_(max_retained_capacity) {}
+
+    /*!
+     * \brief Serialize data and return a view of the serialized data.
+     *
+     * \warning The returned view is valid only until the next call of
+     * functions of this object.
+     *
+     * \tparam T Type of data to serialize.
+     * \param[in] data Data to serialize.
+     * \param[in] options Options of serialization.
+     * \return View of the serialized data in the buffer of this object.
+     */
+    template <typename T>
+    [[nodiscard]] binary_view serialize(const T& data,
+        const serialization_options& options = serialization_options()) {
+        prepare();
+        serialize_to(stream_, data, options);
+        return binary_view(stream_.data(), stream_.size());
+    }
+
+    /*!
+     * \brief Serialize data and return the serialized data.
+     *
+     * When the serialized data uses more than half of the buffer,
+     * the buffer is moved to the returned object without copying,
+     * and this object allocates a new buffer in the next serialization.
+     * Otherwise, the serialized data is copied to a new object
+     * with the exact size and the buffer is kept for the next serialization,
+     * so that small results don't hold large buffers.
+     *
+     * \tparam T Type of data to serialize.
+     * \param[in] data Data to serialize.
+     * \param[in] options Options of serialization.
+     * \return Serialized data.
+     */
+    template <typename T>
+    [[nodiscard]] binary serialize_to_binary(const T& data,
+        const serialization_options& options = serialization_options()) {
+        prepare();
+        serialize_to(stream_, data, options);
+        if (stream_.size() <= stream_.capacity() / 2U) {
+            return binary(stream_.data(), stream_.size());
+        }
+        return stream_.release();
+    }
+
+    /*!
+     * \brief Get the capacity of the current buffer.
+     *
+     * \return Capacity.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return stream_.capacity();
+    }
+
+    /*!
+     * \brief Get the maximum capacity of the buffer retained across
+     * serializations.
+     *
+     * \return Maximum capacity.
+     */
+    [[nodiscard]] std::size_t max_retained_capacity() const noexcept {
+        return max_retained_capacity_;
+    }
+
+private:
+    /*!
+     * \brief Prepare the buffer for the next serialization.
+     */
+    void prepare() {
+        if (stream_.capacity() > max_retained_capacity_) {
+            stream_ = memory_output_stream();
+        } else {
+            stream_.clear();
+        }
+    }
+
+    //! Stream.
+    memory_output_stream stream_{};
+
+    //! Maximum capacity of the buffer retained across serializations.
+    std::size_t max_retained_capacity_;
+};
+
+/*!
+ * \brief Get the context of serialization for the current thread.
+ *
+ * \return Context.
+ */
+[[nodiscard]] inline serialization_context&
+thread_local_serialization_context() {
+    thread_local serialization_context context;
+    return context;
+}
+
+/*!
+ * \brief Serialize data using the buffer for the current thread
+ * and return a view of the serialized data.
+ *
+ * \warning The returned view is valid only until the next serialization
+ * using the buffer for the current thread.
+ * This function must not be called in serialization of other data
+ * using the buffer for the current thread.
+ *
+ * \tparam T Type of data to serialize.
+ * \param[in] data Data to serialize.
+ * \param[in] options Options of serialization.
+ * \return View of the serialized data.
+ */
+template <typename T>
+[[nodiscard]] inline binary_view serialize_pooled(const T& data,
+    const serialization_options& options = serialization_options()) {
+    return thread_local_serialization_context().serialize(data, options);
+}
+
+/*!
+ * \brief Serialize data using the buffer for the current thread
+ * and return the serialized data.
+ *
+ * See msgpack_light::serialization_context::serialize_to_binary function
+ * for the handling of the buffer.
+ *
+ * \note This function must not be called in serialization of other data
+ * using the buffer for the current thread.
+ *
+ * \tparam T Type of data to serialize.
+ * \param[in] data Data to serialize.
+ * \param[in] options Options of serialization.
+ * \return Serialized data.
+ */
+template <typename T>
+[[nodiscard]] inline binary serialize_pooled_to_binary(const T& data,
+    const serialization_options& options = serialization_options()) {
+    return thread_local_serialization_context().serialize_to_binary(
+        data, options);
+}
+
+}  // namespace msgpack_light
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of serialization_options struct.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "msgpack_light/details/serialization_buffer_impl.h"
+
+namespace msgpack_light {
+
+/*!
+ * \brief Struct of options of serialization.
+ */
+struct serialization_options {
+    /*!
+     * \brief Whether to serialize data in the canonical form.
+     *
+     * In the canonical form, equal values are serialized to the same bytes:
+     *
+     * - Key-value pairs in maps are sorted by the serialized bytes of keys.
+     *   (Pairs with the same key are sorted by the serialized bytes of values.)
+     * - Elements in unordered sets (`std::unordered_set`, ...) are sorted by
+     *   their serialized bytes.
+     * - Integers are serialized in the smallest format.
+     * - Floating-point numbers are serialized in the format of their types
+     *   (`float` in float 32 format, `double` in float 64 format)
+     *   unless compact_floating_point is enabled.
+     */
+    bool canonical{false};
+
+    /*!
+     * \brief Whether to serialize floating-point numbers in smaller formats
+     * when possible without loss of information.
+     *
+     * When enabled,
+     *
+     * - floating-point numbers which are integers are serialized as integers
+     *   in the smallest format, and
+     * - `double` values which can be represented exactly in `float` are
+     *   serialized in float 32 format.
+     *
+     * Negative zero, infinity, and NaN are kept as floating-point numbers.
+     *
+     * \note Deserializers must accept integers for floating-point numbers
+     * to read data serialized with this option.
+     */
+    bool compact_floating_point{false};
+
+    /*!
+     * \brief Size of the buffer in msgpack_light::serialization_buffer.
+     *
+     * Data is written to streams directly without buffers when this is zero.
+     * Buffers are efficient for streams with large costs per call of
+     * msgpack_light::output_stream::write (files, sockets, ...),
+     * but may be slower for streams writing to memory.
+     * The default value is selected by
+     * MSGPACK_LIGHT_USE_BUFFER_IN_SERIALIZATION macro.
+     */
+    std::size_t buffer_size{details::default_serialization_buffer_size};
+};
+
+}  // namespace msgpack_light
@@ -23,6 +23,7 @@
 #include "msgpack_light/memory_output_stream.h"
 #include "msgpack_light/output_stream.h"
 #include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/serialization_options.h"
 #include "msgpack_light/type_support/common.h"  // IWYU pragma: export
 
 namespace msgpack_light {
@@ -33,10 +34,12 @@ namespace msgpack_light {
  * \tparam T Type of data.
  * \param[out] stream Stream to write serialized data.
  * \param[in] data Data.
+ * \param[in] options Options of serialization.
  */
 template <typename T>
-inline void serialize_to(output_stream& stream, const T& data) {
-    serialization_buffer buffer(stream);
+inline void serialize_to(output_stream& stream, const T& data,
+    const serialization_options& options = serialization_options()) {
+    serialization_buffer buffer(stream, options);
     buffer.serialize(data);
     buffer.flush();
 }
@@ -46,12 +49,14 @@ inline void serialize_to(output_stream& stream, const T& data) {
  *
  * \tparam T Type of data to serialize.
  * \param[in] data Data to serialize.
+ * \param[in] options Options of serialization.
  * \return Serialized binary data.
  */
 template <typename T>
-[[nodiscard]] inline binary serialize(const T& data) {
+[[nodiscard]] inline binary serialize(const T& data,
+    const serialization_options& options = serialization_options()) {
     memory_output_stream stream;
-    serialize_to(stream, data);
+    serialize_to(stream, data, options);
     return stream.as_binary();
 }
 
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of serialize_batch function.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/details/fixed_memory_output_stream.h"
+#include "msgpack_light/details/parallel_for.h"
+#include "msgpack_light/details/size_counting_output_stream.h"
+#include "msgpack_light/parallel_serialize.h"
+#include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: export
+
+namespace msgpack_light {
+
+/*!
+ * \brief Struct of locations of serialized messages in a batch.
+ */
+struct serialized_message_location {
+    //! Offset of the message in the data of the batch.
+    std::size_t offset;
+
+    //! Size of the message.
+    std::size_t size;
+};
+
+/*!
+ * \brief Class of messages serialized in a batch.
+ */
+class serialized_batch {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Data of all messages.
+     * \param[in] locations Locations of messages.
+     */
+    serialized_batch(
+        binary data, std::vector<serialized_message_location> locations)
+        : data_(std::move(data)), locations_(std::move(locations)) {}
+
+    /*!
+     * \brief Get the data of all messages.
+     *
+     * \return Data.
+     */
+    [[nodiscard]] const binary& data() const noexcept { return data_; }
+
+    /*!
+     * \brief Get the locations of messages.
+     *
+     * \return Locations.
+     */
+    [[nodiscard]] const std::vector<serialized_message_location>& locations()
+        const noexcept {
+        return locations_;
+    }
+
+    /*!
+     * \brief Get the number of messages.
+     *
+     * \return Number of messages.
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return locations_.size();
+    }
+
+    /*!
+     * \brief Get a message.
+     *
+     * \param[in] index Index of the message.
+     * \return Serialized message.
+     */
+    [[nodiscard]] binary_view operator[](std::size_t index) const noexcept {
+        const serialized_message_location& location = locations_[index];
+        return binary_view(data_.data() + location.offset, location.size);
+    }
+
+private:
+    //! Data of all messages.
+    binary data_;
+
+    //! Locations of messages.
+    std::vector<serialized_message_location> locations_;
+};
+
+/*!
+ * \brief Serialize independent messages in parallel.
+ *
+ * Messages are partitioned into chunks processed in worker threads.
+ * Worker threads first calculate the sizes of serialized messages without
+ * storing data. The offsets of the chunks in the result are calculated by
+ * the prefix sum of the sizes of the chunks, and each worker thread
+ * serializes its messages directly into the result without copies.
+ *
+ * \note Each message is serialized twice (once for the size), so messages
+ * must not be changed during this function.
+ *
+ * \note
+ * parallel_serialization_options::min_chunk_size is the minimum number of
+ * messages in a chunk.
+ *
+ * \tparam T Type of messages.
+ * \param[in] messages Pointer to the messages.
+ * \param[in] num_messages Number of the messages.
+ * \param[in] parallel_options Options of parallel serialization.
+ * \param[in] options Options of serialization.
+ * \return Serialized messages.
+ */
+template <typename T>
+[[nodiscard]] inline serialized_batch serialize_batch(const T* messages,
+    std::size_t num_messages,
+    const parallel_serialization_options& parallel_options =
+        parallel_serialization_options(),
+    const serialization_options& options = serialization_options()) {
+    const std::size_t num_threads =
+        details::resolve_num_threads(parallel_options.num_threads);
+    const std::size_t min_chunk_size =
+        std::max<std::size_t>(parallel_options.min_chunk_size, 1U);
+    const std::size_t num_chunks = std::max<std::size_t>(
+        std::min(num_messages / min_chunk_size,
+            num_threads *
+                std::max<std::size_t>(parallel_options.chunks_per_thread, 1U)),
+        1U);
+    const auto chunk_begin = [num_messages, num_chunks](std::size_t chunk) {
+        return num_messages * chunk / num_chunks;
+    };
+
+    // Data is written to memory, so buffers in serialization_buffer are not
+    // needed.
+    serialization_options unbuffered_options = options;
+    unbuffered_options.buffer_size = 0U;
+
+    std::vector<serialized_message_location> locations(num_messages);
+    std::vector<std::size_t> chunk_offsets(num_chunks + 1U);
+    details::parallel_for(num_chunks, num_threads, [&](std::size_t chunk) {
+        const std::size_t end = chunk_begin(chunk + 1U);
+        details::size_counting_output_stream stream;
+        serialization_buffer buffer(stream, unbuffered_options);
+        for (std::size_t i = chunk_begin(chunk); i < end; ++i) {
+            const std::size_t offset = stream.size();
+            buffer.serialize(messages[i]);
+            locations[i] =
+                serialized_message_location{offset, stream.size() - offset};
+        }
+        chunk_offsets[chunk + 1U] = stream.size();
+    });
+
+    chunk_offsets[0] = 0U;
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        chunk_offsets[chunk + 1U] += chunk_offsets[chunk];
+    }
+
+    binary data(chunk_offsets[num_chunks]);
+    details::parallel_for(num_chunks, num_threads, [&](std::size_t chunk) {
+        const std::size_t chunk_offset = chunk_offsets[chunk];
+        details::fixed_memory_output_stream stream(data.data() + chunk_offset,
+            chunk_offsets[chunk + 1U] - chunk_offset);
+        serialization_buffer buffer(stream, unbuffered_options);
+        const std::size_t end = chunk_begin(chunk + 1U);
+        for (std::size_t i = chunk_begin(chunk); i < end; ++i) {
+            buffer.serialize(messages[i]);
+            locations[i].offset += chunk_offset;
+        }
+        if (stream.size() != chunk_offsets[chunk + 1U] - chunk_offset) {
+            throw std::runtime_error(
+                "Messages changed during serialization in a batch.");
+        }
+    });
+
+    return serialized_batch(std::move(data), std::move(locations));
+}
+
+/*!
+ * \brief Serialize independent messages in a contiguous container in
+ * parallel.
+ *
+ * \tparam Container Type of the container (`std::vector`, `std::array`,
+ * ...).
+ * \param[in] messages Container of the messages.
+ * \param[in] parallel_options Options of parallel serialization.
+ * \param[in] options Options of serialization.
+ * \return Serialized messages.
+ */
+template <typename Container>
+[[nodiscard]] inline serialized_batch serialize_batch(
+    const Container& messages,
+    const parallel_serialization_options& parallel_options =
+        parallel_serialization_options(),
+    const serialization_options& options = serialization_options()) {
+    return serialize_batch(std::data(messages), std::size(messages),
+        parallel_options, options);
+}
+
+}  // namespace msgpack_light
@@ -0,0 +1,326 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of shared_binary class.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "msgpack_light/binary.h"
+
+namespace msgpack_light {
+
+namespace details {
+
+/*!
+ * \brief Base class of blocks of data shared in msgpack_light::shared_binary
+ * instances.
+ */
+class shared_binary_block_base {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    shared_binary_block_base() noexcept = default;
+
+    shared_binary_block_base(const shared_binary_block_base&) = delete;
+    shared_binary_block_base(shared_binary_block_base&&) = delete;
+    shared_binary_block_base& operator=(
+        const shared_binary_block_base&) = delete;
+    shared_binary_block_base& operator=(shared_binary_block_base&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     */
+    virtual ~shared_binary_block_base() = default;
+
+    /*!
+     * \brief Add a reference.
+     */
+    void add_reference() noexcept {
+        reference_count_.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Remove a reference and delete this block if no reference remains.
+     */
+    void remove_reference() noexcept {
+        if (reference_count_.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+            delete this;
+        }
+    }
+
+    /*!
+     * \brief Get the number of references.
+     *
+     * \return Number of references.
+     */
+    [[nodiscard]] std::size_t reference_count() const noexcept {
+        return reference_count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    //! Number of references.
+    std::atomic<std::size_t> reference_count_{1U};
+};
+
+/*!
+ * \brief Class of blocks of data shared in msgpack_light::shared_binary
+ * instances.
+ *
+ * \tparam Allocator Type of the allocator of the data.
+ */
+template <typename Allocator>
+class shared_binary_block final : public shared_binary_block_base {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Data.
+     */
+    explicit shared_binary_block(basic_binary<Allocator>&& data) noexcept
+        : data_(std::move(data)) {}
+
+    /*!
+     * \brief Get the data.
+     *
+     * \return Data.
+     */
+    [[nodiscard]] const basic_binary<Allocator>& data() const noexcept {
+        return data_;
+    }
+
+private:
+    //! Data.
+    basic_binary<Allocator> data_;
+};
+
+}  // namespace details
+
+/*!
+ * \brief Class of immutable binary data shared with reference counting.
+ *
+ * Copies of this class share the same data without copying the data,
+ * and slices of data refer to the data of the original instance.
+ * The data is released when all instances referring to the data are
+ * destroyed.
+ *
+ * \note Different instances can be used in different threads
+ * concurrently.
+ */
+class shared_binary {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * Create empty data.
+     */
+    shared_binary() noexcept = default;
+
+    /*!
+     * \brief Constructor.
+     *
+     * This takes the ownership of the data without copying.
+     * (For example, data released from msgpack_light::memory_output_stream
+     * can be shared without copying.)
+     *
+     * \tparam Allocator Type of the allocator of the data.
+     * \param[in] data Data.
+     */
+    template <typename Allocator>
+    explicit shared_binary(basic_binary<Allocator>&& data) {
+        auto* block = new details::shared_binary_block<Allocator>(
+            std::move(data));
+        block_ = block;
+        data_ = block->data().data();
+        size_ = block->data().size();
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * This copies the data.
+     *
+     * \param[in] data Data.
+     */
+    explicit shared_binary(binary_view data) : shared_binary(binary(data)) {}
+
+    /*!
+     * \brief Copy constructor.
+     *
+     * This shares the data without copying.
+     *
+     * \param[in] other Instance to copy from.
+     */
+    shared_binary(const shared_binary& other) noexcept
+        : block_(other.block_), data_(other.data_), size_(other.size_) {
+        if (block_ != nullptr) {
+            block_->add_reference();
+        }
+    }
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in,out] other Instance to move from.
+     */
+    shared_binary(shared_binary&& other) noexcept
+        : block_(std::exchange(other.block_, nullptr)),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0U)) {}
+
+    /*!
+     * \brief Copy assignment operator.
+     *
+     * \param[in] other Instance to copy from.
+     * \return This.
+     */
+    shared_binary& operator=(const shared_binary& other) noexcept {
+        shared_binary(other).swap(*this);
+        return *this;
+    }
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in,out] other Instance to move from.
+     * \return This.
+     */
+    shared_binary& operator=(shared_binary&& other) noexcept {
+        shared_binary(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    /*!
+     * \brief Destructor.
+     */
+    ~shared_binary() {
+        if (block_ != nullptr) {
+            block_->remove_reference();
+        }
+    }
+
+    /*!
+     * \brief Swap with another instance.
+     *
+     * \param[in,out] other Instance to swap with.
+     */
+    void swap(shared_binary& other) noexcept {
+        std::swap(block_, other.block_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    /*!
+     * \brief Get a slice of the data.
+     *
+     * The slice shares the data with this instance without copying.
+     *
+     * \param[in] offset Offset of the slice.
+     * \param[in] size Size of the slice.
+     * \return Slice.
+     */
+    [[nodiscard]] shared_binary slice(
+        std::size_t offset, std::size_t size) const {
+        if (offset > size_ || size > size_ - offset) {
+            throw std::out_of_range("Invalid range of a slice.");
+        }
+        shared_binary result(*this);
+        result.data_ += offset;  // NOLINT
+        result.size_ = size;
+        return result;
+    }
+
+    /*!
+     * \brief Get the pointer to the data.
+     *
+     * \return Pointer to the data.
+     */
+    [[nodiscard]] const unsigned char* data() const noexcept { return data_; }
+
+    /*!
+     * \brief Get the size of the data.
+     *
+     * \return Size of the data.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /*!
+     * \brief Check whether the data is empty.
+     *
+     * \retval true The data is empty.
+     * \retval false The data is not empty.
+     */
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0U; }
+
+    /*!
+     * \brief Get the number of instances sharing the data.
+     *
+     * \return Number of instances. (0 for instances without data.)
+     */
+    [[nodiscard]] std::size_t use_count() const noexcept {
+        if (block_ == nullptr) {
+            return 0U;
+        }
+        return block_->reference_count();
+    }
+
+    /*!
+     * \brief Get a view of the data.
+     *
+     * \return View.
+     */
+    [[nodiscard]] binary_view view() const noexcept {
+        return binary_view(data_, size_);
+    }
+
+    /*!
+     * \brief Convert to a view of the data.
+     *
+     * \return View.
+     */
+    operator binary_view()  // NOLINT(google-explicit-constructor,hicpp-explicit-conversions)
+        const noexcept {
+        return view();
+    }
+
+private:
+    //! Block of the data.
+    details::shared_binary_block_base* block_{nullptr};
+
+    //! Pointer to the data.
+    const unsigned char* data_{nullptr};
+
+    //! Size of the data.
+    std::size_t size_{0U};
+};
+
+/*!
+ * \brief Swap two instances.
+ *
+ * \param[in,out] lhs An instance.
+ * \param[in,out] rhs Another instance.
+ */
+inline void swap(shared_binary& lhs, shared_binary& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace msgpack_light
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of classes to support serialization of
+ * msgpack_light::cached_serialization instances.
+ */
+#pragma once
+
+#include "msgpack_light/cached_serialization.h"
+#include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/type_support/fwd.h"
+
+namespace msgpack_light::type_support {
+
+/*!
+ * \brief Class to serialize msgpack_light::cached_serialization instances.
+ *
+ * \tparam T Type of the value.
+ */
+template <typename T>
+struct serialization_traits<cached_serialization<T>> {
+    /*!
+     * \brief Serialize a value.
+     *
+     * The serialized data of the value is written when it was serialized
+     * with the same options as the buffer, and otherwise the value is
+     * serialized again.
+     *
+     * \param[out] buffer Buffer.
+     * \param[in] value Value.
+     */
+    static void serialize(
+        serialization_buffer& buffer, const cached_serialization<T>& value) {
+        if (!value.is_serialized_with(buffer.options())) {
+            buffer.serialize(value.value());
+            return;
+        }
+        const binary& data = value.serialized();
+        buffer.write(data.data(), data.size());
+    }
+};
+
+}  // namespace msgpack_light::type_support
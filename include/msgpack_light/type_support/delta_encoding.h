@@ -0,0 +1,135 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of classes to support serialization of
+ * msgpack_light::delta_encoded_view instances.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "msgpack_light/delta_encoding.h"
+#include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/type_support/fwd.h"
+
+namespace msgpack_light::type_support {
+
+/*!
+ * \brief Class to serialize msgpack_light::delta_encoded_view instances.
+ *
+ * \tparam T Type of values.
+ */
+template <typename T>
+struct serialization_traits<delta_encoded_view<T>> {
+    /*!
+     * \brief Serialize a value.
+     *
+     * \param[out] buffer Buffer.
+     * \param[in] value Value.
+     */
+    static void serialize(
+        serialization_buffer& buffer, const delta_encoded_view<T>& value) {
+        const T* values = value.data();
+        const std::size_t count = value.size();
+        if (count > msgpack_light::details::max_delta_encoding_count) {
+            throw std::runtime_error("Size is too large.");
+        }
+        const unsigned int bit_width =
+            msgpack_light::details::delta_encoding_bit_width(values, count);
+        buffer.serialize_ext_header(value.ext_type(),
+            msgpack_light::details::delta_encoded_data_size(count, bit_width));
+
+        const std::uint64_t base = (count == 0U)
+            ? static_cast<std::uint64_t>(0U)
+            : msgpack_light::details::to_delta_encoding_integer(values[0]);
+        buffer.write_in_big_endian(static_cast<std::uint32_t>(count),
+            static_cast<std::uint8_t>(bit_width), base);
+
+        if (bit_width > 0U) {
+            write_packed_deltas(buffer, values, count, bit_width);
+        }
+    }
+
+private:
+    /*!
+     * \brief Write bit-packed differences of values.
+     *
+     * \param[out] buffer Buffer.
+     * \param[in] values Pointer to values.
+     * \param[in] count Number of values.
+     * \param[in] bit_width Number of bits of each difference.
+     */
+    static void write_packed_deltas(serialization_buffer& buffer,
+        const T* values, std::size_t count, unsigned int bit_width) {
+        constexpr unsigned int bits_per_byte = 8U;
+        constexpr unsigned int bits_per_word = 64U;
+        constexpr std::size_t bytes_per_word = sizeof(std::uint64_t);
+
+        // Words are packed into a small array to reduce calls of write().
+        constexpr std::size_t words_per_chunk = 32U;
+        std::array<unsigned char, words_per_chunk * bytes_per_word> chunk{};
+        std::size_t chunk_size = 0U;
+        const auto store_bytes = [&buffer, &chunk, &chunk_size](
+                                     std::uint64_t word,
+                                     std::size_t num_bytes) {
+            for (std::size_t i = 0; i < num_bytes; ++i) {
+                chunk[chunk_size + i] =
+                    static_cast<unsigned char>(word >> (bits_per_byte * i));
+            }
+            chunk_size += num_bytes;
+            if (chunk_size == chunk.size()) {
+                buffer.write(chunk.data(), chunk_size);
+                chunk_size = 0U;
+            }
+        };
+
+        std::uint64_t word = 0U;
+        unsigned int filled_bits = 0U;
+        std::uint64_t previous =
+            msgpack_light::details::to_delta_encoding_integer(values[0]);
+        for (std::size_t i = 1; i < count; ++i) {
+            const std::uint64_t current =
+                msgpack_light::details::to_delta_encoding_integer(values[i]);
+            const std::uint64_t encoded =
+                msgpack_light::details::zigzag_encode(current - previous);
+            previous = current;
+
+            word |= encoded << filled_bits;
+            filled_bits += bit_width;
+            if (filled_bits >= bits_per_word) {
+                store_bytes(word, bytes_per_word);
+                filled_bits -= bits_per_word;
+                // Remaining bits of the encoded value.
+                word = (filled_bits == 0U)
+                    ? static_cast<std::uint64_t>(0U)
+                    : encoded >> (bit_width - filled_bits);
+            }
+        }
+        if (filled_bits > 0U) {
+            store_bytes(
+                word, (filled_bits + bits_per_byte - 1U) / bits_per_byte);
+        }
+        if (chunk_size > 0U) {
+            buffer.write(chunk.data(), chunk_size);
+        }
+    }
+};
+
+}  // namespace msgpack_light::type_support
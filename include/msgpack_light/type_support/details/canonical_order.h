@@ -0,0 +1,358 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of functions to serialize elements in the canonical order.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/serialization_options.h"
+
+namespace msgpack_light::type_support::details {
+
+/*!
+ * \brief Struct of ranges of serialized data in a buffer.
+ */
+struct serialized_range {
+    //! Offset of the data in the buffer.
+    std::size_t offset;
+
+    //! Size of the data.
+    std::size_t size;
+};
+
+/*!
+ * \brief Struct of tasks in sort_serialized_ranges function.
+ */
+struct serialized_range_sort_task {
+    //! Index of the first range in the group.
+    std::size_t begin;
+
+    //! Number of ranges in the group.
+    std::size_t size;
+
+    //! Number of bytes known to be the same in the group.
+    std::size_t depth;
+};
+
+/*!
+ * \brief Compare two serialized data in lexicographical order.
+ *
+ * \param[in] data Buffer of the serialized data.
+ * \param[in] lhs Left-hand-side range.
+ * \param[in] rhs Right-hand-side range.
+ * \param[in] depth Number of bytes known to be the same.
+ * \retval true The left-hand-side data is less than the right-hand-side data.
+ * \retval false Otherwise.
+ */
+[[nodiscard]] inline bool is_serialized_data_less(const unsigned char* data,
+    const serialized_range& lhs, const serialized_range& rhs,
+    std::size_t depth) noexcept {
+    const std::size_t common_size = std::min(lhs.size, rhs.size);
+    if (common_size > depth) {
+        const int result = std::memcmp(data + lhs.offset + depth,
+            data + rhs.offset + depth, common_size - depth);
+        if (result != 0) {
+            return result < 0;
+        }
+    }
+    return lhs.size < rhs.size;
+}
+
+/*!
+ * \brief Sort ranges of serialized data by the data in lexicographical order.
+ *
+ * This function uses MSD radix sort without recursive calls.
+ *
+ * \param[in] data Buffer of the serialized data.
+ * \param[in,out] ranges Ranges of the serialized data.
+ * \param[out] temp Vector used as a temporary buffer of ranges.
+ * \param[out] tasks Vector used as a temporary buffer of tasks.
+ */
+inline void sort_serialized_ranges(const unsigned char* data,
+    std::vector<serialized_range>& ranges,
+    std::vector<serialized_range>& temp,
+    std::vector<serialized_range_sort_task>& tasks) {
+    // Ranges in smaller groups than this threshold are sorted by insertion
+    // sort.
+    constexpr std::size_t insertion_sort_threshold = 32U;
+
+    // Bucket 0 is used for data ending before the current byte, and bucket
+    // (1 + b) is used for data with the current byte b.
+    constexpr std::size_t num_buckets = 257U;
+
+    using task = serialized_range_sort_task;
+    tasks.clear();
+    tasks.push_back(task{0U, ranges.size(), 0U});
+
+    temp.resize(ranges.size());
+    std::array<std::size_t, num_buckets> bucket_begins{};
+
+    const auto bucket_of = [data](const serialized_range& range,
+                               std::size_t depth) -> std::size_t {
+        if (range.size <= depth) {
+            return 0U;
+        }
+        return 1U + static_cast<std::size_t>(data[range.offset + depth]);
+    };
+
+    while (!tasks.empty()) {
+        const task current = tasks.back();
+        tasks.pop_back();
+        serialized_range* group = ranges.data() + current.begin;
+
+        if (current.size < insertion_sort_threshold) {
+            for (std::size_t i = 1; i < current.size; ++i) {
+                const serialized_range range = group[i];
+                std::size_t j = i;
+                for (; j > 0U &&
+                     is_serialized_data_less(
+                         data, range, group[j - 1U], current.depth);
+                     --j) {
+                    group[j] = group[j - 1U];
+                }
+                group[j] = range;
+            }
+            continue;
+        }
+
+        std::array<std::size_t, num_buckets> counts{};
+        for (std::size_t i = 0; i < current.size; ++i) {
+            ++counts[bucket_of(group[i], current.depth)];
+        }
+
+        const std::size_t first_bucket = bucket_of(group[0], current.depth);
+        if (counts[first_bucket] == current.size) {
+            // All data have the same byte here.
+            if (first_bucket != 0U) {
+                tasks.push_back(
+                    task{current.begin, current.size, current.depth + 1U});
+            }
+            continue;
+        }
+
+        std::size_t position = 0U;
+        for (std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+            bucket_begins[bucket] = position;
+            position += counts[bucket];
+        }
+        for (std::size_t i = 0; i < current.size; ++i) {
+            const std::size_t bucket = bucket_of(group[i], current.depth);
+            temp[bucket_begins[bucket]] = group[i];
+            ++bucket_begins[bucket];
+        }
+        std::copy(temp.begin(),
+            temp.begin() + static_cast<std::ptrdiff_t>(current.size), group);
+
+        // Data in bucket 0 are equal to each other.
+        std::size_t bucket_begin = counts[0];
+        for (std::size_t bucket = 1; bucket < num_buckets; ++bucket) {
+            if (counts[bucket] > 1U) {
+                tasks.push_back(task{current.begin + bucket_begin,
+                    counts[bucket], current.depth + 1U});
+            }
+            bucket_begin += counts[bucket];
+        }
+    }
+}
+
+/*!
+ * \brief Sort ranges of serialized data by the data in lexicographical order.
+ *
+ * \param[in] data Buffer of the serialized data.
+ * \param[in,out] ranges Ranges of the serialized data.
+ */
+inline void sort_serialized_ranges(
+    const unsigned char* data, std::vector<serialized_range>& ranges) {
+    std::vector<serialized_range> temp;
+    std::vector<serialized_range_sort_task> tasks;
+    sort_serialized_ranges(data, ranges, temp, tasks);
+}
+
+/*!
+ * \brief Struct of buffers used to serialize elements in the canonical order.
+ */
+struct canonical_order_workspace {
+    //! Maximum capacity of the stream retained across serializations.
+    static constexpr std::size_t max_retained_capacity =
+        static_cast<std::size_t>(1024U) * 1024U;
+
+    //! Stream of serialized elements.
+    memory_output_stream elements_stream{};
+
+    //! Ranges of serialized elements.
+    std::vector<serialized_range> ranges{};
+
+    //! Temporary buffer of ranges for sorting.
+    std::vector<serialized_range> temp{};
+
+    //! Temporary buffer of tasks for sorting.
+    std::vector<serialized_range_sort_task> tasks{};
+
+    /*!
+     * \brief Clear buffers for the next use.
+     */
+    void clear() {
+        if (elements_stream.capacity() > max_retained_capacity) {
+            elements_stream = memory_output_stream();
+        } else {
+            elements_stream.clear();
+        }
+        ranges.clear();
+    }
+};
+
+/*!
+ * \brief Class of pools of canonical_order_workspace objects in a thread.
+ *
+ * Each level of nested containers uses a different workspace,
+ * and workspaces are reused across serializations.
+ */
+class canonical_order_workspace_pool {
+public:
+    /*!
+     * \brief Class of leases of workspaces.
+     */
+    class lease {
+    public:
+        /*!
+         * \brief Constructor.
+         *
+         * \param[in] pool Pool.
+         */
+        explicit lease(canonical_order_workspace_pool& pool)
+            : pool_(pool), workspace_(pool.acquire()) {}
+
+        lease(const lease&) = delete;
+        lease(lease&&) = delete;
+        lease& operator=(const lease&) = delete;
+        lease& operator=(lease&&) = delete;
+
+        /*!
+         * \brief Destructor.
+         */
+        ~lease() noexcept { --pool_.depth_; }
+
+        /*!
+         * \brief Get the workspace.
+         *
+         * \return Workspace.
+         */
+        [[nodiscard]] canonical_order_workspace& workspace() const noexcept {
+            return workspace_;
+        }
+
+    private:
+        //! Pool.
+        canonical_order_workspace_pool& pool_;
+
+        //! Workspace.
+        canonical_order_workspace& workspace_;
+    };
+
+    /*!
+     * \brief Get the pool for the current thread.
+     *
+     * \return Pool.
+     */
+    [[nodiscard]] static canonical_order_workspace_pool& thread_local_pool() {
+        thread_local canonical_order_workspace_pool pool;
+        return pool;
+    }
+
+private:
+    /*!
+     * \brief Acquire a cleared workspace for the current depth.
+     *
+     * \return Workspace.
+     */
+    [[nodiscard]] canonical_order_workspace& acquire() {
+        if (depth_ == workspaces_.size()) {
+            workspaces_.push_back(
+                std::make_unique<canonical_order_workspace>());
+        }
+        canonical_order_workspace& workspace = *workspaces_[depth_];
+        workspace.clear();
+        ++depth_;
+        return workspace;
+    }
+
+    //! Workspaces. (Pointers keep addresses while nested levels are added.)
+    std::vector<std::unique_ptr<canonical_order_workspace>> workspaces_{};
+
+    //! Number of workspaces in use.
+    std::size_t depth_{0U};
+};
+
+/*!
+ * \brief Serialize elements in the canonical order.
+ *
+ * Elements are serialized into a temporary buffer, sorted by the serialized
+ * bytes, and then written to the buffer.
+ * Temporary buffers are reused from the pool of the current thread.
+ *
+ * \note The size of the array or the map must be serialized before call of
+ * this function.
+ *
+ * \tparam Container Type of the container of elements.
+ * \tparam Function Type of the function to serialize an element.
+ * \param[out] buffer Buffer.
+ * \param[in] container Container of elements.
+ * \param[in] serialize_element Function to serialize an element.
+ * This is called with `serialization_buffer&` and an element as arguments.
+ */
+template <typename Container, typename Function>
+inline void serialize_in_canonical_order(serialization_buffer& buffer,
+    const Container& container, Function&& serialize_element) {
+    const canonical_order_workspace_pool::lease lease(
+        canonical_order_workspace_pool::thread_local_pool());
+    canonical_order_workspace& workspace = lease.workspace();
+    memory_output_stream& elements_stream = workspace.elements_stream;
+    std::vector<serialized_range>& ranges = workspace.ranges;
+    ranges.reserve(container.size());
+    {
+        // Buffers aren't needed to write to memory.
+        serialization_options elements_options = buffer.options();
+        elements_options.buffer_size = 0U;
+        serialization_buffer elements_buffer(
+            elements_stream, elements_options);
+        for (const auto& element : container) {
+            const std::size_t offset = elements_stream.size();
+            serialize_element(elements_buffer, element);
+            elements_buffer.flush();
+            ranges.push_back(
+                serialized_range{offset, elements_stream.size() - offset});
+        }
+    }
+
+    sort_serialized_ranges(
+        elements_stream.data(), ranges, workspace.temp, workspace.tasks);
+
+    for (const auto& range : ranges) {
+        buffer.write(elements_stream.data() + range.offset, range.size);
+    }
+}
+
+}  // namespace msgpack_light::type_support::details
@@ -21,6 +21,7 @@
 #pragma once
 
 #include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/type_support/details/canonical_order.h"
 
 namespace msgpack_light::type_support::details {
 
@@ -35,11 +36,22 @@ public:
     /*!
      * \brief Serialize a value.
      *
+     * \note In the canonical form, key-value pairs are sorted by the
+     * serialized bytes.
+     *
      * \param[out] buffer Buffer.
      * \param[in] value Value.
      */
     static void serialize(serialization_buffer& buffer, const T& value) {
         buffer.serialize_map_size(value.size());
+        if (buffer.options().canonical) {
+            serialize_in_canonical_order(buffer, value,
+                [](serialization_buffer& pair_buffer, const auto& pair) {
+                    pair_buffer.serialize(pair.first);
+                    pair_buffer.serialize(pair.second);
+                });
+            return;
+        }
         for (const auto& [key, value] : value) {
             buffer.serialize(key);
             buffer.serialize(value);
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of classes to support serialization of STL containers
+ * without order of elements into arrays.
+ */
+#pragma once
+
+#include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/type_support/details/canonical_order.h"
+
+namespace msgpack_light::type_support::details {
+
+/*!
+ * \brief Class to serialize STL containers without order of elements
+ * (`std::unordered_set`, ...) into arrays.
+ *
+ * \tparam T Type of the container.
+ */
+template <typename T>
+struct general_unordered_array_container_traits {
+public:
+    /*!
+     * \brief Serialize a value.
+     *
+     * \note In the canonical form, elements are sorted by the serialized
+     * bytes.
+     *
+     * \param[out] buffer Buffer.
+     * \param[in] value Value.
+     */
+    static void serialize(serialization_buffer& buffer, const T& value) {
+        buffer.serialize_array_size(value.size());
+        if (buffer.options().canonical) {
+            serialize_in_canonical_order(buffer, value,
+                [](serialization_buffer& elem_buffer, const auto& elem) {
+                    elem_buffer.serialize(elem);
+                });
+            return;
+        }
+        for (const auto& elem : value) {
+            buffer.serialize(elem);
+        }
+    }
+};
+
+}  // namespace msgpack_light::type_support::details
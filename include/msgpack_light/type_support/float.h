@@ -20,13 +20,61 @@
  */
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
 #include "msgpack_light/serialization_buffer.h"
 #include "msgpack_light/type_support/fwd.h"
+#include "msgpack_light/type_support/integer.h"
 
 namespace msgpack_light::type_support {
 
+namespace details {
+
+/*!
+ * \brief Serialize a floating-point number as an integer if possible without
+ * loss of information.
+ *
+ * \tparam T Type of the floating-point number.
+ * \param[out] buffer Buffer.
+ * \param[in] value Value.
+ * \retval true The value was serialized.
+ * \retval false The value is not an integer and was not serialized.
+ */
+template <typename T>
+[[nodiscard]] inline bool try_serialize_floating_point_as_integer(
+    serialization_buffer& buffer, T value) {
+    // 2^64 and -2^63 are exactly representable in floating-point numbers.
+    constexpr auto uint64_limit = static_cast<T>(0x1p64);
+    constexpr auto int64_min = static_cast<T>(-0x1p63);
+
+    if (std::trunc(value) != value) {
+        // Non-integers and NaN.
+        return false;
+    }
+    if (value >= static_cast<T>(0)) {
+        if (value >= uint64_limit || std::signbit(value)) {
+            // Too large values, infinity, and negative zero.
+            return false;
+        }
+        buffer.serialize(static_cast<std::uint64_t>(value));
+        return true;
+    }
+    if (value < int64_min) {
+        return false;
+    }
+    buffer.serialize(static_cast<std::int64_t>(value));
+    return true;
+}
+
+}  // namespace details
+
 /*!
  * \brief Class to serialize `float` values.
+ *
+ * When serialization_options::compact_floating_point is enabled, values which
+ * are integers are serialized as integers.
  */
 template <>
 struct serialization_traits<float> {
@@ -37,12 +85,20 @@ struct serialization_traits<float> {
      * \param[in] value Value.
      */
     static void serialize(serialization_buffer& buffer, float value) {
+        if (buffer.options().compact_floating_point &&
+            details::try_serialize_floating_point_as_integer(buffer, value)) {
+            return;
+        }
         buffer.serialize_float32(value);
     }
 };
 
 /*!
  * \brief Class to serialize `double` values.
+ *
+ * When serialization_options::compact_floating_point is enabled, values which
+ * are integers are serialized as integers, and values which can be represented
+ * exactly in `float` are serialized in float 32 format.
  */
 template <>
 struct serialization_traits<double> {
@@ -53,8 +109,40 @@ struct serialization_traits<double> {
      * \param[in] value Value.
      */
     static void serialize(serialization_buffer& buffer, double value) {
+        if (buffer.options().compact_floating_point) {
+            if (details::try_serialize_floating_point_as_integer(
+                    buffer, value)) {
+                return;
+            }
+            if (is_exactly_representable_in_float(value)) {
+                buffer.serialize_float32(static_cast<float>(value));
+                return;
+            }
+        }
         buffer.serialize_float64(value);
     }
+
+private:
+    /*!
+     * \brief Check whether a value can be represented exactly in `float`.
+     *
+     * \param[in] value Value.
+     * \retval true The value can be represented exactly.
+     * \retval false Otherwise. (NaN is always treated as this case to keep its
+     * bits.)
+     */
+    [[nodiscard]] static bool is_exactly_representable_in_float(
+        double value) noexcept {
+        if (std::isinf(value)) {
+            return true;
+        }
+        if (!(std::abs(value) <=
+                static_cast<double>(std::numeric_limits<float>::max()))) {
+            // Too large values and NaN.
+            return false;
+        }
+        return static_cast<double>(static_cast<float>(value)) == value;
+    }
 };
 
 }  // namespace msgpack_light::type_support
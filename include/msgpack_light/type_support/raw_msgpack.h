@@ -0,0 +1,71 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of classes to support serialization of data already
+ * serialized in MessagePack.
+ */
+#pragma once
+
+#include <cassert>
+
+#include "msgpack_light/raw_msgpack.h"
+#include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/type_support/fwd.h"
+
+namespace msgpack_light::type_support {
+
+/*!
+ * \brief Class to serialize msgpack_light::raw_msgpack instances.
+ *
+ * \note Containers of msgpack_light::raw_msgpack instances (for example,
+ * `std::vector<raw_msgpack>`) can be serialized as arrays using this class.
+ */
+template <>
+struct serialization_traits<raw_msgpack> {
+    /*!
+     * \brief Serialize a value.
+     *
+     * \param[out] buffer Buffer.
+     * \param[in] value Value.
+     */
+    static void serialize(serialization_buffer& buffer, raw_msgpack value) {
+        assert(value.is_valid());
+        buffer.write(value.data(), value.size());
+    }
+};
+
+/*!
+ * \brief Class to serialize msgpack_light::raw_msgpack_map instances.
+ */
+template <>
+struct serialization_traits<raw_msgpack_map> {
+    /*!
+     * \brief Serialize a value.
+     *
+     * \param[out] buffer Buffer.
+     * \param[in] value Value.
+     */
+    static void serialize(serialization_buffer& buffer, raw_msgpack_map value) {
+        buffer.serialize_map_size(value.size());
+        for (const auto& [key, mapped] : value) {
+            serialization_traits<raw_msgpack>::serialize(buffer, key);
+            serialization_traits<raw_msgpack>::serialize(buffer, mapped);
+        }
+    }
+};
+
+}  // namespace msgpack_light::type_support
@@ -22,7 +22,7 @@
 
 #include <unordered_set>
 
-#include "msgpack_light/type_support/details/general_array_container_traits.h"
+#include "msgpack_light/type_support/details/general_unordered_array_container_traits.h"
 #include "msgpack_light/type_support/fwd.h"
 
 namespace msgpack_light::type_support {
@@ -37,7 +37,7 @@ namespace msgpack_light::type_support {
  */
 template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
 struct serialization_traits<std::unordered_set<Key, Hash, KeyEqual, Allocator>>
-    : public details::general_array_container_traits<
+    : public details::general_unordered_array_container_traits<
           std::unordered_set<Key, Hash, KeyEqual, Allocator>> {};
 
 /*!
@@ -51,7 +51,7 @@ struct serialization_traits<std::unordered_set<Key, Hash, KeyEqual, Allocator>>
 template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
 struct serialization_traits<
     std::unordered_multiset<Key, Hash, KeyEqual, Allocator>>
-    : public details::general_array_container_traits<
+    : public details::general_unordered_array_container_traits<
           std::unordered_multiset<Key, Hash, KeyEqual, Allocator>> {};
 
 }  // namespace msgpack_light::type_support
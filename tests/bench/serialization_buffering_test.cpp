@@ -0,0 +1,190 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Benchmark of sizes of buffers in serialization for each type of
+ * streams and data.
+ *
+ * Experiment values are sizes of buffers in serialization (0 for no buffer).
+ */
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <celero/Celero.h>
+
+#include "msgpack_light/chunked_memory_output_stream.h"
+#include "msgpack_light/file_output_stream.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"         // IWYU pragma: keep
+#include "msgpack_light/type_support/unordered_map.h"  // IWYU pragma: keep
+
+namespace {
+
+/*!
+ * \brief Create small integers.
+ *
+ * \return Data.
+ */
+std::vector<std::int64_t> create_small_integers() {
+    constexpr std::size_t size = 10000;
+    std::vector<std::int64_t> data;
+    data.reserve(size);
+    std::mt19937 generator;  // NOLINT
+    std::uniform_int_distribution<std::int64_t> distribution{-100, 100000};
+    for (std::size_t i = 0; i < size; ++i) {
+        data.push_back(distribution(generator));
+    }
+    return data;
+}
+
+/*!
+ * \brief Create strings of various sizes.
+ *
+ * \return Data.
+ */
+std::vector<std::string> create_strings() {
+    constexpr std::size_t size = 1000;
+    std::vector<std::string> data;
+    data.reserve(size);
+    std::mt19937 generator;  // NOLINT
+    std::uniform_int_distribution<std::size_t> distribution{0, 1000};
+    for (std::size_t i = 0; i < size; ++i) {
+        data.emplace_back(distribution(generator), 'A');
+    }
+    return data;
+}
+
+/*!
+ * \brief Create nested maps.
+ *
+ * \return Data.
+ */
+std::vector<std::unordered_map<std::string, std::vector<int>>>
+create_nested_maps() {
+    constexpr std::size_t size = 100;
+    constexpr std::size_t num_keys = 10;
+    std::vector<std::unordered_map<std::string, std::vector<int>>> data;
+    data.reserve(size);
+    std::mt19937 generator;  // NOLINT
+    std::uniform_int_distribution<std::size_t> distribution{0, 20};
+    for (std::size_t i = 0; i < size; ++i) {
+        std::unordered_map<std::string, std::vector<int>> map;
+        for (std::size_t j = 0; j < num_keys; ++j) {
+            map.try_emplace("key" + std::to_string(j),
+                std::vector<int>(distribution(generator), static_cast<int>(j)));
+        }
+        data.push_back(std::move(map));
+    }
+    return data;
+}
+
+}  // namespace
+
+/*!
+ * \brief Fixture of benchmarks of sizes of buffers in serialization.
+ *
+ * \tparam Data Type of data.
+ * \tparam CreateData Function to create data.
+ */
+template <typename Data, Data (*CreateData)()>
+class serialization_buffering_fixture : public celero::TestFixture {
+public:
+    serialization_buffering_fixture() {
+        celero::DoNotOptimizeAway(get_data());
+    }
+
+    [[nodiscard]] std::vector<
+        std::shared_ptr<celero::TestFixture::ExperimentValue>>
+    getExperimentValues() const override {
+        std::vector<std::shared_ptr<celero::TestFixture::ExperimentValue>>
+            values;
+        for (const std::int64_t buffer_size : {0, 64, 512, 4096, 65536}) {
+            values.push_back(
+                std::make_shared<celero::TestFixture::ExperimentValue>(
+                    buffer_size));
+        }
+        return values;
+    }
+
+    void setUp(
+        const celero::TestFixture::ExperimentValue* const experiment_value)
+        override {
+        options_.buffer_size =
+            static_cast<std::size_t>(experiment_value->Value);
+    }
+
+    static const Data& get_data() {
+        static auto data = CreateData();
+        return data;
+    }
+
+    [[nodiscard]] const msgpack_light::serialization_options& options()
+        const noexcept {
+        return options_;
+    }
+
+private:
+    msgpack_light::serialization_options options_{};
+};
+
+using small_integers_fixture =
+    serialization_buffering_fixture<std::vector<std::int64_t>,
+        &create_small_integers>;
+using strings_fixture =
+    serialization_buffering_fixture<std::vector<std::string>, &create_strings>;
+using nested_maps_fixture = serialization_buffering_fixture<
+    std::vector<std::unordered_map<std::string, std::vector<int>>>,
+    &create_nested_maps>;
+
+//! File path used in benchmarks.
+static constexpr const char* bench_file_path =
+    "serialization_buffering_test.bin";
+
+// NOLINTNEXTLINE
+#define MSGPACK_LIGHT_BENCH_SERIALIZATION_BUFFERING(GROUP, FIXTURE)         \
+    BASELINE_F(GROUP, memory, FIXTURE, 30, 0) {                             \
+        msgpack_light::memory_output_stream stream;                        \
+        msgpack_light::serialize_to(stream, get_data(), options());        \
+        celero::DoNotOptimizeAway(stream.size());                          \
+    }                                                                       \
+    BENCHMARK_F(GROUP, chunked_memory, FIXTURE, 30, 0) {                    \
+        msgpack_light::chunked_memory_output_stream stream;                \
+        msgpack_light::serialize_to(stream, get_data(), options());        \
+        celero::DoNotOptimizeAway(stream.size());                          \
+    }                                                                       \
+    BENCHMARK_F(GROUP, file, FIXTURE, 30, 0) {                              \
+        msgpack_light::file_output_stream stream(bench_file_path);         \
+        msgpack_light::serialize_to(stream, get_data(), options());        \
+    }
+
+// NOLINTNEXTLINE
+MSGPACK_LIGHT_BENCH_SERIALIZATION_BUFFERING(
+    buffering_small_integers, small_integers_fixture)
+
+// NOLINTNEXTLINE
+MSGPACK_LIGHT_BENCH_SERIALIZATION_BUFFERING(buffering_strings, strings_fixture)
+
+// NOLINTNEXTLINE
+MSGPACK_LIGHT_BENCH_SERIALIZATION_BUFFERING(
+    buffering_nested_maps, nested_maps_fixture)
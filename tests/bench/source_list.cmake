@@ -1,5 +1,6 @@
 set(SOURCE_FILES
     bench_main.cpp
+    serialization_buffering_test.cpp
     serialize_arrays_test.cpp
     serialize_binaries_test.cpp
     serialize_booleans_test.cpp
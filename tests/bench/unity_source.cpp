@@ -1,4 +1,5 @@
-#include "bench_main.cpp"               // NOLINT(bugprone-suspicious-include)
+#include "bench_main.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "serialization_buffering_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "serialize_arrays_test.cpp"    // NOLINT(bugprone-suspicious-include)
 #include "serialize_binaries_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "serialize_booleans_test.cpp"  // NOLINT(bugprone-suspicious-include)
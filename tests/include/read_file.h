@@ -0,0 +1,53 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of read_file function for tests.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+
+namespace msgpack_light_test {
+
+/*!
+ * \brief Read a file.
+ *
+ * \param[in] file_path File path.
+ * \return Data in the file.
+ */
+[[nodiscard]] inline msgpack_light::binary read_file(const char* file_path) {
+    std::FILE* file = std::fopen(file_path, "rb");
+    REQUIRE(file != nullptr);
+    msgpack_light::binary data;
+    unsigned char buffer[1024];  // NOLINT
+    while (true) {
+        const std::size_t size = std::fread(buffer, 1U, sizeof(buffer), file);
+        if (size == 0U) {
+            break;
+        }
+        data.append(buffer, size);
+    }
+    (void)std::fclose(file);
+    return data;
+}
+
+}  // namespace msgpack_light_test
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of aligned_allocator class.
+ */
+#include "msgpack_light/aligned_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+TEST_CASE("msgpack_light::aligned_allocator") {
+    using msgpack_light::aligned_allocator;
+
+    SECTION("allocate memory") {
+        const std::size_t min_alignment = GENERATE(static_cast<std::size_t>(1),
+            static_cast<std::size_t>(16), static_cast<std::size_t>(4096));
+        const std::size_t alignment = GENERATE(static_cast<std::size_t>(0),
+            static_cast<std::size_t>(8), static_cast<std::size_t>(64));
+        const std::size_t size = GENERATE(static_cast<std::size_t>(0),
+            static_cast<std::size_t>(3), static_cast<std::size_t>(10000));
+        INFO("min_alignment: " << min_alignment);
+        INFO("alignment: " << alignment);
+        INFO("size: " << size);
+        aligned_allocator allocator(min_alignment);
+        CHECK(allocator.min_alignment() == min_alignment);
+
+        void* ptr = allocator.allocate(size, alignment);
+
+        REQUIRE(ptr != nullptr);
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);  // NOLINT
+        CHECK(address % min_alignment == 0U);
+        if (alignment > 0U) {
+            CHECK(address % alignment == 0U);
+        }
+        std::memset(ptr, 0, size);
+        allocator.deallocate(ptr);
+    }
+
+    SECTION("deallocate null pointer") {
+        aligned_allocator allocator(16U);  // NOLINT
+        allocator.deallocate(nullptr);
+    }
+
+    SECTION("use invalid alignments") {
+        CHECK_THROWS_AS(aligned_allocator(0U), std::invalid_argument);
+        CHECK_THROWS_AS(aligned_allocator(3U), std::invalid_argument);
+        aligned_allocator allocator(1U);
+        CHECK_THROWS_AS(
+            (void)allocator.allocate(1U, 24U), std::invalid_argument);
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of allocator_reference class.
+ */
+#include "msgpack_light/allocator_reference.h"
+
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/monotonic_allocator.h"
+#include "msgpack_light/object.h"
+
+TEST_CASE("msgpack_light::allocator_reference") {
+    using msgpack_light::allocator_reference;
+    using msgpack_light::monotonic_allocator;
+
+    SECTION("allocate memory") {
+        monotonic_allocator arena;
+        allocator_reference<monotonic_allocator> allocator(arena);
+
+        void* ptr = allocator.allocate(7U, 4U);  // NOLINT
+
+        CHECK(ptr != nullptr);
+        CHECK(&allocator.get() == &arena);
+        allocator.deallocate(ptr);
+    }
+
+    SECTION("share an allocator among objects") {
+        monotonic_allocator arena;
+        using object_type =
+            msgpack_light::object<allocator_reference<monotonic_allocator>>;
+
+        object_type object1{allocator_reference<monotonic_allocator>(arena)};
+        object1.set_string("abc");
+        const object_type object2 = object1;  // NOLINT
+
+        CHECK(object2.as_string() == std::string_view("abc"));
+    }
+}
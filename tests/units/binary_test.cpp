@@ -19,11 +19,17 @@
  */
 #include "msgpack_light/binary.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include "msgpack_light/allocator_reference.h"
+#include "msgpack_light/monotonic_allocator.h"
+
 TEST_CASE("msgpack_light::details::calculate_expanded_memory_buffer_size") {
     using msgpack_light::details::calculate_expanded_memory_buffer_size;
 
@@ -381,6 +387,81 @@ TEST_CASE("msgpack_light::binary") {
     }
 }
 
+TEST_CASE("msgpack_light::binary with small data") {
+    using msgpack_light::binary;
+    using msgpack_light::binary_view;
+
+    SECTION("size of objects") {
+        STATIC_REQUIRE(sizeof(binary) <= 3U * sizeof(std::uint64_t));
+    }
+
+    SECTION("store small data in objects") {
+        const auto data = binary("0102030405");
+        const auto* begin = reinterpret_cast<const unsigned char*>(  // NOLINT
+            &data);
+
+        CHECK(data.data() >= begin);
+        CHECK(data.data() < begin + sizeof(data));  // NOLINT
+        CHECK(binary_view(data) == binary("0102030405"));
+    }
+
+    SECTION("store data up to the inline capacity in objects") {
+        auto data = binary();
+        CHECK(data.capacity() == sizeof(binary) - 1U);
+        for (std::size_t i = 0; i < sizeof(binary) - 1U; ++i) {
+            const auto byte = static_cast<unsigned char>(i);
+            data.append(&byte, 1U);
+        }
+        const auto* begin = reinterpret_cast<const unsigned char*>(  // NOLINT
+            &data);
+
+        CHECK(data.size() == sizeof(binary) - 1U);
+        CHECK(data.data() >= begin);
+        CHECK(data.data() < begin + sizeof(data));  // NOLINT
+        CHECK(data[sizeof(binary) - 2U] == sizeof(binary) - 2U);
+
+        const auto byte = static_cast<unsigned char>(100U);
+        data.append(&byte, 1U);
+        CHECK(data.size() == sizeof(binary));
+        CHECK(data[sizeof(binary) - 2U] == sizeof(binary) - 2U);
+        CHECK(data[sizeof(binary) - 1U] == 100U);
+    }
+
+    SECTION("move small data") {
+        auto data = binary("0102030405");
+
+        const binary moved = std::move(data);
+
+        CHECK(moved == binary("0102030405"));
+        CHECK(data.size() == 0U);  // NOLINT(bugprone-use-after-move)
+    }
+
+    SECTION("swap small and large data") {
+        const auto small_data = binary("0102");
+        const auto large_data = binary(
+            std::vector<unsigned char>(100U, static_cast<unsigned char>(3)));
+        auto data1 = small_data;
+        auto data2 = large_data;
+
+        swap(data1, data2);
+
+        CHECK(data1 == large_data);
+        CHECK(data2 == small_data);
+    }
+
+    SECTION("append data beyond the inline capacity") {
+        auto data = binary("01");
+        const auto appended = binary(
+            std::vector<unsigned char>(30U, static_cast<unsigned char>(2)));
+
+        data += appended;
+
+        CHECK(data.size() == 31U);
+        CHECK(data[0] == 1U);
+        CHECK(data[30] == 2U);
+    }
+}
+
 TEST_CASE("msgpack_light::binary_view") {
     using msgpack_light::binary;
     using msgpack_light::binary_view;
@@ -428,3 +509,49 @@ TEST_CASE("msgpack_light::binary_view") {
         CHECK(binary("010203") != binary_view(binary("0102")));
     }
 }
+
+TEST_CASE("msgpack_light::basic_binary") {
+    using msgpack_light::allocator_reference;
+    using msgpack_light::basic_binary;
+    using msgpack_light::binary;
+    using msgpack_light::monotonic_allocator;
+
+    SECTION("use monotonic_allocator") {
+        auto data = basic_binary<monotonic_allocator>("010203");
+
+        data.append(binary("0405").data(), 2U);
+        data.resize(1000U);  // NOLINT
+        data.resize(5U);     // NOLINT
+
+        CHECK(data == binary("0102030405"));
+    }
+
+    SECTION("share an allocator") {
+        monotonic_allocator arena;
+        using binary_type =
+            basic_binary<allocator_reference<monotonic_allocator>>;
+
+        auto data1 = binary_type(
+            binary("010203"), allocator_reference<monotonic_allocator>(arena));
+        auto data2 = binary_type(
+            binary("0405"), allocator_reference<monotonic_allocator>(arena));
+        data1 += data2;
+
+        CHECK(data1 == binary("0102030405"));
+        CHECK(&data1.get_allocator().get() == &arena);
+
+        SECTION("copy") {
+            const binary_type copy = data1;
+
+            CHECK(copy == data1);
+            CHECK(&copy.get_allocator().get() == &arena);
+        }
+
+        SECTION("move") {
+            const binary_type moved = std::move(data1);
+
+            CHECK(moved == binary("0102030405"));
+            CHECK(&moved.get_allocator().get() == &arena);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of checksumming_output_stream class.
+ */
+#include "msgpack_light/checksumming_output_stream.h"
+
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+
+TEST_CASE("msgpack_light::checksumming_output_stream") {
+    using msgpack_light::binary;
+    using msgpack_light::checksumming_output_stream;
+    using msgpack_light::memory_output_stream;
+
+    SECTION("calculate checksum") {
+        memory_output_stream output;
+        checksumming_output_stream stream(output);
+        CHECK(stream.checksum() == 0U);
+
+        const auto data1 = binary("3132333435");
+        stream.write(data1.data(), data1.size());
+        const auto data2 = binary("36373839");
+        stream.write(data2.data(), data2.size());
+
+        CHECK(output.as_binary() == data1 + data2);
+        CHECK(stream.checksum() == 0xE3069283U);
+    }
+
+    SECTION("append checksums of frames") {
+        memory_output_stream output;
+        checksumming_output_stream stream(output);
+
+        const auto data = binary("313233343536373839");
+        stream.write(data.data(), data.size());
+        stream.append_checksum();
+        CHECK(stream.checksum() == 0U);
+        stream.write(data.data(), data.size());
+        stream.append_checksum();
+
+        CHECK(output.as_binary() ==
+            binary("313233343536373839"
+                   "E3069283"
+                   "313233343536373839"
+                   "E3069283"));
+    }
+
+    SECTION("reset checksum") {
+        memory_output_stream output;
+        checksumming_output_stream stream(output);
+        const auto data = binary("0102");
+        stream.write(data.data(), data.size());
+
+        stream.reset();
+
+        CHECK(stream.checksum() == 0U);
+    }
+
+    SECTION("serialize data") {
+        memory_output_stream output;
+        checksumming_output_stream stream(output);
+
+        msgpack_light::serialize_to(stream, std::string("123456789"));
+
+        CHECK(stream.checksum() ==
+            msgpack_light::details::crc32c(output.data(), output.size()));
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of chunked_memory_output_stream class.
+ */
+#include "msgpack_light/chunked_memory_output_stream.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+
+TEST_CASE("msgpack_light::chunked_memory_output_stream") {
+    using msgpack_light::binary;
+    using msgpack_light::chunked_memory_output_stream;
+
+    SECTION("initialize") {
+        chunked_memory_output_stream stream;
+
+        CHECK(stream.size() == 0U);
+        CHECK(stream.segment_size() ==
+            chunked_memory_output_stream::default_segment_size);
+        CHECK(stream.num_segments() == 0U);
+        CHECK(stream.segments().empty());
+        CHECK(stream.to_binary() == binary());
+    }
+
+    SECTION("write data in a segment") {
+        chunked_memory_output_stream stream(8U);  // NOLINT
+
+        const auto written_data = binary("010203");
+        stream.write(written_data.data(), written_data.size());
+
+        CHECK(stream.size() == 3U);
+        CHECK(stream.num_segments() == 1U);
+        CHECK(stream.to_binary() == written_data);
+    }
+
+    SECTION("write data in segments") {
+        chunked_memory_output_stream stream(4U);  // NOLINT
+
+        const auto written_data1 = binary("010203");
+        stream.write(written_data1.data(), written_data1.size());
+        const auto written_data2 = binary("040506070809");
+        stream.write(written_data2.data(), written_data2.size());
+
+        CHECK(stream.size() == 9U);
+        const auto segments = stream.segments();
+        REQUIRE(segments.size() == 3U);
+        CHECK(segments[0] == binary("01020304"));
+        CHECK(segments[1] == binary("05060708"));
+        CHECK(segments[2] == binary("09"));
+        CHECK(stream.to_binary() == written_data1 + written_data2);
+
+        msgpack_light::memory_output_stream another_stream;
+        stream.write_to(another_stream);
+        CHECK(another_stream.as_binary() == written_data1 + written_data2);
+    }
+
+    SECTION("serialize large data") {
+        chunked_memory_output_stream stream(100U);  // NOLINT
+        const auto data = std::vector<int>(1000U, 1000);  // NOLINT
+
+        msgpack_light::serialize_to(stream, data);
+
+        const auto expected = msgpack_light::serialize(data);
+        CHECK(stream.to_binary() == expected);
+        CHECK(stream.num_segments() == (expected.size() + 99U) / 100U);
+    }
+
+    SECTION("clear data") {
+        chunked_memory_output_stream stream(4U);  // NOLINT
+        const auto written_data1 = binary("0102030405");
+        stream.write(written_data1.data(), written_data1.size());
+        const unsigned char* first_segment = stream.segments()[0].data();
+
+        stream.clear();
+
+        CHECK(stream.size() == 0U);
+        CHECK(stream.num_segments() == 0U);
+        CHECK(stream.to_binary() == binary());
+
+        SECTION("write the next data") {
+            const auto written_data2 = binary("0607");
+            stream.write(written_data2.data(), written_data2.size());
+
+            CHECK(stream.to_binary() == written_data2);
+            CHECK(stream.num_segments() == 1U);
+            CHECK(stream.segments()[0].data() == first_segment);
+        }
+    }
+
+    SECTION("invalid segment size") {
+        CHECK_THROWS_AS(
+            chunked_memory_output_stream(0U), std::invalid_argument);
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of compressing_output_stream class.
+ */
+#include "msgpack_light/compressing_output_stream.h"
+
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/decompressing_reader.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/output_stream.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+#include "msgpack_light/type_support/map.h"
+
+namespace {
+
+/*!
+ * \brief Class of streams throwing exceptions in writing data.
+ */
+class throwing_output_stream final : public msgpack_light::output_stream {
+public:
+    void write(const unsigned char* /*data*/, std::size_t /*size*/) override {
+        ++num_writes;
+        throw std::runtime_error("Failed to write data.");
+    }
+
+    //! Number of calls of write function.
+    std::size_t num_writes{0U};
+};
+
+}  // namespace
+
+TEST_CASE("msgpack_light::compressing_output_stream") {
+    using msgpack_light::binary;
+    using msgpack_light::compressing_output_stream;
+    using msgpack_light::decompressing_reader;
+    using msgpack_light::memory_output_stream;
+
+    SECTION("write data") {
+        memory_output_stream output;
+        compressing_output_stream stream(output);
+
+        const auto written_data = binary("010203");
+        stream.write(written_data.data(), written_data.size());
+        CHECK(output.size() == 0U);
+        stream.flush();
+
+        // Data which cannot be compressed is stored as is.
+        CHECK(output.as_binary() ==
+            binary("00000003"
+                   "00000003"
+                   "010203"));
+    }
+
+    SECTION("write data in blocks") {
+        memory_output_stream output;
+        constexpr std::size_t block_size = 16U;
+        compressing_output_stream stream(output, block_size);
+        CHECK(stream.block_size() == block_size);
+
+        const auto written_data = binary(
+            std::vector<unsigned char>(40U, static_cast<unsigned char>(7)));
+        stream.write(written_data.data(), written_data.size());
+        stream.flush();
+
+        CHECK(output.as_binary() ==
+            binary("00000010"
+                   "0000000A"
+                   "16070100"
+                   "500707070707"
+                   "00000010"
+                   "0000000A"
+                   "16070100"
+                   "500707070707"
+                   "00000008"
+                   "00000008"
+                   "0707070707070707"));
+        decompressing_reader reader(output.data(), output.size());
+        CHECK(reader.read_all() == written_data);
+    }
+
+    SECTION("compress serialized data") {
+        std::vector<std::map<std::string, int>> value;
+        for (int i = 0; i < 1000; ++i) {  // NOLINT
+            value.push_back({{"id", i}, {"value", i * 2}, {"flag", 1}});
+        }
+        const binary serialized = msgpack_light::serialize(value);
+
+        memory_output_stream output;
+        {
+            compressing_output_stream stream(output);
+            msgpack_light::serialize_to(stream, value);
+        }
+
+        CHECK(output.size() < serialized.size() / 2U);
+        decompressing_reader reader(output.data(), output.size());
+        CHECK(reader.read_all() == serialized);
+    }
+
+    SECTION("flush in the destructor with errors") {
+        throwing_output_stream output;
+        {
+            compressing_output_stream stream(output);
+            const auto written_data = binary("010203");
+            stream.write(written_data.data(), written_data.size());
+        }
+        CHECK(output.num_writes == 1U);
+    }
+
+    SECTION("use invalid block sizes") {
+        memory_output_stream output;
+        CHECK_THROWS_AS(compressing_output_stream(output, 0U),
+            std::invalid_argument);
+        CHECK_THROWS_AS(compressing_output_stream(output,
+                            msgpack_light::max_compression_block_size + 1U),
+            std::invalid_argument);
+    }
+}
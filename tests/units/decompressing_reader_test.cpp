@@ -0,0 +1,108 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of decompressing_reader class.
+ */
+#include "msgpack_light/decompressing_reader.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/compressing_output_stream.h"
+#include "msgpack_light/memory_output_stream.h"
+
+TEST_CASE("msgpack_light::decompressing_reader") {
+    using msgpack_light::binary;
+    using msgpack_light::binary_view;
+    using msgpack_light::compressing_output_stream;
+    using msgpack_light::decompressing_reader;
+    using msgpack_light::memory_output_stream;
+
+    memory_output_stream output;
+    binary data(1000U);  // NOLINT
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>(i % 10U);  // NOLINT
+    }
+    {
+        constexpr std::size_t block_size = 300U;
+        compressing_output_stream stream(output, block_size);
+        stream.write(data.data(), data.size());
+    }
+
+    SECTION("read blocks") {
+        decompressing_reader reader(output.as_binary());
+
+        CHECK(reader.has_next());
+        CHECK(reader.read_block() == binary(data.data(), 300U));
+        CHECK(reader.has_next());
+        CHECK(reader.read_block() == binary(data.data() + 300U, 300U));
+        CHECK(reader.has_next());
+        CHECK(reader.read_block() == binary(data.data() + 600U, 300U));
+        CHECK(reader.has_next());
+        CHECK(reader.read_block() == binary(data.data() + 900U, 100U));
+        CHECK_FALSE(reader.has_next());
+    }
+
+    SECTION("decompress frames separately") {
+        decompressing_reader reader(output.data(), output.size());
+        std::vector<binary_view> frames;
+        while (reader.has_next()) {
+            frames.push_back(reader.next_frame());
+        }
+        REQUIRE(frames.size() == 4U);
+
+        binary result;
+        for (auto iter = frames.rbegin(); iter != frames.rend(); ++iter) {
+            result = decompressing_reader::decompress_frame(*iter) + result;
+        }
+
+        CHECK(result == data);
+    }
+
+    SECTION("read incomplete data") {
+        decompressing_reader reader(output.data(), output.size() - 1U);
+
+        CHECK_THROWS_AS((void)reader.read_all(), std::runtime_error);
+    }
+
+    SECTION("read invalid frames") {
+        const auto frame = binary(
+            "00000008"
+            "00000002"
+            "8001");
+        decompressing_reader reader(frame);
+
+        CHECK_THROWS_AS((void)reader.read_all(), std::runtime_error);
+    }
+
+    SECTION("read frames with too large sizes of the original data") {
+        const auto frame = binary(
+            "40000000"
+            "00000001"
+            "00");
+        decompressing_reader reader(frame);
+
+        CHECK_THROWS_AS((void)reader.read_all(), std::runtime_error);
+        CHECK_THROWS_AS(
+            (void)decompressing_reader::decompress_frame(frame),
+            std::runtime_error);
+    }
+}
@@ -19,8 +19,12 @@
  */
 #include "msgpack_light/details/basic_binary_buffer.h"
 
+#include <cstddef>
+#include <cstdint>
+
 #include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 TEST_CASE("msgpack_light::details::basic_binary_buffer") {
     using msgpack_light::details::basic_binary_buffer;
@@ -238,4 +242,79 @@ TEST_CASE("msgpack_light::details::basic_binary_buffer") {
             CHECK(static_cast<std::size_t>(buffer2.data()[i]) == i);
         }
     }
+
+    SECTION("store small buffers inline") {
+        const std::size_t size =
+            GENERATE(static_cast<std::size_t>(0U), static_cast<std::size_t>(1U),
+                basic_binary_buffer<>::inline_capacity);
+        INFO("size: " << size);
+
+        const auto buffer = basic_binary_buffer(size);
+
+        CHECK(buffer.is_inline());
+        const auto* begin = reinterpret_cast<const unsigned char*>(  // NOLINT
+            &buffer);
+        CHECK(buffer.data() >= begin);
+        CHECK(buffer.data() < begin + sizeof(buffer));  // NOLINT
+    }
+
+    SECTION("move between inline and allocated buffers") {
+        constexpr std::size_t inline_capacity =
+            basic_binary_buffer<>::inline_capacity;
+        constexpr std::size_t size1 = inline_capacity;
+        auto buffer = basic_binary_buffer(size1);
+        for (std::size_t i = 0; i < size1; ++i) {
+            buffer.data()[i] = static_cast<unsigned char>(i);
+        }
+
+        constexpr std::size_t size2 = inline_capacity * 4U;
+        buffer.resize(size2);
+        CHECK_FALSE(buffer.is_inline());
+        for (std::size_t i = size1; i < size2; ++i) {
+            buffer.data()[i] = static_cast<unsigned char>(i);
+        }
+
+        constexpr std::size_t size3 = inline_capacity - 1U;
+        buffer.resize(size3);
+        CHECK_FALSE(buffer.is_inline());
+        CHECK(buffer.size() == size3);
+        CHECK(buffer.capacity() == size2);
+        for (std::size_t i = 0; i < size3; ++i) {
+            INFO("i = " << i);
+            CHECK(static_cast<std::size_t>(buffer.data()[i]) == i);
+        }
+    }
+
+    SECTION("reserve memory") {
+        auto buffer = basic_binary_buffer(3U);
+        buffer.data()[2] = static_cast<unsigned char>(7U);
+        CHECK(buffer.capacity() == basic_binary_buffer<>::inline_capacity);
+
+        constexpr std::size_t capacity = 1000U;
+        buffer.reserve(capacity);
+        CHECK_FALSE(buffer.is_inline());
+        CHECK(buffer.size() == 3U);
+        CHECK(buffer.capacity() == capacity);
+        CHECK(static_cast<std::size_t>(buffer.data()[2]) == 7U);
+
+        buffer.reserve(capacity / 2U);
+        CHECK(buffer.capacity() == capacity);
+    }
+
+    SECTION("size of objects") {
+        STATIC_REQUIRE(sizeof(basic_binary_buffer<>) ==
+            sizeof(void*) + sizeof(std::size_t) + sizeof(std::uint64_t));
+        STATIC_REQUIRE(basic_binary_buffer<>::inline_capacity ==
+            sizeof(basic_binary_buffer<>) - 1U);
+    }
+
+    SECTION("leave moved buffers empty") {
+        constexpr std::size_t size = 100U;
+        auto buffer = basic_binary_buffer(size);
+
+        const basic_binary_buffer moved{std::move(buffer)};
+
+        CHECK(moved.size() == size);
+        CHECK(buffer.size() == 0U);  // NOLINT(bugprone-use-after-move)
+    }
 }
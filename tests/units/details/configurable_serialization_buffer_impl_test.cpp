@@ -0,0 +1,164 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of configurable_serialization_buffer_impl class.
+ */
+#include "msgpack_light/details/configurable_serialization_buffer_impl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/output_stream.h"
+
+namespace {
+
+/*!
+ * \brief Class of streams to count calls of write function.
+ */
+class write_counting_output_stream final
+    : public msgpack_light::output_stream {
+public:
+    void write(const unsigned char* data, std::size_t size) override {
+        ++num_writes;
+        stream.write(data, size);
+    }
+
+    //! Number of calls of write function.
+    std::size_t num_writes{0U};
+
+    //! Stream to write data to.
+    msgpack_light::memory_output_stream stream;
+};
+
+}  // namespace
+
+TEST_CASE("msgpack_light::details::configurable_serialization_buffer_impl") {
+    using msgpack_light::binary;
+    using msgpack_light::memory_output_stream;
+    using msgpack_light::details::configurable_serialization_buffer_impl;
+
+    const std::size_t buffer_size = GENERATE(static_cast<std::size_t>(0U),
+        static_cast<std::size_t>(1U), static_cast<std::size_t>(4U),
+        static_cast<std::size_t>(512U), static_cast<std::size_t>(4096U));
+    INFO("buffer_size: " << buffer_size);
+
+    SECTION("write data") {
+        const std::size_t data_size = GENERATE(static_cast<std::size_t>(0),
+            static_cast<std::size_t>(1), static_cast<std::size_t>(511),
+            static_cast<std::size_t>(4097));
+        INFO("data_size: " << data_size);
+        const auto data = binary(std::vector<unsigned char>(
+            data_size, static_cast<unsigned char>(0x81)));
+
+        memory_output_stream stream;
+        configurable_serialization_buffer_impl buffer(stream, buffer_size);
+        CHECK(buffer.buffer_size() == buffer_size);
+
+        buffer.write(data.data(), data.size());
+        buffer.write(data.data(), data.size());
+
+        buffer.flush();
+        CHECK(stream.as_binary() == data + data);
+    }
+
+    SECTION("write bytes") {
+        memory_output_stream stream;
+        configurable_serialization_buffer_impl buffer(stream, buffer_size);
+
+        for (int i = 0; i < 10; ++i) {  // NOLINT
+            buffer.put(static_cast<unsigned char>(i));
+        }
+
+        buffer.flush();
+        CHECK(stream.as_binary() == binary("00010203040506070809"));
+    }
+
+    SECTION("write integers in big endian") {
+        memory_output_stream stream;
+        configurable_serialization_buffer_impl buffer(stream, buffer_size);
+
+        constexpr auto value1 = static_cast<std::uint8_t>(0x12);
+        constexpr auto value2 = static_cast<std::uint32_t>(0x3456789AU);
+        constexpr auto value3 = static_cast<std::uint16_t>(0xBCDE);
+        buffer.put(static_cast<unsigned char>(0x01));
+        buffer.write_in_big_endian(value1, value2, value3);
+        buffer.write_in_big_endian(value2);
+
+        buffer.flush();
+        CHECK(stream.as_binary() == binary("01123456789ABCDE3456789A"));
+    }
+
+    SECTION("flush data in destructor") {
+        memory_output_stream stream;
+        {
+            configurable_serialization_buffer_impl buffer(stream, buffer_size);
+            buffer.put(static_cast<unsigned char>(0x01));
+        }
+
+        CHECK(stream.as_binary() == binary("01"));
+    }
+}
+
+TEST_CASE(
+    "msgpack_light::details::configurable_serialization_buffer_impl (number "
+    "of writes)") {
+    using msgpack_light::details::configurable_serialization_buffer_impl;
+
+    SECTION("write without buffers") {
+        write_counting_output_stream stream;
+        configurable_serialization_buffer_impl buffer(stream, 0U);
+
+        for (int i = 0; i < 10; ++i) {  // NOLINT
+            buffer.put(static_cast<unsigned char>(i));
+        }
+        buffer.flush();
+
+        CHECK(stream.num_writes == 10U);
+    }
+
+    SECTION("write with buffers") {
+        write_counting_output_stream stream;
+        configurable_serialization_buffer_impl buffer(stream, 4U);
+
+        for (int i = 0; i < 10; ++i) {  // NOLINT
+            buffer.put(static_cast<unsigned char>(i));
+        }
+        buffer.flush();
+
+        CHECK(stream.num_writes == 3U);
+    }
+
+    SECTION("write integers without buffers") {
+        write_counting_output_stream stream;
+        configurable_serialization_buffer_impl buffer(stream, 0U);
+
+        buffer.write_in_big_endian(static_cast<std::uint32_t>(0x12345678U),
+            static_cast<std::uint16_t>(0x9ABC));
+        buffer.flush();
+
+        CHECK(stream.num_writes == 1U);
+        CHECK(stream.stream.as_binary() ==
+            msgpack_light::binary("123456789ABC"));
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of functions to calculate CRC32C.
+ */
+#include "msgpack_light/details/crc32c.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+
+TEST_CASE("msgpack_light::details::crc32c") {
+    using msgpack_light::details::crc32c;
+
+    SECTION("calculate CRC32C") {
+        constexpr std::string_view data = "123456789";
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+        CHECK(crc32c(bytes, data.size()) == 0xE3069283U);
+    }
+
+    SECTION("calculate CRC32C of empty data") {
+        CHECK(crc32c(nullptr, 0U) == 0U);
+    }
+
+    SECTION("calculate CRC32C of zeros") {
+        const auto data = msgpack_light::binary(
+            std::vector<unsigned char>(32U, static_cast<unsigned char>(0)));
+
+        // Test vector in RFC 3720.
+        CHECK(crc32c(data.data(), data.size()) == 0x8A9136AAU);
+    }
+}
+
+TEST_CASE("msgpack_light::details::update_crc32c") {
+    using msgpack_light::details::update_crc32c;
+    using msgpack_light::details::update_crc32c_with_tables;
+
+    SECTION("update CRC32C in parts") {
+        const std::size_t size = GENERATE(static_cast<std::size_t>(1),
+            static_cast<std::size_t>(7), static_cast<std::size_t>(8),
+            static_cast<std::size_t>(1000), static_cast<std::size_t>(5000));
+        INFO("size: " << size);
+        std::mt19937 engine;  // NOLINT
+        std::uniform_int_distribution<unsigned int> dist(0U, 255U);  // NOLINT
+        msgpack_light::binary data(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<unsigned char>(dist(engine));
+        }
+        constexpr std::uint32_t initial = 0xFFFFFFFFU;
+
+        const std::uint32_t expected =
+            update_crc32c_with_tables(initial, data.data(), data.size());
+
+        CHECK(update_crc32c(initial, data.data(), data.size()) == expected);
+        for (std::size_t split = 0; split <= size; split += 3U) {
+            INFO("split: " << split);
+            const std::uint32_t first =
+                update_crc32c(initial, data.data(), split);
+            CHECK(update_crc32c(first, data.data() + split, size - split) ==
+                expected);
+        }
+    }
+}
+
+#if INTERNAL_MSGPACK_LIGHT_HAS_X86_CRC32C
+
+TEST_CASE("msgpack_light::details::update_crc32c_with_pclmul") {
+    using msgpack_light::details::update_crc32c_with_pclmul;
+    using msgpack_light::details::update_crc32c_with_sse42;
+    using msgpack_light::details::update_crc32c_with_tables;
+
+    const std::size_t size = GENERATE(static_cast<std::size_t>(0),
+        static_cast<std::size_t>(1535), static_cast<std::size_t>(1536),
+        static_cast<std::size_t>(1537), static_cast<std::size_t>(10000));
+    INFO("size: " << size);
+    std::mt19937 engine;  // NOLINT
+    std::uniform_int_distribution<unsigned int> dist(0U, 255U);  // NOLINT
+    msgpack_light::binary data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<unsigned char>(dist(engine));
+    }
+    constexpr std::uint32_t initial = 0x12345678U;
+
+    const std::uint32_t expected =
+        update_crc32c_with_tables(initial, data.data(), data.size());
+
+    if (__builtin_cpu_supports("sse4.2")) {
+        CHECK(update_crc32c_with_sse42(initial, data.data(), data.size()) ==
+            expected);
+        if (__builtin_cpu_supports("pclmul")) {
+            CHECK(update_crc32c_with_pclmul(
+                      initial, data.data(), data.size()) == expected);
+        }
+    }
+}
+
+#endif
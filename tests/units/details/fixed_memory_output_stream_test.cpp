@@ -0,0 +1,54 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of fixed_memory_output_stream class.
+ */
+#include "msgpack_light/details/fixed_memory_output_stream.h"
+
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+
+TEST_CASE("msgpack_light::details::fixed_memory_output_stream") {
+    using msgpack_light::binary;
+    using msgpack_light::details::fixed_memory_output_stream;
+
+    SECTION("write data") {
+        binary buffer(5U);
+        fixed_memory_output_stream stream(buffer.data(), buffer.size());
+
+        const auto data = binary("010203");
+        stream.write(data.data(), data.size());
+        stream.write(data.data(), 0U);
+        stream.write(data.data(), 2U);
+
+        CHECK(stream.size() == 5U);
+        CHECK(buffer == binary("0102030102"));
+    }
+
+    SECTION("write too large data") {
+        binary buffer(2U);
+        fixed_memory_output_stream stream(buffer.data(), buffer.size());
+
+        const auto data = binary("010203");
+        CHECK_THROWS_AS(
+            stream.write(data.data(), data.size()), std::runtime_error);
+        CHECK(stream.size() == 0U);
+    }
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of functions of a LZ77-based compression codec.
+ */
+#include "msgpack_light/details/lz_codec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+
+TEST_CASE("msgpack_light::details::lz_compress_block") {
+    using msgpack_light::binary;
+    using msgpack_light::details::lz_compress_block;
+    using msgpack_light::details::lz_decompress_block;
+    using msgpack_light::details::lz_max_compressed_size;
+    using msgpack_light::details::lz_max_decompressed_size;
+
+    std::vector<std::uint32_t> hash_table;
+
+    SECTION("compress short data") {
+        const auto data = binary("01020304");
+        binary compressed(lz_max_compressed_size(data.size()));
+
+        const std::size_t compressed_size = lz_compress_block(
+            data.data(), data.size(), compressed.data(), hash_table);
+
+        compressed.resize(compressed_size);
+        CHECK(compressed == binary("4001020304"));
+    }
+
+    SECTION("compress repeated data") {
+        binary data;
+        for (std::size_t i = 0; i < 10U; ++i) {  // NOLINT
+            data += binary("0102030405060708");
+        }
+        binary compressed(lz_max_compressed_size(data.size()));
+
+        const std::size_t compressed_size = lz_compress_block(
+            data.data(), data.size(), compressed.data(), hash_table);
+
+        // 8 literals, match of 67 bytes at offset 8, 5 literals.
+        compressed.resize(compressed_size);
+        CHECK(compressed ==
+            binary("8F"
+                   "0102030405060708"
+                   "0800"
+                   "30"
+                   "50"
+                   "0405060708"));
+        binary decompressed(data.size());
+        lz_decompress_block(compressed.data(), compressed.size(),
+            decompressed.data(), decompressed.size());
+        CHECK(decompressed == data);
+    }
+
+    SECTION("compress data with the highest ratio") {
+        const binary data(std::vector<unsigned char>(
+            static_cast<std::size_t>(1000000U), static_cast<unsigned char>(0)));
+        binary compressed(lz_max_compressed_size(data.size()));
+
+        const std::size_t compressed_size = lz_compress_block(
+            data.data(), data.size(), compressed.data(), hash_table);
+
+        CHECK(data.size() <= lz_max_decompressed_size(compressed_size));
+    }
+
+    SECTION("compress and decompress random data") {
+        const std::size_t size = GENERATE(static_cast<std::size_t>(0),
+            static_cast<std::size_t>(1), static_cast<std::size_t>(13),
+            static_cast<std::size_t>(100), static_cast<std::size_t>(100000));
+        const unsigned int max_byte = GENERATE(1U, 3U, 255U);
+        INFO("size: " << size);
+        INFO("max_byte: " << max_byte);
+
+        std::mt19937 engine;  // NOLINT
+        std::uniform_int_distribution<unsigned int> dist(0U, max_byte);
+        binary data(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<unsigned char>(dist(engine));
+        }
+        binary compressed(lz_max_compressed_size(data.size()));
+
+        const std::size_t compressed_size = lz_compress_block(
+            data.data(), data.size(), compressed.data(), hash_table);
+        INFO("compressed_size: " << compressed_size);
+
+        binary decompressed(size);
+        lz_decompress_block(compressed.data(), compressed_size,
+            decompressed.data(), decompressed.size());
+        CHECK(decompressed == data);
+    }
+}
+
+TEST_CASE("msgpack_light::details::lz_decompress_block") {
+    using msgpack_light::binary;
+    using msgpack_light::details::lz_decompress_block;
+
+    SECTION("decompress invalid data") {
+        binary compressed;
+        std::size_t size{};
+        std::tie(compressed, size) = GENERATE(table<binary, std::size_t>({
+            // Empty data.
+            {binary(), 0U},
+            // Too many literals.
+            {binary("500102030405"), 4U},
+            // Incomplete literals.
+            {binary("4001020304"), 5U},
+            // Incomplete offset.
+            {binary("4001020304" "05"), 10U},
+            // Offset out of range.
+            {binary("40010203040500"), 10U},
+            // Zero offset.
+            {binary("40010203040000"), 10U},
+            // Wrong size of the output.
+            {binary("4001020304"), 6U},
+        }));
+        INFO("compressed: " << compressed);
+
+        binary output(size);
+        CHECK_THROWS_AS(lz_decompress_block(compressed.data(),
+                            compressed.size(), output.data(), size),
+            std::runtime_error);
+    }
+}
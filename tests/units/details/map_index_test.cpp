@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of functions of hash indices of keys in maps.
+ */
+#include "msgpack_light/details/map_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/object.h"
+#include "msgpack_light/object_data_type.h"
+
+TEST_CASE("msgpack_light::details::map_lookup_key") {
+    using msgpack_light::details::map_lookup_key;
+    using msgpack_light::details::object_data;
+    using msgpack_light::object_data_type;
+
+    SECTION("compare integers") {
+        object_data unsigned_data{};
+        unsigned_data.type = object_data_type::unsigned_integer;
+        unsigned_data.data.unsigned_integer_value = 5U;
+        object_data signed_data{};
+        signed_data.type = object_data_type::signed_integer;
+        signed_data.data.signed_integer_value = 5;
+        object_data negative_data{};
+        negative_data.type = object_data_type::signed_integer;
+        negative_data.data.signed_integer_value = -5;
+
+        CHECK(map_lookup_key(std::uint64_t{5}).matches(unsigned_data));
+        CHECK(map_lookup_key(std::uint64_t{5}).matches(signed_data));
+        CHECK(map_lookup_key(std::int64_t{5}).matches(unsigned_data));
+        CHECK(map_lookup_key(std::int64_t{5}).matches(signed_data));
+        CHECK_FALSE(map_lookup_key(std::int64_t{5}).matches(negative_data));
+        CHECK(map_lookup_key(std::int64_t{-5}).matches(negative_data));
+        CHECK_FALSE(map_lookup_key(std::int64_t{-5}).matches(unsigned_data));
+        CHECK_FALSE(map_lookup_key(static_cast<std::uint64_t>(-5))
+                .matches(negative_data));
+        CHECK(map_lookup_key(std::uint64_t{5}).hash() ==
+            map_lookup_key(std::int64_t{5}).hash());
+    }
+
+    SECTION("compare strings") {
+        std::string value = "abc";
+        object_data data{};
+        data.type = object_data_type::string;
+        data.data.string_value = value.data();
+        data.size = static_cast<std::uint32_t>(value.size());
+
+        CHECK(map_lookup_key(std::string_view("abc")).matches(data));
+        CHECK_FALSE(map_lookup_key(std::string_view("ab")).matches(data));
+        CHECK_FALSE(map_lookup_key(std::uint64_t{0}).matches(data));
+
+        map_lookup_key key{std::uint64_t{0}};
+        REQUIRE(map_lookup_key::from_object_data(data, key));
+        CHECK(key.hash() == map_lookup_key(std::string_view("abc")).hash());
+    }
+
+    SECTION("create from unsupported data") {
+        object_data data{};
+        data.type = object_data_type::float64;
+        map_lookup_key key{std::uint64_t{0}};
+        CHECK_FALSE(map_lookup_key::from_object_data(data, key));
+    }
+}
+
+TEST_CASE("msgpack_light::details::prepare_map_index") {
+    using msgpack_light::details::find_in_map;
+    using msgpack_light::details::get_map_header;
+    using msgpack_light::details::map_lookup_key;
+    using msgpack_light::details::prepare_map_index;
+
+    msgpack_light::object<> obj;
+
+    SECTION("build an index of a large map") {
+        constexpr std::size_t size = 100;
+        auto map_ref = obj.set_map(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            map_ref.key(i).set_string(std::to_string(i % 50U));
+        }
+        auto& data = obj.data();
+        CHECK(get_map_header(data.data.map_value)->index == nullptr);
+
+        prepare_map_index(data, obj.allocator());
+        const auto* index = get_map_header(data.data.map_value)->index;
+        REQUIRE(index != nullptr);
+        CHECK(index->is_valid);
+        CHECK(index->num_slots == 256U);
+
+        // The first pair is found for duplicate keys.
+        for (std::size_t i = 0; i < 50U; ++i) {
+            CHECK(find_in_map(data, map_lookup_key(std::to_string(i))) == i);
+        }
+        CHECK(find_in_map(data, map_lookup_key(std::string_view("50"))) ==
+            size);
+    }
+
+    SECTION("skip small maps") {
+        auto map_ref = obj.set_map(3U);
+        map_ref.key(0).set_string("a");
+        auto& data = obj.data();
+
+        prepare_map_index(data, obj.allocator());
+        CHECK(get_map_header(data.data.map_value)->index == nullptr);
+        CHECK(find_in_map(data, map_lookup_key(std::string_view("a"))) == 0U);
+        CHECK(find_in_map(data, map_lookup_key(std::string_view("b"))) == 3U);
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of msgpack_object_size function.
+ */
+#include "msgpack_light/details/msgpack_object_size.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+#include "msgpack_light/type_support/map.h"     // IWYU pragma: keep
+
+TEST_CASE("msgpack_light::details::msgpack_object_size") {
+    using msgpack_light::binary;
+    using msgpack_light::details::msgpack_object_size;
+
+    SECTION("calculate sizes of objects") {
+        const auto data = GENERATE(binary("C0"), binary("C2"), binary("C3"),
+            binary("7F"), binary("E0"), binary("CC80"), binary("CD1234"),
+            binary("CE12345678"), binary("CF0123456789ABCDEF"), binary("D080"),
+            binary("D11234"), binary("D212345678"),
+            binary("D30123456789ABCDEF"), binary("CA3F800000"),
+            binary("CB3FF0000000000000"), binary("A3616263"),
+            binary("D903616263"), binary("DA0003616263"),
+            binary("DB00000003616263"), binary("C403010203"),
+            binary("C50003010203"), binary("C600000003010203"),
+            binary("93010203"), binary("DC0002C0C0"), binary("DD00000001C0"),
+            binary("8201C002C0"), binary("DE000101C0"),
+            binary("DF0000000101C0"), binary("D40101"), binary("D5010102"),
+            binary("D60101020304"),
+            binary("D7010102030405060708"),
+            binary("D801000102030405060708090A0B0C0D0E0F"),
+            binary("C70201AABB"), binary("C8000201AABB"),
+            binary("C90000000201AABB"), binary("9291C08101A0"));
+        INFO("data: " << data);
+
+        CHECK(msgpack_object_size(data.data(), data.size()) == data.size());
+    }
+
+    SECTION("calculate sizes of serialized objects") {
+        const auto data = msgpack_light::serialize(
+            std::map<std::string, std::vector<int>>{{"abc", {1, 1000, -100000}},
+                {"def", {}}, {std::string(100, 'a'), std::vector<int>(20, 3)}});
+
+        CHECK(msgpack_object_size(data.data(), data.size()) == data.size());
+    }
+
+    SECTION("calculate the size of the first object") {
+        const auto data = binary("9201029303");
+
+        CHECK(msgpack_object_size(data.data(), data.size()) == 3U);
+    }
+
+    SECTION("check deeply nested arrays") {
+        constexpr std::size_t depth = 100000;
+        binary data;
+        for (std::size_t i = 0; i < depth; ++i) {
+            data += binary("91");
+        }
+        data += binary("C0");
+
+        CHECK(msgpack_object_size(data.data(), data.size()) == data.size());
+    }
+
+    SECTION("check incomplete data") {
+        const auto data = GENERATE(binary(""), binary("CC"), binary("CD12"),
+            binary("A36162"), binary("D9"), binary("DA0003"), binary("930102"),
+            binary("8201C002"), binary("D70101"), binary("C70201AA"),
+            binary("DF000000"));
+        INFO("data: " << data);
+
+        CHECK_THROWS(msgpack_object_size(data.data(), data.size()));
+    }
+
+    SECTION("check invalid data") {
+        const auto data = binary("C1");
+
+        CHECK_THROWS(msgpack_object_size(data.data(), data.size()));
+    }
+}
@@ -19,14 +19,56 @@
  */
 #include "msgpack_light/details/object_data.h"
 
+#include <string>
 #include <type_traits>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "msgpack_light/object_data_type.h"
+
 TEST_CASE("msgpack_light::details::object_data") {
     using msgpack_light::details::object_data;
 
     SECTION("check of type") {
         STATIC_REQUIRE(std::is_trivially_copyable_v<object_data>);
+        STATIC_REQUIRE(sizeof(object_data) == 16U);
+        STATIC_REQUIRE(
+            sizeof(msgpack_light::details::key_value_pair_data) == 32U);
+        STATIC_REQUIRE(msgpack_light::details::inline_bytes_capacity == 12U);
+    }
+
+    SECTION("create data of a string stored inline") {
+        using msgpack_light::details::get_string_of;
+        using msgpack_light::details::inline_bytes_capacity;
+        using msgpack_light::details::is_inline_bytes;
+        using msgpack_light::details::make_inline_bytes;
+
+        const std::string value(inline_bytes_capacity, 'a');
+        const object_data data =
+            make_inline_bytes(msgpack_light::object_data_type::string,
+                value.data(), value.size());
+
+        CHECK(data.type == msgpack_light::object_data_type::string);
+        CHECK(is_inline_bytes(data));
+        CHECK(get_string_of(data) == value);
+    }
+
+    SECTION("fill data with nil objects") {
+        using msgpack_light::details::fill_with_nil;
+        using msgpack_light::details::key_value_pair_data;
+
+        key_value_pair_data pairs[2];  // NOLINT
+        pairs[1].value.type = msgpack_light::object_data_type::string;
+        pairs[1].value.size = 3U;
+        pairs[1].value.flags = 1U;
+
+        fill_with_nil(pairs, 2U);
+
+        for (const auto& pair : pairs) {
+            CHECK(pair.key.type == msgpack_light::object_data_type::nil);
+            CHECK(pair.value.type == msgpack_light::object_data_type::nil);
+            CHECK(pair.value.size == 0U);
+            CHECK(pair.value.flags == 0U);
+        }
     }
 }
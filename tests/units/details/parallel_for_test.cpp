@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of parallel_for function.
+ */
+#include "msgpack_light/details/parallel_for.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/details/thread_pool.h"
+
+TEST_CASE("msgpack_light::details::parallel_for") {
+    using msgpack_light::details::parallel_for;
+
+    SECTION("execute tasks") {
+        const std::size_t num_tasks = GENERATE(0U, 1U, 3U, 100U);
+        const std::size_t num_threads = GENERATE(1U, 2U, 8U);
+        INFO("num_tasks: " << num_tasks);
+        INFO("num_threads: " << num_threads);
+
+        std::vector<std::atomic<int>> counts(num_tasks);
+        parallel_for(num_tasks, num_threads,
+            [&counts](std::size_t task) { counts[task].fetch_add(1); });
+
+        for (std::size_t i = 0; i < num_tasks; ++i) {
+            INFO("task: " << i);
+            CHECK(counts[i].load() == 1);
+        }
+    }
+
+    SECTION("reuse threads") {
+        constexpr std::size_t num_threads = 4U;
+        parallel_for(num_threads, num_threads, [](std::size_t /*task*/) {});
+        const std::size_t pool_size =
+            msgpack_light::details::thread_pool::instance().num_threads();
+        CHECK(pool_size >= num_threads - 1U);
+
+        parallel_for(num_threads, num_threads, [](std::size_t /*task*/) {});
+        CHECK(msgpack_light::details::thread_pool::instance().num_threads() ==
+            pool_size);
+    }
+
+    SECTION("execute nested tasks") {
+        constexpr std::size_t num_tasks = 8U;
+        std::vector<std::atomic<int>> counts(num_tasks * num_tasks);
+        parallel_for(num_tasks, num_tasks, [&counts](std::size_t outer) {
+            parallel_for(num_tasks, num_tasks, [&](std::size_t inner) {
+                counts[outer * num_tasks + inner].fetch_add(1);
+            });
+        });
+
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            INFO("task: " << i);
+            CHECK(counts[i].load() == 1);
+        }
+    }
+
+    SECTION("re-throw an exception") {
+        CHECK_THROWS_AS(parallel_for(10U, 4U,  // NOLINT
+                            [](std::size_t task) {
+                                if (task == 5U) {  // NOLINT
+                                    throw std::runtime_error("test");
+                                }
+                            }),
+            std::runtime_error);
+    }
+}
+
+TEST_CASE("msgpack_light::details::resolve_num_threads") {
+    using msgpack_light::details::resolve_num_threads;
+
+    CHECK(resolve_num_threads(3U) == 3U);
+    CHECK(resolve_num_threads(0U) >= 1U);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of thread_pool class.
+ */
+#include "msgpack_light/details/thread_pool.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("msgpack_light::details::thread_pool") {
+    using msgpack_light::details::thread_pool;
+
+    SECTION("create threads") {
+        thread_pool pool;
+        CHECK(pool.num_threads() == 0U);
+
+        pool.reserve(2U);
+        CHECK(pool.num_threads() == 2U);
+
+        pool.reserve(1U);
+        CHECK(pool.num_threads() == 2U);
+    }
+
+    SECTION("execute jobs") {
+        constexpr std::size_t num_jobs = 10U;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::size_t num_finished_jobs = 0U;
+
+        // Pool is destroyed before the variables used in jobs.
+        thread_pool pool;
+        pool.reserve(2U);
+        for (std::size_t i = 0; i < num_jobs; ++i) {
+            pool.post([&] {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ++num_finished_jobs;
+                }
+                condition.notify_all();
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return num_finished_jobs == num_jobs; });
+        CHECK(num_finished_jobs == num_jobs);
+    }
+
+    SECTION("get the shared pool") {
+        CHECK(&thread_pool::instance() == &thread_pool::instance());
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of direct_file_output_stream class.
+ */
+#include "msgpack_light/direct_file_output_stream.h"
+
+#include <sys/stat.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+#include "read_file.h"
+
+TEST_CASE("msgpack_light::direct_file_output_stream") {
+    using msgpack_light_test::read_file;
+    using msgpack_light::binary;
+    using msgpack_light::direct_file_output_stream;
+    using msgpack_light::direct_io_alignment;
+
+    const char* file_path = "direct_file_output_stream_test.bin";
+
+    SECTION("write data") {
+        const std::size_t buffer_size = GENERATE(
+            static_cast<std::size_t>(4096), static_cast<std::size_t>(16384));
+        const int num_values = GENERATE(0, 10, 1000);
+        INFO("buffer_size: " << buffer_size);
+        INFO("num_values: " << num_values);
+
+        binary expected_data;
+        {
+            direct_file_output_stream stream(file_path, buffer_size);
+
+            for (int i = 0; i < num_values; ++i) {
+                const auto data = msgpack_light::serialize(
+                    std::vector<int>(static_cast<std::size_t>(i % 100), i));
+                stream.write(data.data(), data.size());
+                expected_data += data;
+            }
+        }
+
+        CHECK(read_file(file_path) == expected_data);
+    }
+
+    SECTION("flush data") {
+        direct_file_output_stream stream(std::string{file_path});
+
+        msgpack_light::serialize_to(stream, std::string("abc"));
+        stream.flush();
+
+        CHECK(read_file(file_path) == binary("A3616263"));
+
+        const auto large_data = binary(std::vector<unsigned char>(
+            direct_io_alignment * 3U, static_cast<unsigned char>(1)));
+        stream.write(large_data.data(), large_data.size());
+        stream.flush();
+
+        CHECK(read_file(file_path) == binary("A3616263") + large_data);
+    }
+
+    SECTION("preallocate the file") {
+        constexpr std::size_t preallocation_size = 1024U * 1024U;
+        {
+            direct_file_output_stream stream(file_path,
+                msgpack_light::default_direct_file_buffer_size,
+                preallocation_size);
+            msgpack_light::serialize_to(stream, 1);
+        }
+
+        struct stat status {};
+        REQUIRE(::stat(file_path, &status) == 0);
+        CHECK(status.st_size == 1);
+    }
+
+    SECTION("use invalid sizes") {
+        CHECK_THROWS_AS(direct_file_output_stream(file_path, 0U),
+            std::invalid_argument);
+        CHECK_THROWS_AS(direct_file_output_stream(file_path, 1000U),
+            std::invalid_argument);
+    }
+
+    SECTION("open an invalid path") {
+        CHECK_THROWS_AS(direct_file_output_stream("/invalid/file/path"),
+            std::runtime_error);
+    }
+}
@@ -0,0 +1,361 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of fd_output_stream class.
+ */
+#include "msgpack_light/fd_output_stream.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+
+namespace {
+
+/*!
+ * \brief Read data from a file descriptor until the end of the data.
+ *
+ * \param[in] file_descriptor File descriptor.
+ * \return Data.
+ */
+msgpack_light::binary read_all(int file_descriptor) {
+    msgpack_light::binary data;
+    unsigned char buffer[4096];  // NOLINT
+    while (true) {
+        const ::ssize_t size = ::read(file_descriptor, buffer, sizeof(buffer));
+        if (size <= 0) {
+            break;
+        }
+        data.append(buffer, static_cast<std::size_t>(size));
+    }
+    return data;
+}
+
+/*!
+ * \brief Create data for tests.
+ *
+ * \param[in] size Size of the data.
+ * \return Data.
+ */
+msgpack_light::binary create_data(std::size_t size) {
+    std::vector<unsigned char> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<unsigned char>(i * 7U);  // NOLINT
+    }
+    return msgpack_light::binary(data);
+}
+
+/*!
+ * \brief Set whether a file descriptor is non-blocking.
+ *
+ * \param[in] file_descriptor File descriptor.
+ * \param[in] non_blocking Whether the file descriptor is non-blocking.
+ */
+void set_non_blocking(int file_descriptor, bool non_blocking) {
+    int flags = ::fcntl(file_descriptor, F_GETFL);
+    REQUIRE(flags >= 0);
+    if (non_blocking) {
+        flags |= O_NONBLOCK;
+    } else {
+        flags &= ~O_NONBLOCK;
+    }
+    REQUIRE(::fcntl(file_descriptor, F_SETFL, flags) == 0);
+}
+
+}  // namespace
+
+TEST_CASE("msgpack_light::fd_output_stream") {
+    using msgpack_light::binary;
+    using msgpack_light::fd_output_stream;
+    using msgpack_light::fd_output_stream_options;
+    using msgpack_light::would_block_policy;
+
+    int sockets[2]{};  // NOLINT
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+    const int writer = sockets[0];
+    const int reader = sockets[1];
+
+    SECTION("write small data") {
+        binary expected_data;
+        {
+            fd_output_stream stream(writer);
+
+            for (int i = 0; i < 100; ++i) {  // NOLINT
+                const auto data = msgpack_light::serialize(
+                    std::vector<int>(static_cast<std::size_t>(i), i));
+                stream.write(data.data(), data.size());
+                expected_data += data;
+            }
+            CHECK(stream.buffered_size() == expected_data.size());
+
+            stream.flush();
+            CHECK(stream.buffered_size() == 0U);
+        }
+        (void)::close(writer);
+
+        CHECK(read_all(reader) == expected_data);
+    }
+
+    SECTION("write large data with small data") {
+        fd_output_stream_options options;
+        options.buffer_size = 1024U;            // NOLINT
+        options.direct_write_threshold = 256U;  // NOLINT
+        const binary small_data = create_data(100U);
+        const binary large_data = create_data(1000000U);
+        binary expected_data;
+
+        binary received_data;
+        std::thread reader_thread(
+            [reader, &received_data] { received_data = read_all(reader); });
+        {
+            fd_output_stream stream(writer, options);
+            for (int i = 0; i < 10; ++i) {  // NOLINT
+                stream.write(small_data.data(), small_data.size());
+                expected_data += small_data;
+                stream.write(large_data.data(), large_data.size());
+                expected_data += large_data;
+                CHECK(stream.buffered_size() == 0U);
+            }
+            stream.write(small_data.data(), small_data.size());
+            expected_data += small_data;
+        }
+        (void)::close(writer);
+        reader_thread.join();
+
+        CHECK(received_data == expected_data);
+    }
+
+    SECTION("fail when writing would block") {
+        fd_output_stream_options options;
+        options.buffer_size = 1024U;            // NOLINT
+        options.direct_write_threshold = 256U;  // NOLINT
+        options.on_would_block = would_block_policy::fail;
+        const binary small_data = create_data(100U);
+        const binary large_data = create_data(10000000U);
+        binary expected_data;
+
+        set_non_blocking(writer, true);
+        fd_output_stream stream(writer, options);
+        stream.write(small_data.data(), small_data.size());
+        expected_data += small_data;
+        CHECK_THROWS_AS(stream.write(large_data.data(), large_data.size()),
+            std::runtime_error);
+        expected_data += large_data;
+        CHECK(stream.buffered_size() > 0U);
+        CHECK(stream.buffered_size() < expected_data.size());
+
+        binary received_data;
+        std::thread reader_thread(
+            [reader, &received_data] { received_data = read_all(reader); });
+        set_non_blocking(writer, false);
+        stream.flush();
+        CHECK(stream.buffered_size() == 0U);
+        (void)::close(writer);
+        reader_thread.join();
+
+        CHECK(received_data == expected_data);
+    }
+
+    SECTION("wait when writing would block") {
+        fd_output_stream_options options;
+        options.direct_write_threshold = 256U;  // NOLINT
+        options.on_would_block = would_block_policy::wait;
+        const binary large_data = create_data(10000000U);
+
+        set_non_blocking(writer, true);
+        binary received_data;
+        std::thread reader_thread(
+            [reader, &received_data] { received_data = read_all(reader); });
+        {
+            fd_output_stream stream(writer, options);
+            stream.write(large_data.data(), large_data.size());
+            CHECK(stream.buffered_size() == 0U);
+        }
+        (void)::close(writer);
+        reader_thread.join();
+
+        CHECK(received_data == large_data);
+    }
+
+    SECTION("time out when writing would block") {
+        fd_output_stream_options options;
+        options.direct_write_threshold = 256U;  // NOLINT
+        options.on_would_block = would_block_policy::wait;
+        options.wait_timeout_milliseconds = 10;  // NOLINT
+        const binary large_data = create_data(10000000U);
+
+        set_non_blocking(writer, true);
+        fd_output_stream stream(writer, options);
+        CHECK_THROWS_AS(stream.write(large_data.data(), large_data.size()),
+            std::runtime_error);
+        (void)::close(writer);
+    }
+
+    SECTION("write to a pipe") {
+        int pipe_files[2]{};  // NOLINT
+        REQUIRE(::pipe(pipe_files) == 0);
+        const binary data = msgpack_light::serialize(std::vector<int>{1, 2});
+        {
+            fd_output_stream stream(pipe_files[1]);
+            stream.write(data.data(), data.size());
+        }
+        (void)::close(pipe_files[1]);
+
+        CHECK(read_all(pipe_files[0]) == data);
+        (void)::close(pipe_files[0]);
+        (void)::close(writer);
+    }
+
+    SECTION("request MSG_ZEROCOPY to a Unix domain socket") {
+        fd_output_stream_options options;
+        options.use_zerocopy = true;
+        {
+            fd_output_stream stream(writer, options);
+            // MSG_ZEROCOPY isn't supported for Unix domain sockets.
+            CHECK_FALSE(stream.uses_zerocopy());
+        }
+        (void)::close(writer);
+    }
+
+    SECTION("invalid buffer size") {
+        fd_output_stream_options options;
+        options.buffer_size = 0U;
+        CHECK_THROWS_AS(
+            fd_output_stream(writer, options), std::invalid_argument);
+        (void)::close(writer);
+    }
+
+    (void)::close(reader);
+}
+
+TEST_CASE("msgpack_light::fd_output_stream with TCP") {
+    using msgpack_light::binary;
+    using msgpack_light::fd_output_stream;
+    using msgpack_light::fd_output_stream_options;
+
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(listener >= 0);
+    ::sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    ::socklen_t address_size = sizeof(address);
+    REQUIRE(::bind(listener, reinterpret_cast<::sockaddr*>(&address),  // NOLINT
+                address_size) == 0);
+    REQUIRE(::listen(listener, 1) == 0);
+    REQUIRE(::getsockname(listener,
+                reinterpret_cast<::sockaddr*>(&address),  // NOLINT
+                &address_size) == 0);
+
+    const int writer = ::socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(writer >= 0);
+    REQUIRE(::connect(writer, reinterpret_cast<::sockaddr*>(&address),  // NOLINT
+                address_size) == 0);
+    const int reader = ::accept(listener, nullptr, nullptr);
+    REQUIRE(reader >= 0);
+
+    SECTION("write data with MSG_ZEROCOPY") {
+        fd_output_stream_options options;
+        options.direct_write_threshold = 1024U;  // NOLINT
+        options.use_zerocopy = true;
+        options.zerocopy_threshold = 4096U;  // NOLINT
+        const binary small_data = create_data(100U);
+        const binary large_data = create_data(1000000U);
+        binary expected_data;
+
+        binary received_data;
+        std::thread reader_thread(
+            [reader, &received_data] { received_data = read_all(reader); });
+        {
+            fd_output_stream stream(writer, options);
+            INFO("uses_zerocopy: " << stream.uses_zerocopy());
+            for (int i = 0; i < 10; ++i) {  // NOLINT
+                stream.write(small_data.data(), small_data.size());
+                expected_data += small_data;
+                stream.write(large_data.data(), large_data.size());
+                expected_data += large_data;
+            }
+        }
+        (void)::shutdown(writer, SHUT_WR);
+        reader_thread.join();
+
+        CHECK(received_data == expected_data);
+    }
+
+    SECTION("fail when writing with MSG_ZEROCOPY would block") {
+        fd_output_stream_options options;
+        options.direct_write_threshold = 1024U;  // NOLINT
+        options.on_would_block = msgpack_light::would_block_policy::fail;
+        options.use_zerocopy = true;
+        options.zerocopy_threshold = 4096U;  // NOLINT
+        const binary large_data = create_data(100000000U);
+
+        set_non_blocking(writer, true);
+        fd_output_stream stream(writer, options);
+        INFO("uses_zerocopy: " << stream.uses_zerocopy());
+        binary received_data;
+        std::thread reader_thread([reader, &received_data] {
+            // Completions of sends are waited before the exception.
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            received_data = read_all(reader);
+        });
+        CHECK_THROWS_AS(stream.write(large_data.data(), large_data.size()),
+            std::runtime_error);
+        CHECK(stream.buffered_size() > 0U);
+        CHECK(stream.buffered_size() < large_data.size());
+
+        set_non_blocking(writer, false);
+        stream.flush();
+        (void)::shutdown(writer, SHUT_WR);
+        reader_thread.join();
+
+        CHECK(received_data == large_data);
+    }
+
+    SECTION("time out waiting for completions of MSG_ZEROCOPY") {
+        fd_output_stream_options options;
+        options.direct_write_threshold = 1024U;  // NOLINT
+        options.wait_timeout_milliseconds = 10;  // NOLINT
+        options.use_zerocopy = true;
+        options.zerocopy_threshold = 4096U;  // NOLINT
+        const binary data = create_data(100000U);
+
+        fd_output_stream stream(writer, options);
+        if (stream.uses_zerocopy()) {
+            // Completions are notified after the data is read.
+            CHECK_THROWS_AS(
+                stream.write(data.data(), data.size()), std::runtime_error);
+        }
+    }
+
+    (void)::close(writer);
+    (void)::close(reader);
+    (void)::close(listener);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of io_uring_file_output_stream class.
+ */
+#include "msgpack_light/io_uring_file_output_stream.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+#include "read_file.h"
+
+TEST_CASE("msgpack_light::io_uring_file_output_stream") {
+    using msgpack_light_test::read_file;
+    using msgpack_light::binary;
+    using msgpack_light::io_uring_file_output_stream;
+
+    const char* file_path = "io_uring_file_output_stream_test.bin";
+    const bool use_io_uring = GENERATE(true, false);
+    INFO("use_io_uring: " << use_io_uring);
+
+    SECTION("write data") {
+        const std::size_t buffer_size = GENERATE(static_cast<std::size_t>(1),
+            static_cast<std::size_t>(7), static_cast<std::size_t>(4096));
+        const std::size_t num_buffers = GENERATE(
+            static_cast<std::size_t>(1), static_cast<std::size_t>(4));
+        INFO("buffer_size: " << buffer_size);
+        INFO("num_buffers: " << num_buffers);
+
+        binary expected_data;
+        {
+            io_uring_file_output_stream stream(
+                file_path, buffer_size, num_buffers, use_io_uring);
+            if (!use_io_uring) {
+                CHECK_FALSE(stream.uses_io_uring());
+            }
+
+            for (int i = 0; i < 100; ++i) {  // NOLINT
+                const auto data = msgpack_light::serialize(
+                    std::vector<int>(static_cast<std::size_t>(i), i));
+                stream.write(data.data(), data.size());
+                expected_data += data;
+            }
+        }
+
+        CHECK(read_file(file_path) == expected_data);
+    }
+
+    SECTION("flush data") {
+        io_uring_file_output_stream stream(std::string{file_path},
+            msgpack_light::default_io_uring_buffer_size,
+            msgpack_light::default_io_uring_num_buffers, use_io_uring);
+
+        msgpack_light::serialize_to(stream, std::string("abc"));
+        stream.flush();
+
+        CHECK(read_file(file_path) == binary("A3616263"));
+
+        msgpack_light::serialize_to(stream, 1);
+        stream.flush();
+
+        CHECK(read_file(file_path) == binary("A361626301"));
+    }
+
+    SECTION("use invalid sizes") {
+        CHECK_THROWS_AS(io_uring_file_output_stream(file_path, 0U),
+            std::invalid_argument);
+        CHECK_THROWS_AS(io_uring_file_output_stream(file_path, 1U, 0U),
+            std::invalid_argument);
+    }
+
+    SECTION("open an invalid path") {
+        CHECK_THROWS_AS(io_uring_file_output_stream("/invalid/file/path"),
+            std::runtime_error);
+    }
+}
@@ -23,7 +23,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "msgpack_light/allocator_reference.h"
 #include "msgpack_light/binary.h"
+#include "msgpack_light/monotonic_allocator.h"
 
 TEST_CASE("msgpack_light::memory_output_stream") {
     using msgpack_light::binary;
@@ -85,4 +87,61 @@ TEST_CASE("msgpack_light::memory_output_stream") {
             CHECK(stream.as_binary() == written_data2);
         }
     }
+
+    SECTION("release data") {
+        memory_output_stream stream;
+        const auto written_data = binary("010203");
+        stream.write(written_data.data(), written_data.size());
+        const unsigned char* buffer = stream.data();
+
+        const binary released_data = stream.release();
+
+        CHECK(released_data == written_data);
+        CHECK(released_data.data() == buffer);
+        CHECK(stream.as_binary() == binary());
+        CHECK(stream.capacity() < 4096U);
+
+        SECTION("write the next data") {
+            const auto written_data2 = binary("0405");
+            stream.write(written_data2.data(), written_data2.size());
+
+            CHECK(stream.as_binary() == written_data2);
+            CHECK(released_data == written_data);
+        }
+
+        SECTION("write large data") {
+            const auto written_data2 =
+                binary(std::vector<unsigned char>(100U, 1U));  // NOLINT
+            stream.write(written_data2.data(), written_data2.size());
+
+            CHECK(stream.as_binary() == written_data2);
+            CHECK(stream.capacity() >= 4096U);
+            CHECK(released_data == written_data);
+        }
+    }
+}
+
+TEST_CASE("msgpack_light::basic_memory_output_stream") {
+    using msgpack_light::allocator_reference;
+    using msgpack_light::basic_memory_output_stream;
+    using msgpack_light::binary;
+    using msgpack_light::monotonic_allocator;
+
+    SECTION("write data using an allocator") {
+        monotonic_allocator arena;
+        basic_memory_output_stream<allocator_reference<monotonic_allocator>>
+            stream{allocator_reference<monotonic_allocator>(arena)};
+
+        const auto written_data = binary(
+            std::vector<unsigned char>(10000, static_cast<unsigned char>(1)));
+        stream.write(written_data.data(), written_data.size());
+
+        CHECK(stream.as_binary() == written_data);
+        CHECK(&stream.as_binary().get_allocator().get() == &arena);
+
+        const auto released_data = stream.release();
+        CHECK(released_data == written_data);
+        CHECK(&released_data.get_allocator().get() == &arena);
+        CHECK(stream.size() == 0U);
+    }
 }
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of mmap_output_stream class.
+ */
+#include "msgpack_light/mmap_output_stream.h"
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+#include "read_file.h"
+
+TEST_CASE("msgpack_light::mmap_output_stream") {
+    using msgpack_light_test::read_file;
+    using msgpack_light::binary;
+    using msgpack_light::mmap_output_stream;
+
+    const char* file_path = "mmap_output_stream_test.bin";
+
+    SECTION("write data") {
+        binary expected_data;
+        {
+            mmap_output_stream stream(file_path, 16U);  // NOLINT
+            CHECK(stream.capacity() == 16U);
+
+            for (int i = 0; i < 100; ++i) {  // NOLINT
+                const auto data = msgpack_light::serialize(
+                    std::vector<int>(static_cast<std::size_t>(i), i));
+                stream.write(data.data(), data.size());
+                expected_data += data;
+            }
+            CHECK(stream.size() == expected_data.size());
+            CHECK(stream.capacity() >= expected_data.size());
+            CHECK(binary(stream.data(), stream.size()) == expected_data);
+
+            // Data can be read before closing.
+            const binary file_data = read_file(file_path);
+            REQUIRE(file_data.size() == stream.capacity());
+            CHECK(binary(file_data.data(), expected_data.size()) ==
+                expected_data);
+        }
+
+        CHECK(read_file(file_path) == expected_data);
+    }
+
+    SECTION("write data in place") {
+        {
+            mmap_output_stream stream(std::string{file_path}, 4U);
+
+            unsigned char* ptr = stream.reserve(10U);  // NOLINT
+            std::memcpy(ptr, "abc", 3U);
+            stream.commit(3U);
+            CHECK(stream.capacity() >= 10U);
+
+            msgpack_light::serialize_to(stream, 1);
+            stream.flush();
+
+            CHECK_THROWS_AS(stream.commit(stream.capacity()),
+                std::out_of_range);
+        }
+
+        CHECK(read_file(file_path) == binary("61626301"));
+    }
+
+    SECTION("use invalid capacity") {
+        CHECK_THROWS_AS(mmap_output_stream(file_path, 0U),
+            std::invalid_argument);
+    }
+
+    SECTION("open an invalid path") {
+        CHECK_THROWS_AS(mmap_output_stream("/invalid/file/path"),
+            std::runtime_error);
+    }
+}
@@ -19,11 +19,14 @@
  */
 #include "msgpack_light/object.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -244,10 +247,14 @@ TEMPLATE_TEST_CASE("msgpack_light::object", "",
     }
 
     SECTION("create an object of a string") {
+        using msgpack_light::details::inline_bytes_capacity;
         object_type obj;
 
         const auto value = GENERATE(std::string(), std::string("a"),
-            std::string("ab"), std::string("abc"));
+            std::string("ab"), std::string("abc"),
+            std::string(inline_bytes_capacity, 'a'),
+            std::string(inline_bytes_capacity + 1U, 'b'),
+            std::string(100U, 'c'));  // NOLINT
         obj.set_string(value);
 
         CHECK(obj.type() == object_data_type::string);
@@ -275,13 +282,25 @@ TEMPLATE_TEST_CASE("msgpack_light::object", "",
             CHECK(moved.type() == object_data_type::string);
             CHECK(moved.as_string() == value);
         }
+
+        SECTION("set a part of the string") {
+            const std::string_view part =
+                obj.as_string().substr(value.empty() ? 0U : 1U);
+            obj.set_string(part);
+
+            CHECK(obj.as_string() ==
+                std::string_view(value).substr(value.empty() ? 0U : 1U));
+        }
     }
 
     SECTION("create an object of a binary") {
         object_type obj;
 
-        const auto value =
-            GENERATE(binary(), binary("A1"), binary("A1B2"), binary("A1B2C3"));
+        const auto value = GENERATE(binary(), binary("A1"), binary("A1B2"),
+            binary("A1B2C3"),
+            binary("000102030405060708090A0B"),
+            binary("000102030405060708090A0B0C"),
+            binary("000102030405060708090A0B0C0D0E0F1011121314151617"));
         obj.set_binary(value);
 
         CHECK(obj.type() == object_data_type::binary);
@@ -424,6 +443,61 @@ TEMPLATE_TEST_CASE("msgpack_light::object", "",
         }
     }
 
+    SECTION("grow an array") {
+        object_type obj;
+        auto array_ref = obj.set_array();
+        CHECK(array_ref.capacity() == 0U);
+
+        SECTION("using emplace_back") {
+            constexpr std::size_t size = 100;
+            for (std::size_t i = 0; i < size; ++i) {
+                array_ref.emplace_back().set_unsigned_integer(i);
+                CHECK(array_ref.capacity() >= array_ref.size());
+            }
+            REQUIRE(array_ref.size() == size);
+            CHECK(array_ref.capacity() < size * 2U);
+            for (std::size_t i = 0; i < size; ++i) {
+                CHECK(array_ref[i].as_unsigned_integer() == i);
+            }
+        }
+
+        SECTION("using push_back") {
+            object_type value;
+            value.set_string("abc");
+            array_ref.push_back(value);
+            array_ref.push_back(value);
+            for (int i = 0; i < 10; ++i) {
+                array_ref.push_back(array_ref[0]);
+            }
+            value.set_string("def");
+            REQUIRE(array_ref.size() == 12U);
+            for (std::size_t i = 0; i < array_ref.size(); ++i) {
+                CHECK(array_ref[i].as_string() == "abc");
+            }
+        }
+
+        SECTION("using reserve") {
+            array_ref.reserve(10U);
+            CHECK(array_ref.capacity() == 10U);
+            CHECK(array_ref.size() == 0U);
+            array_ref.resize(5U);
+            CHECK(array_ref.capacity() == 10U);
+            CHECK(array_ref[4].type() == object_data_type::nil);
+            array_ref.reserve(3U);
+            CHECK(array_ref.capacity() == 10U);
+        }
+
+        SECTION("using resize") {
+            array_ref.resize(3U);
+            array_ref[2].set_string("abc");
+            array_ref.resize(1U);
+            CHECK(array_ref.size() == 1U);
+            array_ref.resize(20U);
+            CHECK(array_ref.size() == 20U);
+            CHECK(array_ref[2].type() == object_data_type::nil);
+        }
+    }
+
     SECTION("create an object of a map") {
         object_type obj;
 
@@ -542,6 +616,238 @@ TEMPLATE_TEST_CASE("msgpack_light::object", "",
         }
     }
 
+    SECTION("find keys in a map") {
+        const std::size_t size = GENERATE(
+            static_cast<std::size_t>(3), static_cast<std::size_t>(200));
+        INFO("size = " << size);
+        object_type obj;
+
+        {
+            auto map_ref = obj.set_map(size * 2U);
+            for (std::size_t i = 0; i < size; ++i) {
+                map_ref.key(i).set_string("key" + std::to_string(i));
+                map_ref.value(i).set_unsigned_integer(i);
+                if (i % 2U == 0U) {
+                    map_ref.key(size + i).set_signed_integer(
+                        -static_cast<std::int64_t>(i));
+                } else {
+                    map_ref.key(size + i).set_unsigned_integer(i);
+                }
+                map_ref.value(size + i).set_unsigned_integer(size + i);
+            }
+        }
+
+        SECTION("using mutable_map_ref") {
+            auto map_ref = obj.as_map();
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto iter = map_ref.find("key" + std::to_string(i));
+                REQUIRE(iter != map_ref.end());
+                CHECK((*iter).second.as_unsigned_integer() == i);
+            }
+            CHECK(map_ref.find("key") == map_ref.end());
+            CHECK(map_ref.find(std::string_view("key0", 3)) == map_ref.end());
+
+            const auto iter_one = map_ref.find(1);
+            REQUIRE(iter_one != map_ref.end());
+            CHECK((*iter_one).second.as_unsigned_integer() == size + 1U);
+            const auto iter_minus_two = map_ref.find(-2);
+            REQUIRE(iter_minus_two != map_ref.end());
+            CHECK((*iter_minus_two).second.as_unsigned_integer() == size + 2U);
+            const auto iter_zero = map_ref.find(std::uint64_t{0});
+            REQUIRE(iter_zero != map_ref.end());
+            CHECK((*iter_zero).second.as_unsigned_integer() == size);
+            CHECK(map_ref.find(-1) == map_ref.end());
+            CHECK(map_ref.find(size * 2U) == map_ref.end());
+        }
+
+        SECTION("using const_map_ref") {
+            (void)obj.as_map().find("key0");  // Build the index.
+            const auto& const_obj = obj;
+            const auto map_ref = const_obj.as_map();
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto iter = map_ref.find("key" + std::to_string(i));
+                REQUIRE(iter != map_ref.end());
+                CHECK((*iter).second.as_unsigned_integer() == i);
+            }
+            CHECK(map_ref.find("key") == map_ref.end());
+            const auto iter_minus_two = map_ref.find(-2);
+            REQUIRE(iter_minus_two != map_ref.end());
+            CHECK((*iter_minus_two).second.as_unsigned_integer() == size + 2U);
+            CHECK(map_ref.find(-1) == map_ref.end());
+        }
+
+        SECTION("using const_map_ref after build_index") {
+            obj.build_index();
+            const auto& const_obj = obj;
+            const auto map_ref = const_obj.as_map();
+            CHECK(map_ref.is_indexed() ==
+                (size * 2U >= msgpack_light::details::map_index_min_size));
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto iter = map_ref.find("key" + std::to_string(i));
+                REQUIRE(iter != map_ref.end());
+                CHECK((*iter).second.as_unsigned_integer() == i);
+            }
+            CHECK(map_ref.find("key") == map_ref.end());
+
+            (void)obj.as_map().key(0);
+            CHECK_FALSE(map_ref.is_indexed());
+        }
+
+        SECTION("build indices of nested maps") {
+            object_type parent;
+            {
+                auto child_map_ref = parent.set_array(1U)[0].set_map(size);
+                for (std::size_t i = 0; i < size; ++i) {
+                    child_map_ref.key(i).set_string("key" + std::to_string(i));
+                    child_map_ref.value(i).set_unsigned_integer(i);
+                }
+            }
+            parent.build_index();
+
+            const auto& const_parent = parent;
+            const auto map_ref = const_parent.as_array()[0].as_map();
+            CHECK(map_ref.is_indexed() ==
+                (size >= msgpack_light::details::map_index_min_size));
+            const auto iter = map_ref.find("key1");
+            REQUIRE(iter != map_ref.end());
+            CHECK((*iter).second.as_unsigned_integer() == 1U);
+        }
+
+        SECTION("modify keys after search") {
+            auto map_ref = obj.as_map();
+            REQUIRE(map_ref.find("key1") != map_ref.end());
+            map_ref.key(1).set_string("renamed");
+            CHECK(map_ref.find("key1") == map_ref.end());
+            const auto iter = map_ref.find("renamed");
+            REQUIRE(iter != map_ref.end());
+            CHECK((*iter).second.as_unsigned_integer() == 1U);
+        }
+
+        SECTION("modify keys through iterators after search") {
+            auto map_ref = obj.as_map();
+            STATIC_REQUIRE(std::is_same_v<
+                decltype((*map_ref.find("key1")).first),
+                msgpack_light::const_object_ref>);
+            STATIC_REQUIRE(std::is_same_v<
+                decltype((*map_ref.insert("key1").first).first),
+                msgpack_light::const_object_ref>);
+
+            const auto found = map_ref.find("key1");
+            REQUIRE(found != map_ref.end());
+            (*found).second.set_string("value");
+            CHECK(map_ref.find("key1") == found);
+
+            const auto [inserted, is_inserted] = map_ref.insert("new");
+            CHECK(is_inserted);
+            (*inserted).second.set_boolean(true);
+            CHECK(map_ref.find("new") == inserted);
+
+            for (auto [key, value] : map_ref) {
+                if (key.type() == object_data_type::string &&
+                    key.as_string() == "key1") {
+                    key.set_string("renamed");
+                }
+            }
+            CHECK(map_ref.find("key1") == map_ref.end());
+            const auto renamed = map_ref.find("renamed");
+            REQUIRE(renamed != map_ref.end());
+            CHECK((*renamed).second.as_string() == "value");
+        }
+
+        SECTION("copy") {
+            (void)obj.as_map().find("key0");  // Build the index.
+            object_type copy{obj};
+            auto map_ref = copy.as_map();
+            const auto iter = map_ref.find("key1");
+            REQUIRE(iter != map_ref.end());
+            CHECK((*iter).second.as_unsigned_integer() == 1U);
+        }
+    }
+
+    SECTION("grow a map") {
+        object_type obj;
+        auto map_ref = obj.set_map();
+        CHECK(map_ref.capacity() == 0U);
+
+        SECTION("using insert") {
+            constexpr std::size_t size = 100;
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto [iter, inserted] =
+                    map_ref.insert("key" + std::to_string(i));
+                CHECK(inserted);
+                (*iter).second.set_unsigned_integer(i);
+                const auto [int_iter, int_inserted] =
+                    map_ref.insert(static_cast<std::int64_t>(i));
+                CHECK(int_inserted);
+                (*int_iter).second.set_unsigned_integer(size + i);
+            }
+            REQUIRE(map_ref.size() == size * 2U);
+            CHECK(map_ref.capacity() < size * 4U);
+
+            const auto [iter, inserted] = map_ref.insert("key3");
+            CHECK_FALSE(inserted);
+            CHECK((*iter).second.as_unsigned_integer() == 3U);
+            CHECK_FALSE(map_ref.insert(std::uint64_t{5}).second);
+            CHECK(map_ref.size() == size * 2U);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto found = map_ref.find("key" + std::to_string(i));
+                REQUIRE(found != map_ref.end());
+                CHECK((*found).second.as_unsigned_integer() == i);
+                const auto found_int = map_ref.find(i);
+                REQUIRE(found_int != map_ref.end());
+                CHECK((*found_int).second.as_unsigned_integer() == size + i);
+            }
+        }
+
+        SECTION("using emplace_back") {
+            for (int i = 0; i < 20; ++i) {
+                auto iter = map_ref.emplace_back();
+                (*iter).first.set_signed_integer(i);
+                (*iter).second.set_boolean(true);
+            }
+            REQUIRE(map_ref.size() == 20U);
+            CHECK(map_ref.find(19) != map_ref.end());
+            CHECK(map_ref.find(20) == map_ref.end());
+        }
+
+        SECTION("using erase") {
+            for (int i = 0; i < 20; ++i) {
+                (*map_ref.insert(i).first).second.set_signed_integer(i);
+            }
+            (*map_ref.emplace_back()).first.set_signed_integer(3);
+            REQUIRE(map_ref.find(7) != map_ref.end());
+
+            CHECK(map_ref.erase(3) == 2U);
+            CHECK(map_ref.erase(3) == 0U);
+            CHECK(map_ref.size() == 19U);
+            const auto next = map_ref.erase(map_ref.find(7));
+            CHECK((*next).first.as_signed_integer() == 8);
+            CHECK(map_ref.size() == 18U);
+
+            CHECK(map_ref.find(3) == map_ref.end());
+            CHECK(map_ref.find(7) == map_ref.end());
+            std::vector<std::int64_t> keys;
+            for (const auto& [key, value] : map_ref) {
+                CHECK(key.as_signed_integer() == value.as_signed_integer());
+                keys.push_back(key.as_signed_integer());
+            }
+            CHECK(keys ==
+                std::vector<std::int64_t>{0, 1, 2, 4, 5, 6, 8, 9, 10, 11, 12,
+                    13, 14, 15, 16, 17, 18, 19});
+        }
+
+        SECTION("using reserve") {
+            map_ref.reserve(50U);
+            CHECK(map_ref.capacity() == 50U);
+            for (int i = 0; i < 50; ++i) {
+                (void)map_ref.insert(i);
+            }
+            CHECK(map_ref.capacity() == 50U);
+            CHECK(map_ref.find(49) != map_ref.end());
+        }
+    }
+
     SECTION("create an object of an extension value") {
         object_type obj;
 
@@ -580,6 +886,22 @@ TEMPLATE_TEST_CASE("msgpack_light::object", "",
         }
     }
 
+    SECTION("reject too large sizes") {
+        if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+            constexpr std::size_t too_large_size = static_cast<std::size_t>(
+                std::numeric_limits<std::uint32_t>::max()) + 1U;
+            object_type obj;
+            CHECK_THROWS_AS(obj.set_array(too_large_size), std::runtime_error);
+            CHECK_THROWS_AS(obj.set_map(too_large_size), std::runtime_error);
+            CHECK_THROWS_AS(
+                obj.set_array().reserve(too_large_size), std::runtime_error);
+            CHECK_THROWS_AS(
+                obj.set_array().resize(too_large_size), std::runtime_error);
+            CHECK_THROWS_AS(
+                obj.set_map().reserve(too_large_size), std::runtime_error);
+        }
+    }
+
     SECTION("copy constructor") {
         object_type obj;
         {
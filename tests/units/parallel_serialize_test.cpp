@@ -0,0 +1,121 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of parallel_serialize function.
+ */
+#include "msgpack_light/parallel_serialize.h"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
+
+TEST_CASE("msgpack_light::parallel_serialize") {
+    using msgpack_light::binary;
+    using msgpack_light::parallel_serialization_options;
+
+    SECTION("serialize small data") {
+        const auto data = std::vector<int>{1, 2, 3};
+
+        CHECK(msgpack_light::parallel_serialize(data) == binary("93010203"));
+    }
+
+    SECTION("serialize empty data") {
+        const auto data = std::vector<std::string>();
+
+        CHECK(msgpack_light::parallel_serialize(data) == binary("90"));
+    }
+
+    SECTION("serialize std::array") {
+        const auto data = std::array<int, 2>{1, 2};
+
+        CHECK(msgpack_light::parallel_serialize(data) == binary("920102"));
+    }
+
+    SECTION("serialize std::array of unsigned char") {
+        const auto data = std::array<unsigned char, 3>{1, 2, 3};
+
+        CHECK(msgpack_light::parallel_serialize(data) ==
+            msgpack_light::serialize(data));
+    }
+
+    SECTION("check types of containers") {
+        using msgpack_light::details::is_parallel_serializable_container_v;
+
+        STATIC_REQUIRE(
+            is_parallel_serializable_container_v<std::vector<int>>);
+        STATIC_REQUIRE(
+            is_parallel_serializable_container_v<std::array<int, 2>>);
+        STATIC_REQUIRE_FALSE(
+            is_parallel_serializable_container_v<std::vector<unsigned char>>);
+        STATIC_REQUIRE_FALSE(
+            is_parallel_serializable_container_v<std::string>);
+        STATIC_REQUIRE_FALSE(
+            is_parallel_serializable_container_v<std::string_view>);
+    }
+
+    SECTION("serialize large data in chunks") {
+        const std::size_t size = GENERATE(10U, 99U, 100000U);
+        const std::size_t num_threads = GENERATE(1U, 2U, 5U);
+        INFO("size: " << size);
+        INFO("num_threads: " << num_threads);
+        std::vector<std::string> data;
+        data.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            data.push_back(std::to_string(i));
+        }
+        parallel_serialization_options parallel_options;
+        parallel_options.num_threads = num_threads;
+        parallel_options.min_chunk_size = 3U;  // NOLINT
+        const auto expected = msgpack_light::serialize(data);
+
+        SECTION("to binary") {
+            CHECK(msgpack_light::parallel_serialize(data, parallel_options) ==
+                expected);
+        }
+
+        SECTION("to a stream") {
+            msgpack_light::memory_output_stream stream;
+            msgpack_light::parallel_serialize_to(
+                stream, data, parallel_options);
+            CHECK(stream.as_binary() == expected);
+        }
+    }
+
+    SECTION("serialize with options") {
+        const auto data = std::vector<double>(100U, 1.0);  // NOLINT
+        parallel_serialization_options parallel_options;
+        parallel_options.num_threads = 4U;     // NOLINT
+        parallel_options.min_chunk_size = 8U;  // NOLINT
+        msgpack_light::serialization_options options;
+        options.compact_floating_point = true;
+
+        CHECK(msgpack_light::parallel_serialize(
+                  data, parallel_options, options) ==
+            msgpack_light::serialize(data, options));
+    }
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of record_log_reader class.
+ */
+#include "msgpack_light/record_log_reader.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/record_log_writer.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+
+TEST_CASE("msgpack_light::record_log_reader") {
+    using msgpack_light::binary;
+    using msgpack_light::binary_view;
+    using msgpack_light::memory_output_stream;
+    using msgpack_light::record_log_reader;
+    using msgpack_light::record_log_writer;
+
+    const std::uint32_t index_interval = GENERATE(1U, 3U, 1024U);
+    INFO("index_interval: " << index_interval);
+    constexpr int num_records = 100;
+    memory_output_stream stream;
+    {
+        record_log_writer writer(stream, index_interval);
+        for (int i = 0; i < num_records; ++i) {
+            writer.write(std::vector<int>(static_cast<std::size_t>(i), i));
+        }
+    }
+
+    SECTION("read records") {
+        const record_log_reader reader(stream.as_binary());
+        CHECK(reader.num_records() == num_records);
+        CHECK(reader.index_interval() == index_interval);
+
+        for (int i = 0; i < num_records; ++i) {
+            INFO("i: " << i);
+            CHECK(binary(reader.record(static_cast<std::uint64_t>(i))) ==
+                msgpack_light::serialize(
+                    std::vector<int>(static_cast<std::size_t>(i), i)));
+        }
+        CHECK(binary(reader[3U]) == binary("93030303"));
+        CHECK_THROWS_AS((void)reader.record(num_records), std::out_of_range);
+    }
+
+    SECTION("scan records") {
+        const record_log_reader reader(stream.data(), stream.size());
+
+        std::vector<binary> records;
+        reader.for_each_record(
+            10U, 15U, [&records](binary_view record) {  // NOLINT
+                records.emplace_back(record);
+            });
+
+        REQUIRE(records.size() == 5U);
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            INFO("i: " << i);
+            CHECK(records[i] ==
+                msgpack_light::serialize(std::vector<int>(
+                    i + 10U, static_cast<int>(i + 10U))));  // NOLINT
+        }
+        CHECK_THROWS_AS(reader.for_each_record(
+                            0U, num_records + 1U, [](binary_view) {}),
+            std::out_of_range);
+    }
+
+    SECTION("read invalid logs") {
+        CHECK_THROWS_AS(
+            record_log_reader(stream.data(), stream.size() - 1U),
+            std::runtime_error);
+        CHECK_THROWS_AS(record_log_reader(stream.data() + 1U,
+                            stream.size() - 1U),
+            std::runtime_error);
+    }
+}
+
+TEST_CASE("msgpack_light::record_log_reader::recover") {
+    using msgpack_light::binary;
+    using msgpack_light::memory_output_stream;
+    using msgpack_light::record_log_reader;
+    using msgpack_light::record_log_writer;
+
+    const std::uint32_t index_interval = GENERATE(1U, 3U, 1024U);
+    INFO("index_interval: " << index_interval);
+    constexpr int num_records = 20;
+    memory_output_stream stream;
+    binary unfinished;
+    {
+        record_log_writer writer(stream);
+        for (int i = 0; i < num_records; ++i) {
+            writer.write(std::vector<int>(static_cast<std::size_t>(i), i));
+        }
+        unfinished = stream.as_binary();
+    }
+    const auto check_records = [](const record_log_reader& reader,
+                                   std::uint64_t expected_num_records) {
+        REQUIRE(reader.num_records() == expected_num_records);
+        for (std::uint64_t i = 0; i < expected_num_records; ++i) {
+            INFO("i: " << i);
+            CHECK(binary(reader.record(i)) ==
+                msgpack_light::serialize(std::vector<int>(
+                    static_cast<std::size_t>(i), static_cast<int>(i))));
+        }
+    };
+
+    SECTION("recover a finished log") {
+        const auto reader =
+            record_log_reader::recover(stream.as_binary(), index_interval);
+        CHECK_FALSE(reader.is_recovered());
+        CHECK(reader.index_interval() ==
+            msgpack_light::default_record_log_index_interval);
+        check_records(reader, num_records);
+    }
+
+    SECTION("recover a log without the index") {
+        CHECK_THROWS_AS(record_log_reader(unfinished), std::runtime_error);
+
+        const auto reader =
+            record_log_reader::recover(unfinished, index_interval);
+        CHECK(reader.is_recovered());
+        CHECK(reader.index_interval() == index_interval);
+        check_records(reader, num_records);
+    }
+
+    SECTION("recover a log cut in a record") {
+        const auto reader = record_log_reader::recover(
+            unfinished.data(), unfinished.size() - 1U, index_interval);
+        CHECK(reader.is_recovered());
+        check_records(reader, num_records - 1U);
+    }
+
+    SECTION("recover a log cut in the index") {
+        const auto reader = record_log_reader::recover(stream.data(),
+            unfinished.size() + msgpack_light::record_log_length_size + 3U,
+            index_interval);
+        CHECK(reader.is_recovered());
+        check_records(reader, num_records);
+    }
+
+    SECTION("recover an empty log") {
+        const auto reader =
+            record_log_reader::recover(unfinished.data(), 0U, index_interval);
+        CHECK(reader.num_records() == 0U);
+    }
+
+    SECTION("use an invalid interval") {
+        CHECK_THROWS_AS((void)record_log_reader::recover(unfinished, 0U),
+            std::invalid_argument);
+    }
+}
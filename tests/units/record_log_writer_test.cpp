@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of record_log_writer class.
+ */
+#include "msgpack_light/record_log_writer.h"
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/output_stream.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+
+namespace {
+
+/*!
+ * \brief Class of streams failing to write data.
+ */
+class failing_output_stream final : public msgpack_light::output_stream {
+public:
+    void write(const unsigned char* /*data*/, std::size_t /*size*/) override {
+        ++num_writes;
+        throw std::runtime_error("Failed to write data.");
+    }
+
+    //! Number of calls of write function.
+    std::size_t num_writes{0U};
+};
+
+}  // namespace
+
+TEST_CASE("msgpack_light::record_log_writer") {
+    using msgpack_light::binary;
+    using msgpack_light::memory_output_stream;
+    using msgpack_light::record_log_writer;
+
+    SECTION("write an empty log") {
+        memory_output_stream stream;
+        {
+            record_log_writer writer(stream);
+            CHECK(writer.num_records() == 0U);
+        }
+
+        CHECK(stream.as_binary() ==
+            binary("FFFFFFFF"
+                   "0000000000000000"
+                   "0000000000000004"
+                   "00000400"
+                   "4D50524C"));
+    }
+
+    SECTION("write records") {
+        memory_output_stream stream;
+        record_log_writer writer(stream, 2U);
+
+        const auto record = binary("0102");
+        writer.write_record(record.data(), record.size());
+        writer.write(1);
+        writer.write(2);
+        CHECK(writer.num_records() == 3U);
+        writer.finish();
+
+        CHECK(stream.as_binary() ==
+            binary("000000020102"
+                   "0000000101"
+                   "0000000102"
+                   "FFFFFFFF"
+                   "0000000000000000"
+                   "000000000000000B"
+                   "0000000000000003"
+                   "0000000000000014"
+                   "00000002"
+                   "4D50524C"));
+    }
+
+    SECTION("write a record after finish") {
+        memory_output_stream stream;
+        record_log_writer writer(stream);
+        writer.finish();
+
+        CHECK_THROWS_AS(writer.write(1), std::runtime_error);
+    }
+
+    SECTION("finish in the destructor with errors") {
+        failing_output_stream stream;
+        {
+            record_log_writer writer(stream);
+            CHECK_THROWS_AS(writer.write(1), std::runtime_error);
+        }
+        CHECK(stream.num_writes == 2U);
+    }
+
+    SECTION("use an invalid interval") {
+        memory_output_stream stream;
+        CHECK_THROWS_AS(record_log_writer(stream, 0U), std::invalid_argument);
+    }
+}
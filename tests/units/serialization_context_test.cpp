@@ -0,0 +1,141 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of serialization_context class.
+ */
+#include "msgpack_light/serialization_context.h"
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+
+TEST_CASE("msgpack_light::serialization_context") {
+    using msgpack_light::binary;
+    using msgpack_light::serialization_context;
+
+    SECTION("serialize data") {
+        serialization_context context;
+
+        const auto serialized = context.serialize(std::vector<int>{1, 2, 3});
+
+        CHECK(serialized == binary("93010203"));
+    }
+
+    SECTION("reuse the buffer") {
+        serialization_context context;
+        const unsigned char* buffer = context.serialize(1).data();
+
+        const auto serialized = context.serialize(std::string("abc"));
+
+        CHECK(serialized == binary("A3616263"));
+        CHECK(serialized.data() == buffer);
+    }
+
+    SECTION("serialize with options") {
+        serialization_context context;
+        msgpack_light::serialization_options options;
+        options.compact_floating_point = true;
+
+        const auto serialized = context.serialize(1.0, options);  // NOLINT
+
+        CHECK(serialized == binary("01"));
+    }
+
+    SECTION("shrink the buffer after large data") {
+        constexpr std::size_t max_retained_capacity = 8192U;
+        serialization_context context(max_retained_capacity);
+        CHECK(context.max_retained_capacity() == max_retained_capacity);
+
+        const auto large_serialized =
+            context.serialize(std::string(100000U, 'a'));  // NOLINT
+        CHECK(large_serialized.size() > 100000U);          // NOLINT
+        CHECK(context.capacity() > max_retained_capacity);
+
+        const auto serialized = context.serialize(1);
+
+        CHECK(serialized == binary("01"));
+        CHECK(context.capacity() <= max_retained_capacity);
+    }
+
+    SECTION("copy small data to binary") {
+        serialization_context context;
+        const auto view = context.serialize(std::vector<int>{1, 2});
+        const unsigned char* buffer = view.data();
+
+        const binary serialized =
+            context.serialize_to_binary(std::vector<int>{1, 2, 3});
+
+        CHECK(serialized == binary("93010203"));
+        CHECK(serialized.data() != buffer);
+        CHECK(serialized.capacity() < 4096U);
+
+        CHECK(context.serialize(2).data() == buffer);
+        CHECK(serialized == binary("93010203"));
+    }
+
+    SECTION("hand over the buffer of large data") {
+        serialization_context context;
+        const auto view = context.serialize(std::vector<int>{1, 2});
+        const unsigned char* buffer = view.data();
+        const std::string data(3000U, 'a');  // NOLINT(*-magic-numbers)
+
+        const binary serialized = context.serialize_to_binary(data);
+
+        CHECK(serialized == msgpack_light::serialize(data));
+        CHECK(serialized.data() == buffer);
+
+        CHECK(context.serialize(2) == binary("02"));
+        CHECK(serialized == msgpack_light::serialize(data));
+    }
+}
+
+TEST_CASE("msgpack_light::serialize_pooled") {
+    using msgpack_light::binary;
+
+    SECTION("serialize data") {
+        CHECK(msgpack_light::serialize_pooled(std::vector<int>{1, 2, 3}) ==
+            binary("93010203"));
+        CHECK(msgpack_light::serialize_pooled_to_binary(std::string("abc")) ==
+            binary("A3616263"));
+    }
+
+    SECTION("use different buffers in threads") {
+        const auto view = msgpack_light::serialize_pooled(1);
+        const unsigned char* buffer = view.data();
+
+        const unsigned char* buffer_in_thread = nullptr;
+        binary serialized_in_thread;
+        std::thread thread([&buffer_in_thread, &serialized_in_thread] {
+            const auto view = msgpack_light::serialize_pooled(2);
+            buffer_in_thread = view.data();
+            serialized_in_thread = binary(view);
+        });
+        thread.join();
+
+        CHECK(buffer_in_thread != buffer);
+        CHECK(serialized_in_thread == binary("02"));
+        CHECK(view == binary("01"));
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of serialize_batch function.
+ */
+#include "msgpack_light/serialize_batch.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/parallel_serialize.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
+
+TEST_CASE("msgpack_light::serialize_batch") {
+    using msgpack_light::binary;
+    using msgpack_light::parallel_serialization_options;
+
+    SECTION("serialize messages") {
+        const auto messages =
+            std::vector<std::vector<int>>{{1}, {}, {2, 3}};
+
+        const auto batch = msgpack_light::serialize_batch(messages);
+
+        REQUIRE(batch.size() == 3U);
+        CHECK(batch.data() == binary("910190920203"));
+        CHECK(batch.locations()[0].offset == 0U);
+        CHECK(batch.locations()[0].size == 2U);
+        CHECK(batch.locations()[1].offset == 2U);
+        CHECK(batch.locations()[1].size == 1U);
+        CHECK(batch.locations()[2].offset == 3U);
+        CHECK(batch.locations()[2].size == 3U);
+        CHECK(batch[2] == binary("920203"));
+    }
+
+    SECTION("serialize no message") {
+        const auto messages = std::vector<int>();
+
+        const auto batch = msgpack_light::serialize_batch(messages);
+
+        CHECK(batch.size() == 0U);
+        CHECK(batch.data() == binary());
+    }
+
+    SECTION("serialize many messages in parallel") {
+        const std::size_t num_messages = GENERATE(1U, 10U, 12345U);
+        const std::size_t num_threads = GENERATE(1U, 3U, 8U);
+        INFO("num_messages: " << num_messages);
+        INFO("num_threads: " << num_threads);
+        std::vector<std::string> messages;
+        messages.reserve(num_messages);
+        for (std::size_t i = 0; i < num_messages; ++i) {
+            messages.push_back(std::string(i % 50U, 'a'));  // NOLINT
+        }
+        parallel_serialization_options parallel_options;
+        parallel_options.num_threads = num_threads;
+        parallel_options.min_chunk_size = 2U;
+
+        const auto batch = msgpack_light::serialize_batch(
+            messages.data(), messages.size(), parallel_options);
+
+        REQUIRE(batch.size() == num_messages);
+        binary expected_data;
+        for (std::size_t i = 0; i < num_messages; ++i) {
+            INFO("message: " << i);
+            const auto expected = msgpack_light::serialize(messages[i]);
+            CHECK(batch.locations()[i].offset == expected_data.size());
+            CHECK(batch[i] == expected);
+            expected_data += expected;
+        }
+        CHECK(batch.data() == expected_data);
+    }
+
+    SECTION("serialize with options") {
+        const auto messages = std::vector<double>{1.0, 0.5};  // NOLINT
+        msgpack_light::serialization_options options;
+        options.compact_floating_point = true;
+
+        const auto batch = msgpack_light::serialize_batch(
+            messages, parallel_serialization_options(), options);
+
+        CHECK(batch.data() == binary("01CA3F000000"));
+    }
+}
@@ -19,10 +19,17 @@
  */
 #include "msgpack_light/serialize.h"
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 #include "msgpack_light/binary.h"
 #include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/serialization_options.h"
 
 TEST_CASE("msgpack_light::serialize_to") {
     using msgpack_light::binary;
@@ -36,6 +43,20 @@ TEST_CASE("msgpack_light::serialize_to") {
 
         CHECK(stream.as_binary() == binary("C2"));
     }
+
+    SECTION("serialize data with various sizes of buffers") {
+        const std::size_t buffer_size = GENERATE(static_cast<std::size_t>(0U),
+            static_cast<std::size_t>(16U), static_cast<std::size_t>(65536U));
+        INFO("buffer_size: " << buffer_size);
+        msgpack_light::serialization_options options;
+        options.buffer_size = buffer_size;
+        const auto data = std::vector<std::string>(100U, "abc");  // NOLINT
+        memory_output_stream stream;
+
+        serialize_to(stream, data, options);
+
+        CHECK(stream.as_binary() == msgpack_light::serialize(data));
+    }
 }
 
 TEST_CASE("msgpack_light::serialize") {
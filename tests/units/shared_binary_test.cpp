@@ -0,0 +1,161 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of shared_binary class.
+ */
+#include "msgpack_light/shared_binary.h"
+
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/monotonic_allocator.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+
+TEST_CASE("msgpack_light::shared_binary") {
+    using msgpack_light::binary;
+    using msgpack_light::binary_view;
+    using msgpack_light::shared_binary;
+
+    SECTION("create empty data") {
+        const shared_binary data;
+
+        CHECK(data.empty());
+        CHECK(data.size() == 0U);
+        CHECK(data.use_count() == 0U);
+        CHECK(data == binary());
+    }
+
+    SECTION("create data by copying") {
+        const auto original = binary("010203");
+
+        const auto data = shared_binary(binary_view(original));
+
+        CHECK(data == original);
+        CHECK(data.data() != original.data());
+        CHECK(data.use_count() == 1U);
+    }
+
+    SECTION("take ownership of data") {
+        auto original = binary(
+            std::vector<unsigned char>(100U, static_cast<unsigned char>(1)));
+        const unsigned char* buffer = original.data();
+
+        const auto data = shared_binary(std::move(original));
+
+        CHECK(data.data() == buffer);
+        CHECK(data.size() == 100U);
+    }
+
+    SECTION("take ownership of data in memory_output_stream") {
+        msgpack_light::memory_output_stream stream;
+        msgpack_light::serialize_to(stream, std::vector<int>{1, 2, 3});
+        const unsigned char* buffer = stream.data();
+
+        const auto data = shared_binary(stream.release());
+
+        CHECK(data == binary("93010203"));
+        CHECK(data.data() == buffer);
+    }
+
+    SECTION("take ownership of data with an allocator") {
+        auto original =
+            msgpack_light::basic_binary<msgpack_light::monotonic_allocator>(
+                binary("010203"));
+
+        const auto data = shared_binary(std::move(original));
+
+        CHECK(data == binary("010203"));
+    }
+
+    SECTION("share data") {
+        const auto data = shared_binary(binary("010203"));
+
+        shared_binary copy = data;  // NOLINT
+
+        CHECK(copy == binary("010203"));
+        CHECK(copy.data() == data.data());
+        CHECK(data.use_count() == 2U);
+
+        copy = shared_binary();
+        CHECK(data.use_count() == 1U);
+    }
+
+    SECTION("move data") {
+        auto data = shared_binary(binary("010203"));
+
+        const shared_binary moved = std::move(data);
+
+        CHECK(moved == binary("010203"));
+        CHECK(moved.use_count() == 1U);
+        CHECK(data.empty());  // NOLINT(bugprone-use-after-move)
+    }
+
+    SECTION("slice data") {
+        shared_binary slice;
+        {
+            const auto data = shared_binary(binary("0102030405"));
+
+            slice = data.slice(1U, 3U);
+
+            CHECK(slice.data() == data.data() + 1);  // NOLINT
+            CHECK(data.use_count() == 2U);
+        }
+        CHECK(slice == binary("020304"));
+        CHECK(slice.use_count() == 1U);
+
+        const auto sub_slice = slice.slice(2U, 1U);
+        CHECK(sub_slice == binary("04"));
+        CHECK(slice.slice(3U, 0U).empty());
+    }
+
+    SECTION("slice data with invalid ranges") {
+        const auto data = shared_binary(binary("010203"));
+
+        CHECK_THROWS_AS(data.slice(4U, 0U), std::out_of_range);
+        CHECK_THROWS_AS(data.slice(1U, 3U), std::out_of_range);
+    }
+
+    SECTION("share data among threads") {
+        const auto data = shared_binary(binary(
+            std::vector<unsigned char>(1000U, static_cast<unsigned char>(7))));
+        constexpr int num_threads = 4;
+        constexpr int num_copies = 10000;
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            threads.emplace_back([&data] {
+                for (int j = 0; j < num_copies; ++j) {
+                    const shared_binary copy = data.slice(1U, 10U);
+                    (void)copy;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        CHECK(data.use_count() == 1U);
+    }
+}
@@ -1,20 +1,47 @@
 set(SOURCE_FILES
+    aligned_allocator_test.cpp
+    allocator_reference_test.cpp
+    async_file_output_stream_test.cpp
     binary_test.cpp
+    checksumming_output_stream_test.cpp
+    chunked_memory_output_stream_test.cpp
+    compressing_output_stream_test.cpp
+    decompressing_reader_test.cpp
     details/basic_binary_buffer_test.cpp
-    details/buffered_serialization_buffer_impl_test.cpp
+    details/configurable_serialization_buffer_impl_test.cpp
     details/count_arguments_macro_test.cpp
-    details/non_buffered_serialization_buffer_impl_test.cpp
+    details/crc32c_test.cpp
+    details/fixed_memory_output_stream_test.cpp
+    details/lz_codec_test.cpp
+    details/map_index_test.cpp
+    details/msgpack_object_size_test.cpp
     details/object_data_test.cpp
+    details/parallel_for_test.cpp
+    details/size_counting_output_stream_test.cpp
+    details/thread_pool_test.cpp
     details/to_big_endian_test.cpp
     details/total_size_of_test.cpp
+    direct_file_output_stream_test.cpp
+    fd_output_stream_test.cpp
+    io_uring_file_output_stream_test.cpp
     memory_output_stream_test.cpp
+    mmap_output_stream_test.cpp
     monotonic_allocator_test.cpp
     object_test.cpp
+    parallel_serialize_test.cpp
+    record_log_reader_test.cpp
+    record_log_writer_test.cpp
     serialization_buffer_test.cpp
+    serialization_context_test.cpp
+    serialize_batch_test.cpp
     serialize_test.cpp
+    shared_binary_test.cpp
     type_support/array_test.cpp
     type_support/bool_test.cpp
+    type_support/cached_serialization_test.cpp
+    type_support/delta_encoding_test.cpp
     type_support/deque_test.cpp
+    type_support/details/canonical_order_test.cpp
     type_support/float_test.cpp
     type_support/forward_list_test.cpp
     type_support/integer_test.cpp
@@ -23,6 +50,7 @@ set(SOURCE_FILES
     type_support/nullptr_test.cpp
     type_support/optional_test.cpp
     type_support/pair_test.cpp
+    type_support/raw_msgpack_test.cpp
     type_support/set_test.cpp
     type_support/string_test.cpp
     type_support/struct_test.cpp
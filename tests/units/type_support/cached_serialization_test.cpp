@@ -0,0 +1,146 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of classes to support serialization of
+ * msgpack_light::cached_serialization instances.
+ */
+#include "msgpack_light/type_support/cached_serialization.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/cached_serialization.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+#include "msgpack_light/type_support/map.h"  // IWYU pragma: keep
+#include "msgpack_light/type_support/unordered_map.h"  // IWYU pragma: keep
+
+TEST_CASE("msgpack_light::cached_serialization") {
+    using msgpack_light::binary;
+    using msgpack_light::cached_serialization;
+
+    SECTION("create") {
+        const auto value = cached_serialization<std::string>("abc", 3U);
+
+        CHECK(value.value() == "abc");
+        CHECK(value.version() == 3U);
+        CHECK(value.serialized() == binary("A3616263"));
+        CHECK(value.as_raw_msgpack().is_valid());
+    }
+
+    SECTION("update the value") {
+        auto value = cached_serialization<int>(1);
+
+        value.update(2, 1U);
+
+        CHECK(value.value() == 2);
+        CHECK(value.version() == 1U);
+        CHECK(value.serialized() == binary("02"));
+    }
+
+    SECTION("update the value with the same version") {
+        auto value = cached_serialization<int>(1);
+
+        value.update(2, 0U);
+
+        CHECK(value.value() == 1);
+        CHECK(value.version() == 0U);
+        CHECK(value.serialized() == binary("01"));
+    }
+
+    SECTION("modify the value") {
+        auto value = cached_serialization<std::vector<int>>({1, 2});
+
+        value.modify([](std::vector<int>& vec) { vec.push_back(3); });
+
+        CHECK(value.value() == std::vector<int>{1, 2, 3});
+        CHECK(value.version() == 1U);
+        CHECK(value.serialized() == binary("93010203"));
+    }
+
+    SECTION("create with options") {
+        msgpack_light::serialization_options options;
+        options.compact_floating_point = true;
+
+        const auto value = cached_serialization<double>(1.0, 0U, options);
+
+        CHECK(value.options().compact_floating_point);
+        CHECK(value.serialized() == binary("01"));
+        CHECK(value.is_serialized_with(options));
+        CHECK_FALSE(
+            value.is_serialized_with(msgpack_light::serialization_options()));
+    }
+
+    SECTION("keep only the serialized data") {
+        const auto value = cached_serialization<int>(1);
+
+        CHECK(value.serialized().size() == 1U);
+        CHECK(value.serialized().capacity() < 1024U);
+    }
+}
+
+TEST_CASE(
+    "msgpack_light::type_support::serialization_traits<msgpack_light::cached_"
+    "serialization<T>>") {
+    using msgpack_light::binary;
+    using msgpack_light::cached_serialization;
+
+    SECTION("serialize") {
+        const auto value = cached_serialization<std::string>("abc");
+
+        const auto serialized = msgpack_light::serialize(value);
+
+        CHECK(serialized == binary("A3616263"));
+    }
+
+    SECTION("serialize nested values") {
+        using inner_type = cached_serialization<std::string>;
+        auto value = cached_serialization<std::vector<inner_type>>(
+            {inner_type("a"), inner_type("b")});
+        CHECK(msgpack_light::serialize(value) == binary("92A161A162"));
+
+        value.modify(
+            [](std::vector<inner_type>& vec) { vec[1].update("cd", 1U); });
+
+        CHECK(msgpack_light::serialize(value) == binary("92A161A26364"));
+        CHECK(value.value()[0].version() == 0U);
+        CHECK(value.value()[1].version() == 1U);
+    }
+
+    SECTION("serialize with different options") {
+        msgpack_light::serialization_options options;
+        options.canonical = true;
+        options.compact_floating_point = true;
+        using inner_type =
+            cached_serialization<std::unordered_map<int, double>>;
+        const auto value = cached_serialization<std::vector<inner_type>>(
+            {inner_type({{3, 1.0}, {1, 2.5}, {2, -0.5}})});
+        const auto canonical = msgpack_light::serialize(
+            std::vector<std::map<int, double>>{
+                {{3, 1.0}, {1, 2.5}, {2, -0.5}}},
+            options);
+
+        CHECK(msgpack_light::serialize(value, options) == canonical);
+        CHECK(canonical == binary("918301CA4020000002CABF0000000301"));
+    }
+}
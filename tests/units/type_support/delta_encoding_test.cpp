@@ -0,0 +1,212 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of classes to support serialization of
+ * msgpack_light::delta_encoded_view instances.
+ */
+#include "msgpack_light/type_support/delta_encoding.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/delta_encoding.h"
+#include "msgpack_light/raw_msgpack.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+
+namespace {
+
+/*!
+ * \brief Get the data of a serialized extension.
+ *
+ * \param[in] serialized Serialized data.
+ * \return Data of the extension.
+ */
+msgpack_light::binary ext_data_of(const msgpack_light::binary& serialized) {
+    REQUIRE(serialized.size() >= 2U);
+    std::size_t header_size = 0U;
+    switch (serialized.data()[0]) {
+    case 0xD4:  // NOLINT: fixext 1
+    case 0xD5:  // NOLINT: fixext 2
+    case 0xD6:  // NOLINT: fixext 4
+    case 0xD7:  // NOLINT: fixext 8
+    case 0xD8:  // NOLINT: fixext 16
+        header_size = 2U;
+        break;
+    case 0xC7:  // NOLINT: ext 8
+        header_size = 3U;
+        break;
+    case 0xC8:  // NOLINT: ext 16
+        header_size = 4U;
+        break;
+    default:
+        FAIL("Unexpected format.");
+    }
+    REQUIRE(serialized.size() >= header_size);
+    return msgpack_light::binary(
+        serialized.data() + header_size, serialized.size() - header_size);
+}
+
+}  // namespace
+
+TEST_CASE(
+    "msgpack_light::type_support::serialization_traits<msgpack_light::delta_"
+    "encoded_view<T>>") {
+    using msgpack_light::binary;
+    using msgpack_light::decode_delta_encoded_int64;
+    using msgpack_light::decode_delta_encoded_time_points;
+    using msgpack_light::delta_encoded_view;
+
+    SECTION("serialize an empty sequence") {
+        const std::vector<std::int64_t> values;
+
+        const auto serialized =
+            msgpack_light::serialize(delta_encoded_view(values));
+
+        CHECK(serialized ==
+            binary("C70D01"
+                   "00000000"
+                   "00"
+                   "0000000000000000"));
+        CHECK(decode_delta_encoded_int64(
+                  serialized.data() + 3U, serialized.size() - 3U)
+                  .empty());
+    }
+
+    SECTION("serialize a sequence") {
+        const std::vector<std::int64_t> values{100, 101, 99, 99, 102};
+        constexpr auto ext_type = static_cast<std::int8_t>(5);
+
+        const auto serialized =
+            msgpack_light::serialize(delta_encoded_view(values, ext_type));
+
+        // Differences: 1, -2, 0, 3 -> zigzag: 2, 3, 0, 6 (3 bits each)
+        // Bits from LSB: 010 110 000 011 -> 0x1A, 0x06
+        CHECK(serialized ==
+            binary("C70F05"
+                   "00000005"
+                   "03"
+                   "0000000000000064"
+                   "1A0C"));
+        CHECK(decode_delta_encoded_int64(
+                  serialized.data() + 3U, serialized.size() - 3U) == values);
+    }
+
+    SECTION("serialize random sequences") {
+        const std::size_t count = GENERATE(static_cast<std::size_t>(1),
+            static_cast<std::size_t>(2), static_cast<std::size_t>(100),
+            static_cast<std::size_t>(1000));
+        const std::int64_t max_delta = GENERATE(static_cast<std::int64_t>(0),
+            static_cast<std::int64_t>(1), static_cast<std::int64_t>(1000),
+            static_cast<std::int64_t>(1) << 40,  // NOLINT
+            std::numeric_limits<std::int64_t>::max());
+        INFO("count: " << count);
+        INFO("max_delta: " << max_delta);
+
+        std::mt19937_64 engine;  // NOLINT
+        std::uniform_int_distribution<std::int64_t> dist(-max_delta, max_delta);
+        std::vector<std::int64_t> values;
+        std::uint64_t current = 1234567890U;  // NOLINT
+        for (std::size_t i = 0; i < count; ++i) {
+            current += static_cast<std::uint64_t>(dist(engine));
+            values.push_back(static_cast<std::int64_t>(current));
+        }
+
+        const auto serialized =
+            msgpack_light::serialize(delta_encoded_view(values));
+
+        CHECK(msgpack_light::raw_msgpack(serialized.data(), serialized.size())
+                  .is_valid());
+        const auto data = ext_data_of(serialized);
+        CHECK(decode_delta_encoded_int64(data.data(), data.size()) == values);
+    }
+
+    SECTION("serialize time points") {
+        using std::chrono::system_clock;
+        const auto base = system_clock::time_point(
+            std::chrono::duration_cast<system_clock::duration>(
+                std::chrono::seconds(1700000000)));  // NOLINT
+        const std::vector<system_clock::time_point> values{base,
+            base + std::chrono::microseconds(1),
+            base + std::chrono::microseconds(3)};
+
+        const auto serialized =
+            msgpack_light::serialize(delta_encoded_view(values));
+
+        // Differences: 1000, 2000 nanoseconds -> zigzag: 2000, 4000 (12 bits)
+        CHECK(serialized ==
+            binary("D801"
+                   "00000003"
+                   "0C"
+                   "17979CFE362A0000"
+                   "D007FA"));
+        const auto data = ext_data_of(serialized);
+        CHECK(decode_delta_encoded_time_points(data.data(), data.size()) ==
+            values);
+    }
+
+    SECTION("decode invalid data") {
+        CHECK_THROWS_AS(decode_delta_encoded_int64(nullptr, 0U),
+            std::runtime_error);
+        const auto wrong_size = binary(
+            "00000002"
+            "08"
+            "0000000000000000");
+        CHECK_THROWS_AS(
+            decode_delta_encoded_int64(wrong_size.data(), wrong_size.size()),
+            std::runtime_error);
+        const auto wrong_width = binary(
+            "00000001"
+            "41"
+            "0000000000000000");
+        CHECK_THROWS_AS(
+            decode_delta_encoded_int64(wrong_width.data(), wrong_width.size()),
+            std::runtime_error);
+        const auto too_many = binary(
+            "FFFFFFFF"
+            "00"
+            "0000000000000000");
+        CHECK_THROWS_AS(
+            decode_delta_encoded_int64(too_many.data(), too_many.size()),
+            std::runtime_error);
+    }
+
+    SECTION("limit the number of decoded values") {
+        const auto constant = binary(
+            "00000005"
+            "00"
+            "0000000000000003");
+        CHECK(decode_delta_encoded_int64(constant.data(), constant.size()) ==
+            std::vector<std::int64_t>(5U, 3));
+        CHECK(decode_delta_encoded_int64(
+                  constant.data(), constant.size(), 5U) ==
+            std::vector<std::int64_t>(5U, 3));
+        CHECK_THROWS_AS(
+            decode_delta_encoded_int64(constant.data(), constant.size(), 4U),
+            std::runtime_error);
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of functions to serialize elements in the canonical order.
+ */
+#include "msgpack_light/type_support/details/canonical_order.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "msgpack_light/binary.h"
+
+TEST_CASE("msgpack_light::type_support::details::sort_serialized_ranges") {
+    using msgpack_light::binary;
+    using msgpack_light::type_support::details::is_serialized_data_less;
+    using msgpack_light::type_support::details::serialized_range;
+    using msgpack_light::type_support::details::sort_serialized_ranges;
+
+    SECTION("sort a few data") {
+        const auto data = binary("0301020302");
+        std::vector<serialized_range> ranges{
+            {0U, 1U}, {1U, 2U}, {3U, 1U}, {3U, 2U}, {2U, 1U}};
+
+        sort_serialized_ranges(data.data(), ranges);
+
+        // 01 02, 02, 03, 03 (first), 03 02
+        CHECK(ranges[0].offset == 1U);
+        CHECK(ranges[1].offset == 2U);
+        CHECK(ranges[2].size == 1U);
+        CHECK(ranges[3].size == 1U);
+        CHECK(ranges[4].offset == 3U);
+        CHECK(ranges[4].size == 2U);
+    }
+
+    SECTION("sort many random data") {
+        const std::size_t num_ranges = GENERATE(static_cast<std::size_t>(10),
+            static_cast<std::size_t>(100), static_cast<std::size_t>(3000));
+        const std::size_t max_size = GENERATE(
+            static_cast<std::size_t>(2), static_cast<std::size_t>(20));
+        INFO("num_ranges: " << num_ranges);
+        INFO("max_size: " << max_size);
+
+        std::mt19937 engine;  // NOLINT
+        std::uniform_int_distribution<std::size_t> size_dist(0U, max_size);
+        // Use a few values to create many common prefixes.
+        std::uniform_int_distribution<unsigned int> byte_dist(0U, 3U);
+        binary data;
+        std::vector<serialized_range> ranges;
+        for (std::size_t i = 0; i < num_ranges; ++i) {
+            const std::size_t size = size_dist(engine);
+            const std::size_t offset = data.size();
+            for (std::size_t j = 0; j < size; ++j) {
+                const auto byte = static_cast<unsigned char>(byte_dist(engine));
+                data.append(&byte, 1U);
+            }
+            ranges.push_back(serialized_range{offset, size});
+        }
+        auto expected = ranges;
+        std::stable_sort(expected.begin(), expected.end(),
+            [&data](const serialized_range& lhs, const serialized_range& rhs) {
+                return is_serialized_data_less(data.data(), lhs, rhs, 0U);
+            });
+
+        sort_serialized_ranges(data.data(), ranges);
+
+        REQUIRE(ranges.size() == expected.size());
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            INFO("i: " << i);
+            CHECK(binary(data.data() + ranges[i].offset, ranges[i].size) ==
+                binary(data.data() + expected[i].offset, expected[i].size));
+        }
+    }
+
+    SECTION("sort data with long common prefixes") {
+        constexpr std::size_t num_ranges = 100;
+        binary data;
+        std::vector<serialized_range> ranges;
+        for (std::size_t i = 0; i < num_ranges; ++i) {
+            // Data of a, aa, aaa, ..., in reversed order.
+            const std::size_t size = num_ranges - i;
+            const std::size_t offset = data.size();
+            for (std::size_t j = 0; j < size; ++j) {
+                const auto byte = static_cast<unsigned char>(0x61);
+                data.append(&byte, 1U);
+            }
+            ranges.push_back(serialized_range{offset, size});
+        }
+
+        sort_serialized_ranges(data.data(), ranges);
+
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            INFO("i: " << i);
+            CHECK(ranges[i].size == i + 1U);
+        }
+    }
+}
+
+TEST_CASE(
+    "msgpack_light::type_support::details::canonical_order_workspace_pool") {
+    using msgpack_light::type_support::details::canonical_order_workspace;
+    using msgpack_light::type_support::details::
+        canonical_order_workspace_pool;
+
+    SECTION("use workspaces for nested levels") {
+        canonical_order_workspace_pool pool;
+
+        canonical_order_workspace* first_workspace = nullptr;
+        {
+            const canonical_order_workspace_pool::lease outer(pool);
+            const canonical_order_workspace_pool::lease inner(pool);
+            CHECK(&outer.workspace() != &inner.workspace());
+            first_workspace = &outer.workspace();
+            const auto byte = static_cast<unsigned char>(0x01);
+            outer.workspace().elements_stream.write(&byte, 1U);
+            outer.workspace().ranges.push_back({0U, 1U});
+        }
+
+        const canonical_order_workspace_pool::lease lease(pool);
+        CHECK(&lease.workspace() == first_workspace);
+        CHECK(lease.workspace().elements_stream.size() == 0U);
+        CHECK(lease.workspace().ranges.empty());
+    }
+}
@@ -20,11 +20,17 @@
  */
 #include "msgpack_light/type_support/float.h"
 
+#include <limits>
+#include <tuple>
+
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 #include "msgpack_light/binary.h"
 #include "msgpack_light/memory_output_stream.h"
 #include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
 
 TEST_CASE("msgpack_light::type_support::serialization_traits<float>") {
     using msgpack_light::binary;
@@ -43,6 +49,30 @@ TEST_CASE("msgpack_light::type_support::serialization_traits<float>") {
         buffer.flush();
         CHECK(stream.as_binary() == expected_binary);
     }
+
+    SECTION("serialize in compact formats") {
+        float value{};
+        binary expected_binary;
+        std::tie(value, expected_binary) = GENERATE(table<float, binary>({
+            {0.0F, binary("00")},
+            {-0.0F, binary("CA80000000")},
+            {1.0F, binary("01")},
+            {-1.0F, binary("FF")},
+            {300.0F, binary("CD012C")},                 // NOLINT
+            {0x1p63F, binary("CF8000000000000000")},    // NOLINT
+            {-0x1p63F, binary("D38000000000000000")},   // NOLINT
+            {0x1p64F, binary("CA5F800000")},            // NOLINT
+            {0.5F, binary("CA3F000000")},               // NOLINT
+            {std::numeric_limits<float>::infinity(), binary("CA7F800000")},
+        }));
+        INFO("value: " << value);
+        msgpack_light::serialization_options options;
+        options.compact_floating_point = true;
+
+        const auto serialized = msgpack_light::serialize(value, options);
+
+        CHECK(serialized == expected_binary);
+    }
 }
 
 TEST_CASE("msgpack_light::type_support::serialization_traits<double>") {
@@ -62,4 +92,41 @@ TEST_CASE("msgpack_light::type_support::serialization_traits<double>") {
         buffer.flush();
         CHECK(stream.as_binary() == expected_binary);
     }
+
+    SECTION("serialize in compact formats") {
+        double value{};
+        binary expected_binary;
+        std::tie(value, expected_binary) = GENERATE(table<double, binary>({
+            {0.0, binary("00")},
+            {-0.0, binary("CA80000000")},
+            {42.0, binary("2A")},                        // NOLINT
+            {-33.0, binary("D0DF")},                     // NOLINT
+            {65536.0, binary("CE00010000")},             // NOLINT
+            {-0x1p63, binary("D38000000000000000")},     // NOLINT
+            {0x1p64, binary("CA5F800000")},              // NOLINT
+            {0x1p200, binary("CB4C70000000000000")},     // NOLINT
+            {0.5, binary("CA3F000000")},                 // NOLINT
+            {0.1, binary("CB3FB999999999999A")},         // NOLINT
+            {std::numeric_limits<double>::infinity(), binary("CA7F800000")},
+            {-std::numeric_limits<double>::infinity(), binary("CAFF800000")},
+        }));
+        INFO("value: " << value);
+        msgpack_light::serialization_options options;
+        options.compact_floating_point = true;
+
+        const auto serialized = msgpack_light::serialize(value, options);
+
+        CHECK(serialized == expected_binary);
+    }
+
+    SECTION("keep NaN in float 64 format") {
+        const double value = std::numeric_limits<double>::quiet_NaN();
+        msgpack_light::serialization_options options;
+        options.compact_floating_point = true;
+
+        const auto serialized = msgpack_light::serialize(value, options);
+
+        REQUIRE(serialized.size() == 9U);
+        CHECK(serialized.data()[0] == 0xCB);  // NOLINT
+    }
 }
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2024 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of classes to support serialization of data already serialized
+ * in MessagePack.
+ */
+#include "msgpack_light/type_support/raw_msgpack.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "msgpack_light/binary.h"
+#include "msgpack_light/memory_output_stream.h"
+#include "msgpack_light/raw_msgpack.h"
+#include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/serialize.h"
+#include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
+#include "msgpack_light/type_support/map.h"     // IWYU pragma: keep
+
+TEST_CASE("msgpack_light::raw_msgpack") {
+    using msgpack_light::binary;
+    using msgpack_light::raw_msgpack;
+
+    SECTION("check valid data") {
+        const auto data = binary("9201A161");
+        const auto value = raw_msgpack(data);
+
+        CHECK(value.data() == data.data());
+        CHECK(value.size() == data.size());
+        CHECK(value.is_valid());
+        CHECK_NOTHROW(value.validate());
+    }
+
+    SECTION("check data with trailing bytes") {
+        const auto data = binary("920102C0");
+        const auto value = raw_msgpack(data);
+
+        CHECK_FALSE(value.is_valid());
+        CHECK_THROWS(value.validate());
+    }
+
+    SECTION("check incomplete data") {
+        const auto data = binary("930102");
+        const auto value = raw_msgpack(data);
+
+        CHECK_FALSE(value.is_valid());
+        CHECK_THROWS(value.validate());
+    }
+
+    SECTION("check empty data") {
+        const auto value = raw_msgpack();
+
+        CHECK_FALSE(value.is_valid());
+        CHECK_THROWS(value.validate());
+    }
+}
+
+TEST_CASE(
+    "msgpack_light::type_support::serialization_traits<msgpack_light::raw_"
+    "msgpack>") {
+    using msgpack_light::binary;
+    using msgpack_light::memory_output_stream;
+    using msgpack_light::raw_msgpack;
+    using msgpack_light::serialization_buffer;
+
+    SECTION("serialize") {
+        const auto data = binary("92A3616263C3");
+
+        memory_output_stream stream;
+        serialization_buffer buffer(stream);
+
+        buffer.serialize(raw_msgpack(data));
+
+        buffer.flush();
+        CHECK(stream.as_binary() == data);
+    }
+
+    SECTION("serialize data embedded in other data") {
+        const auto cached = msgpack_light::serialize(std::string("abc"));
+
+        const auto serialized = msgpack_light::serialize(
+            std::map<int, raw_msgpack>{{1, raw_msgpack(cached)}});
+
+        CHECK(serialized == binary("8101A3616263"));
+    }
+
+    SECTION("serialize an array of data") {
+        const auto data1 = binary("01");
+        const auto data2 = binary("A161");
+        const auto data3 = binary("9102");
+
+        const auto serialized =
+            msgpack_light::serialize(std::vector<raw_msgpack>{
+                raw_msgpack(data1), raw_msgpack(data2), raw_msgpack(data3)});
+
+        CHECK(serialized == binary("9301A1619102"));
+    }
+}
+
+TEST_CASE(
+    "msgpack_light::type_support::serialization_traits<msgpack_light::raw_"
+    "msgpack_map>") {
+    using msgpack_light::binary;
+    using msgpack_light::raw_msgpack;
+    using msgpack_light::raw_msgpack_map;
+
+    SECTION("serialize an empty map") {
+        const auto serialized = msgpack_light::serialize(raw_msgpack_map());
+
+        CHECK(serialized == binary("80"));
+    }
+
+    SECTION("serialize a map") {
+        const auto key1 = binary("A161");
+        const auto value1 = binary("01");
+        const auto key2 = binary("A162");
+        const auto value2 = binary("9102");
+        const auto pairs = std::vector<std::pair<raw_msgpack, raw_msgpack>>{
+            {raw_msgpack(key1), raw_msgpack(value1)},
+            {raw_msgpack(key2), raw_msgpack(value2)}};
+
+        const auto serialized =
+            msgpack_light::serialize(raw_msgpack_map(pairs));
+
+        CHECK(serialized == binary("82A16101A1629102"));
+    }
+}
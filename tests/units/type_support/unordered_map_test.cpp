@@ -29,6 +29,8 @@
 #include "msgpack_light/binary.h"
 #include "msgpack_light/memory_output_stream.h"
 #include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
 #include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
 
 TEST_CASE(
@@ -56,6 +58,55 @@ TEST_CASE(
         buffer.flush();
         CHECK(stream.as_binary() == expected_binary);
     }
+
+    SECTION("serialize in the canonical form") {
+        const auto value = std::unordered_map<int, std::string>{
+            {1, "a"}, {-1, "b"}, {200, "c"}};  // NOLINT
+        msgpack_light::serialization_options options;
+        options.canonical = true;
+
+        const auto serialized = msgpack_light::serialize(value, options);
+
+        CHECK(serialized ==
+            binary("83"
+                   "01A161"
+                   "CCC8A163"
+                   "FFA162"));
+    }
+
+    SECTION("serialize equal values in the canonical form") {
+        constexpr int size = 1000;
+        std::unordered_map<int, std::string> value1;
+        std::unordered_map<int, std::string> value2;
+        value2.reserve(static_cast<std::size_t>(size) * 10U);  // NOLINT
+        for (int i = 0; i < size; ++i) {
+            value1.try_emplace(i, std::to_string(i));
+            value2.try_emplace(size - 1 - i, std::to_string(size - 1 - i));
+        }
+        msgpack_light::serialization_options options;
+        options.canonical = true;
+
+        CHECK(msgpack_light::serialize(value1, options) ==
+            msgpack_light::serialize(value2, options));
+    }
+
+    SECTION("serialize nested maps in the canonical form") {
+        const auto value =
+            std::unordered_map<int, std::unordered_map<int, int>>{
+                {2, {{4, 1}, {3, 2}}}, {1, {{6, 3}, {5, 4}}}};
+        msgpack_light::serialization_options options;
+        options.canonical = true;
+
+        const auto serialized = msgpack_light::serialize(value, options);
+
+        CHECK(serialized ==
+            binary("82"
+                   "01820504"
+                   "0603"
+                   "02820302"
+                   "0401"));
+        CHECK(msgpack_light::serialize(value, options) == serialized);
+    }
 }
 
 TEST_CASE(
@@ -83,4 +134,19 @@ TEST_CASE(
         buffer.flush();
         CHECK(stream.as_binary() == expected_binary);
     }
+
+    SECTION("serialize in the canonical form") {
+        const auto value = std::unordered_multimap<int, std::string>{
+            {2, "b"}, {1, "b"}, {2, "a"}};
+        msgpack_light::serialization_options options;
+        options.canonical = true;
+
+        const auto serialized = msgpack_light::serialize(value, options);
+
+        CHECK(serialized ==
+            binary("83"
+                   "01A162"
+                   "02A161"
+                   "02A162"));
+    }
 }
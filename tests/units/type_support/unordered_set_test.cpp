@@ -28,6 +28,8 @@
 #include "msgpack_light/binary.h"
 #include "msgpack_light/memory_output_stream.h"
 #include "msgpack_light/serialization_buffer.h"
+#include "msgpack_light/serialization_options.h"
+#include "msgpack_light/serialize.h"
 #include "msgpack_light/type_support/common.h"  // IWYU pragma: keep
 
 TEST_CASE(
@@ -53,6 +55,16 @@ TEST_CASE(
         buffer.flush();
         CHECK(stream.as_binary() == expected_binary);
     }
+
+    SECTION("serialize in the canonical form") {
+        const auto value = std::unordered_set<int>{3, -1, 1, 200};  // NOLINT
+        msgpack_light::serialization_options options;
+        options.canonical = true;
+
+        const auto serialized = msgpack_light::serialize(value, options);
+
+        CHECK(serialized == binary("9401" "03" "CCC8" "FF"));
+    }
 }
 
 TEST_CASE(
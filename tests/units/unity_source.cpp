@@ -1,27 +1,63 @@
+#include "aligned_allocator_test.cpp"    // NOLINT(bugprone-suspicious-include)
+#include "allocator_reference_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "async_file_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "binary_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "checksumming_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "chunked_memory_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "compressing_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "decompressing_reader_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "details/basic_binary_buffer_test.cpp"  // NOLINT(bugprone-suspicious-include)
-#include "details/buffered_serialization_buffer_impl_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "details/configurable_serialization_buffer_impl_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "details/count_arguments_macro_test.cpp"  // NOLINT(bugprone-suspicious-include)
-#include "details/non_buffered_serialization_buffer_impl_test.cpp"  // NOLINT(bugprone-suspicious-include)
-#include "details/object_data_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "details/crc32c_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "details/fixed_memory_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "details/lz_codec_test.cpp"   // NOLINT(bugprone-suspicious-include)
+#include "details/map_index_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "details/msgpack_object_size_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "details/object_data_test.cpp"   // NOLINT(bugprone-suspicious-include)
+#include "details/parallel_for_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "details/size_counting_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "details/thread_pool_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "details/to_big_endian_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "details/total_size_of_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#if defined(__linux__)
+#include "direct_file_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include "fd_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#endif
+#if defined(__linux__)
+#include "io_uring_file_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#endif
 #include "memory_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#if defined(__linux__)
+#include "mmap_output_stream_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#endif
 #include "monotonic_allocator_test.cpp"   // NOLINT(bugprone-suspicious-include)
 #include "object_test.cpp"                // NOLINT(bugprone-suspicious-include)
+#include "parallel_serialize_test.cpp"    // NOLINT(bugprone-suspicious-include)
+#include "record_log_reader_test.cpp"     // NOLINT(bugprone-suspicious-include)
+#include "record_log_writer_test.cpp"     // NOLINT(bugprone-suspicious-include)
 #include "serialization_buffer_test.cpp"  // NOLINT(bugprone-suspicious-include)
-#include "serialize_test.cpp"             // NOLINT(bugprone-suspicious-include)
-#include "type_support/array_test.cpp"    // NOLINT(bugprone-suspicious-include)
-#include "type_support/bool_test.cpp"     // NOLINT(bugprone-suspicious-include)
-#include "type_support/deque_test.cpp"    // NOLINT(bugprone-suspicious-include)
-#include "type_support/float_test.cpp"    // NOLINT(bugprone-suspicious-include)
+#include "serialization_context_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "serialize_batch_test.cpp"     // NOLINT(bugprone-suspicious-include)
+#include "serialize_test.cpp"           // NOLINT(bugprone-suspicious-include)
+#include "shared_binary_test.cpp"       // NOLINT(bugprone-suspicious-include)
+#include "type_support/array_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "type_support/bool_test.cpp"   // NOLINT(bugprone-suspicious-include)
+#include "type_support/cached_serialization_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "type_support/delta_encoding_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "type_support/deque_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "type_support/details/canonical_order_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "type_support/float_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "type_support/forward_list_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "type_support/integer_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "type_support/list_test.cpp"     // NOLINT(bugprone-suspicious-include)
 #include "type_support/map_test.cpp"      // NOLINT(bugprone-suspicious-include)
 #include "type_support/nullptr_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "type_support/optional_test.cpp"  // NOLINT(bugprone-suspicious-include)
-#include "type_support/pair_test.cpp"    // NOLINT(bugprone-suspicious-include)
+#include "type_support/pair_test.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "type_support/raw_msgpack_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "type_support/set_test.cpp"     // NOLINT(bugprone-suspicious-include)
 #include "type_support/string_test.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "type_support/struct_test.cpp"  // NOLINT(bugprone-suspicious-include)